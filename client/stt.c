@@ -12,23 +12,22 @@
 */
 
 
-#include <sys/wait.h>
 #include <sys/types.h> 
 #include <unistd.h>
-#include <Ecore.h>
 
 #include "stt.h"
 #include "stt_main.h"
 #include "stt_client.h"
 #include "stt_dbus.h"
+#include "stt_loop.h"
 
 #define CONNECTION_RETRY_COUNT 3
 
-static bool g_is_daemon_started = false;
+void __stt_post_state_changed(stt_client_s* client);
+void __stt_post_error(stt_client_s* client, int reason);
 
-static int __check_stt_daemon();
-static Eina_Bool __stt_notify_state_changed(void *data);
-static Eina_Bool __stt_notify_error(void *data);
+int __stt_cb_queue_position(int uid, int position);
+void __stt_drop_request(stt_client_s* client);
 
 int stt_create(stt_h* stt)
 {
@@ -46,12 +45,13 @@ int stt_create(stt_h* stt)
 		}
 	}
 
-	if (0 != stt_client_new(stt)) {
+	int ret = stt_client_new(stt);
+	if (0 != ret) {
 		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to create client!");
-		return STT_ERROR_OUT_OF_MEMORY;
+		return ret;
 	}
 
-	SLOG(LOG_DEBUG, TAG_STTC, "[Success] uid(%d)", (*stt)->handle);
+	SLOG(LOG_DEBUG, TAG_STTC, "[Success] handle(%d)", (*stt)->handle);
 
 	SLOG(LOG_DEBUG, TAG_STTC, "=====");
 	SLOG(LOG_DEBUG, TAG_STTC, " ");
@@ -80,6 +80,9 @@ int stt_destroy(stt_h stt)
 
 	int ret = -1;
 
+	/* reply for freed handle is dropped */
+	__stt_drop_request(client);
+
 	/* check state */
 	switch (client->current_state) {
 	case STT_STATE_PROCESSING:
@@ -109,11 +112,11 @@ int stt_destroy(stt_h stt)
 	return STT_ERROR_NONE;
 }
 
-static Eina_Bool __stt_connect_daemon(void *data)
+void __stt_hello_reply(DBusMessage* reply, int result, void* user_data)
 {
 	SLOG(LOG_DEBUG, TAG_STTC, "===== Connect daemon");
 
-	stt_h stt = (stt_h)data;
+	stt_h stt = (stt_h)user_data;
 
 	stt_client_s* client = stt_client_get(stt);
 
@@ -121,54 +124,70 @@ static Eina_Bool __stt_connect_daemon(void *data)
 		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] A handle is not available");
 		SLOG(LOG_DEBUG, TAG_STTC, "=====");
 		SLOG(LOG_DEBUG, TAG_STTC, " ");
-		return STT_ERROR_INVALID_PARAMETER;
+		return;
 	}
 
-	/* Send hello */
-	if (0 != stt_dbus_request_hello()) {
-		if (false == g_is_daemon_started) {
-			g_is_daemon_started = true;
-			__check_stt_daemon();
-		}
-		return EINA_TRUE;
+	client->request = NULL;
+
+	/* bus could not start daemon or daemon did not own its name in time */
+	if (0 != result) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to find daemon : result(%d)", result);
+
+		__stt_post_error(client, (STT_ERROR_TIMED_OUT == result) ? STT_ERROR_TIMED_OUT : STT_ERROR_OPERATION_FAILED);
+
+		SLOG(LOG_DEBUG, TAG_STTC, "=====");
+		SLOG(LOG_DEBUG, TAG_STTC, " ");
+		return;
 	}
 
+	stt_dbus_connect_peer();
+
 	/* request initialization */
 	int ret = -1;
 	int i = 1;
 	bool silence_supported = false;
 	bool profanity_supported = false;
 	bool punctuation_supported = false;
+	bool engine_loading = false;
+	stt_capability_s capability;
+
+	memset(&capability, 0, sizeof(stt_capability_s));
 
 	while (1) {
-		ret = stt_dbus_request_initialize(client->uid, &silence_supported, &profanity_supported, &punctuation_supported);
+		ret = stt_dbus_request_initialize(client->uid, &silence_supported, &profanity_supported, &punctuation_supported, 
+						  &engine_loading, &capability);
 
 		if (STT_ERROR_ENGINE_NOT_FOUND == ret) {
 			SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to initialize : STT Engine Not found");
 			
-			client->reason = STT_ERROR_ENGINE_NOT_FOUND;
+			__stt_post_error(client, STT_ERROR_ENGINE_NOT_FOUND);
 
-			ecore_timer_add(0, __stt_notify_error, (void*)stt);
-
-			return EINA_FALSE;
+			return;
 
 		} else if(0 != ret) {
 			usleep(1);
 			if(CONNECTION_RETRY_COUNT == i) {
 				SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to initialize : TIMED OUT");
 
-				client->reason = STT_ERROR_TIMED_OUT;
-
-				ecore_timer_add(0, __stt_notify_error, (void*)stt);
+				__stt_post_error(client, STT_ERROR_TIMED_OUT);
 
-				return EINA_FALSE;
+				return;
 			}    
 			i++;
+		} else if (true == engine_loading) {
+			/* daemon notifies when engine is loaded */
+			SLOG(LOG_DEBUG, TAG_STTC, "[SUCCESS] uid(%d), wait for engine loading", client->uid);
+			SLOG(LOG_DEBUG, TAG_STTC, "=====");
+			SLOG(LOG_DEBUG, TAG_STTC, "  ");
+			return;
 		} else {
 			/* success to connect stt-daemon */
 			stt_client_set_option_supported(client->stt, silence_supported, profanity_supported, punctuation_supported);
 			SLOG(LOG_DEBUG, TAG_STTC, "Supported options : silence(%s), profanity(%s), punctuation(%s)", 
 				silence_supported ? "true" : "false", profanity_supported ? "true" : "false", punctuation_supported ? "true" : "false");
+
+			/* answer queries of app without asking daemon */
+			stt_client_set_capability(client->stt, &capability);
 			break;
 		}
 	}
@@ -176,14 +195,12 @@ static Eina_Bool __stt_connect_daemon(void *data)
 	client->before_state = client->current_state;
 	client->current_state = STT_STATE_READY;
 
-	ecore_timer_add(0, __stt_notify_state_changed, (void*)stt);
+	__stt_post_state_changed(client);
 
 	SLOG(LOG_DEBUG, TAG_STTC, "[SUCCESS] uid(%d)", client->uid);
 
 	SLOG(LOG_DEBUG, TAG_STTC, "=====");
 	SLOG(LOG_DEBUG, TAG_STTC, "  ");
-
-	return EINA_FALSE;
 }
 
 
@@ -209,7 +226,21 @@ int stt_prepare(stt_h stt)
 		return STT_ERROR_INVALID_STATE;
 	}
 
-	ecore_timer_add(0, __stt_connect_daemon, (void*)stt);
+	if (NULL != client->request) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Invalid State: Daemon is being connected"); 
+		SLOG(LOG_DEBUG, TAG_STTC, "=====");
+		SLOG(LOG_DEBUG, TAG_STTC, " ");
+		return STT_ERROR_INVALID_STATE;
+	}
+
+	/* hello starts daemon if needed and is answered when daemon is ready */
+	int ret = stt_dbus_request_hello_async(__stt_hello_reply, (void*)stt, &client->request);
+	if (0 != ret) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to request hello");
+		SLOG(LOG_DEBUG, TAG_STTC, "=====");
+		SLOG(LOG_DEBUG, TAG_STTC, " ");
+		return STT_ERROR_OPERATION_FAILED;
+	}
 
 	SLOG(LOG_DEBUG, TAG_STTC, "=====");
 	SLOG(LOG_DEBUG, TAG_STTC, " ");
@@ -237,15 +268,24 @@ int stt_unprepare(stt_h stt)
 		return STT_ERROR_INVALID_STATE;
 	}
 
+	/* late reply of start or stop should not change state of unprepared handle */
+	__stt_drop_request(client);
+
 	int ret = stt_dbus_request_finalize(client->uid);
 	if (0 != ret) {
 		SLOG(LOG_WARN, TAG_STTC, "[ERROR] Fail to request finalize");
 	}
 
+	/* queued request is dropped by daemon on finalize */
+	client->queued = false;
+
+	/* engine may be changed until next prepare */
+	stt_client_set_capability(client->stt, NULL);
+
 	client->before_state = client->current_state;
 	client->current_state = STT_STATE_CREATED;
 
-	ecore_timer_add(0, __stt_notify_state_changed, (void*)stt);
+	__stt_post_state_changed(client);
 
 	SLOG(LOG_DEBUG, TAG_STTC, "=====");
 	SLOG(LOG_DEBUG, TAG_STTC, " ");
@@ -275,6 +315,24 @@ int stt_foreach_supported_languages(stt_h stt, stt_supported_language_cb callbac
 	}
 
 	int ret = 0;
+
+	if (true == client->capability.valid) {
+		/* cached language list */
+		GList* iter = g_list_first(client->capability.lang_list);
+
+		while (NULL != iter) {
+			if (true != callback(client->stt, (const char*)iter->data, user_data))
+				break;
+
+			iter = g_list_next(iter);
+		}
+
+		SLOG(LOG_DEBUG, TAG_STTC, "=====");
+		SLOG(LOG_DEBUG, TAG_STTC, " ");
+
+		return STT_ERROR_NONE;
+	}
+
 	ret = stt_dbus_request_get_support_langs(client->uid, client->stt, callback, user_data);
 	if (0 != ret) {
 		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to get languages");
@@ -311,7 +369,13 @@ int stt_get_default_language(stt_h stt, char** language)
 	}
 
 	int ret = 0;
-	ret = stt_dbus_request_get_default_lang(client->uid, language);
+
+	if (true == client->capability.valid && NULL != client->capability.default_lang) {
+		*language = strdup(client->capability.default_lang);
+		ret = (NULL != *language) ? STT_ERROR_NONE : STT_ERROR_OUT_OF_MEMORY;
+	} else {
+		ret = stt_dbus_request_get_default_lang(client->uid, language);
+	}
 
 	if (0 != ret) {
 		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail : request get default language");
@@ -366,7 +430,11 @@ int stt_is_partial_result_supported(stt_h stt, bool* partial_result)
 	}
 
 	int ret = 0;
-	ret = stt_dbus_request_is_partial_result_supported(client->uid, partial_result);
+
+	if (true == client->capability.valid) 
+		*partial_result = client->capability.partial_result;
+	else
+		ret = stt_dbus_request_is_partial_result_supported(client->uid, partial_result);
 
 	if (0 != ret) {
 		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to get partial result supported");
@@ -461,71 +529,198 @@ int stt_set_silence_detection(stt_h stt, stt_option_silence_detection_e type)
 	return STT_ERROR_NONE;
 }
 
-int stt_start(stt_h stt, const char* language, const char* type)
+int stt_set_queue_option(stt_h stt, int priority, int wait_timeout)
 {
-	SLOG(LOG_DEBUG, TAG_STTC, "===== STT START");
+	if (NULL == stt) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Input parameter is NULL");
+		return STT_ERROR_INVALID_PARAMETER;
+	}
+
+	stt_client_s* client = stt_client_get(stt);
+
+	if (NULL == client) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Set queue option : A handle is not valid");
+		return STT_ERROR_INVALID_PARAMETER;
+	}
+
+	if (STT_STATE_READY != client->current_state) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Current state is not 'ready'."); 
+		return STT_ERROR_INVALID_STATE;
+	}
+
+	if (0 > wait_timeout) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Wait time is invalid");
+		return STT_ERROR_INVALID_PARAMETER;
+	}
+
+	client->priority = priority;
+	client->wait_timeout = wait_timeout;
+
+	return STT_ERROR_NONE;
+}
 
+int stt_set_partial_result_interval(stt_h stt, int interval)
+{
 	if (NULL == stt) {
 		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Input parameter is NULL");
-		SLOG(LOG_DEBUG, TAG_STTC, "=====");
-		SLOG(LOG_DEBUG, TAG_STTC, " ");
 		return STT_ERROR_INVALID_PARAMETER;
 	}
 
 	stt_client_s* client = stt_client_get(stt);
 
-	/* check handle */
 	if (NULL == client) {
-		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] A handle is not available");
-		SLOG(LOG_DEBUG, TAG_STTC, "=====");
-		SLOG(LOG_DEBUG, TAG_STTC, " ");
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Set partial result interval : A handle is not valid");
 		return STT_ERROR_INVALID_PARAMETER;
 	}
 
+	if (STT_STATE_READY != client->current_state) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Current state is not 'ready'."); 
+		return STT_ERROR_INVALID_STATE;
+	}
+
+	if (0 > interval) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Interval is invalid");
+		return STT_ERROR_INVALID_PARAMETER;
+	}
+
+	client->partial_interval = interval;
+
+	return STT_ERROR_NONE;
+}
+
+/** State after session. One-shot client is not registered in daemon any more */
+stt_state_e __stt_get_idle_state(stt_client_s* client)
+{
+	if (true == client->once) {
+		client->once = false;
+		return STT_STATE_CREATED;
+	}
+
+	return STT_STATE_READY;
+}
+
+int __stt_check_start(stt_client_s* client)
+{
 	/* check state */
 	if (client->current_state != STT_STATE_READY) {
 		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Invalid State: Current state is not READY"); 
-		SLOG(LOG_DEBUG, TAG_STTC, "=====");
-		SLOG(LOG_DEBUG, TAG_STTC, " ");
 		return STT_ERROR_INVALID_STATE;
 	}
 
-	char* temp;
-	if (NULL == language) {
-		temp = strdup("default");
-	} else {
-		temp = strdup(language);
+	if (true == client->queued) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Invalid State: Start request is waiting in queue"); 
+		return STT_ERROR_INVALID_STATE;
 	}
 
-	int ret; 
-	/* do request */
-	ret = stt_dbus_request_start(client->uid, temp, type, client->profanity, client->punctuation, client->silence);
+	if (NULL != client->request) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Invalid State: Request is in progress"); 
+		return STT_ERROR_INVALID_STATE;
+	}
 
+	return STT_ERROR_NONE;
+}
+
+void __stt_start_completed(stt_client_s* client, int ret, int position)
+{
 	if (ret) {
 		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to start");
+	} else if (0 < position) {
+		SLOG(LOG_DEBUG, TAG_STTC, "[SUCCESS] Start request is queued : position(%d)", position);
+
+		/* state is changed by daemon when request is started */
+		client->queued = true;
+		__stt_cb_queue_position(client->uid, position);
 	} else {
 		SLOG(LOG_DEBUG, TAG_STTC, "[SUCCESS]");
 
 		client->before_state = client->current_state;
 		client->current_state = STT_STATE_RECORDING;
 
-		ecore_timer_add(0, __stt_notify_state_changed, (void*)stt);
+		__stt_post_state_changed(client);
 	}
+}
 
-	free(temp);
+int __stt_check_stop(stt_client_s* client)
+{
+	/* check state */
+	if (client->current_state != STT_STATE_RECORDING) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Invalid State : Current state is NOT RECORDING"); 
+		return STT_ERROR_INVALID_STATE;
+	}
 
-	SLOG(LOG_DEBUG, TAG_STTC, "=====");
-	SLOG(LOG_DEBUG, TAG_STTC, " ");
+	if (NULL != client->request) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Invalid State: Request is in progress"); 
+		return STT_ERROR_INVALID_STATE;
+	}
 
-	return ret;
+	return STT_ERROR_NONE;
 }
 
-int stt_stop(stt_h stt)
+void __stt_stop_completed(stt_client_s* client, int ret)
 {
-	SLOG(LOG_DEBUG, TAG_STTC, "===== STT STOP");
+	if (0 != ret) {
+		SLOG(LOG_DEBUG, TAG_STTC, "[ERROR] Fail to stop");
+	} else {
+		SLOG(LOG_DEBUG, TAG_STTC, "[SUCCESS]");
+
+		client->before_state = client->current_state;
+		client->current_state = STT_STATE_PROCESSING;
+
+		__stt_post_state_changed(client);
+	}
+}
+
+int __stt_check_cancel(stt_client_s* client)
+{
+	if (NULL != client->request) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Invalid State: Request is in progress"); 
+		return STT_ERROR_INVALID_STATE;
+	}
+
+	/* start request waiting in queue can be canceled */
+	if (true == client->queued)
+		return STT_ERROR_NONE;
+
+	/* check state */
+	if (STT_STATE_RECORDING != client->current_state && STT_STATE_PROCESSING != client->current_state) {
+		SLOG(LOG_DEBUG, TAG_STTC, "[ERROR] Invalid state : Current state is 'Ready'");
+		return STT_ERROR_INVALID_STATE;
+	}
+
+	return STT_ERROR_NONE;
+}
+
+void __stt_cancel_completed(stt_client_s* client, int ret, bool queued)
+{
+	if (true == queued) {
+		/* cancel start request waiting in queue */
+		if (0 != ret) {
+			SLOG(LOG_DEBUG, TAG_STTC, "[ERROR] Fail to cancel queued request");
+		} else {
+			SLOG(LOG_DEBUG, TAG_STTC, "[SUCCESS] Cancel queued request");
+			client->queued = false;
+		}
+		return;
+	}
+
+	if (0 != ret) {
+		SLOG(LOG_DEBUG, TAG_STTC, "[ERROR] Fail to cancel");
+	} else {
+		SLOG(LOG_DEBUG, TAG_STTC, "[SUCCESS]");
+
+		client->before_state = client->current_state;
+		client->current_state = __stt_get_idle_state(client);
+
+		__stt_post_state_changed(client);
+	}
+}
+
+int stt_start(stt_h stt, const char* language, const char* type)
+{
+	SLOG(LOG_DEBUG, TAG_STTC, "===== STT START");
 
 	if (NULL == stt) {
-		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] [ERROR] Input parameter is NULL");
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Input parameter is NULL");
 		SLOG(LOG_DEBUG, TAG_STTC, "=====");
 		SLOG(LOG_DEBUG, TAG_STTC, " ");
 		return STT_ERROR_INVALID_PARAMETER;
@@ -539,29 +734,30 @@ int stt_stop(stt_h stt)
 		SLOG(LOG_DEBUG, TAG_STTC, "=====");
 		SLOG(LOG_DEBUG, TAG_STTC, " ");
 		return STT_ERROR_INVALID_PARAMETER;
-	}   
-	
-	/* check state */
-	if (client->current_state != STT_STATE_RECORDING) {
-		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Invalid State : Current state is NOT RECORDING"); 
+	}
+
+	int ret = __stt_check_start(client);
+	if (0 != ret) {
 		SLOG(LOG_DEBUG, TAG_STTC, "=====");
 		SLOG(LOG_DEBUG, TAG_STTC, " ");
-		return STT_ERROR_INVALID_STATE;
+		return ret;
 	}
 
-	int ret = 0; 
-	/* do request */
-	ret = stt_dbus_request_stop(client->uid);
-	if (0 != ret) {
-		SLOG(LOG_DEBUG, TAG_STTC, "[ERROR] Fail to stop");
+	char* temp;
+	if (NULL == language) {
+		temp = strdup("default");
 	} else {
-		SLOG(LOG_DEBUG, TAG_STTC, "[SUCCESS]");
+		temp = strdup(language);
+	}
 
-		client->before_state = client->current_state;
-		client->current_state = STT_STATE_PROCESSING;
+	int position = 0;
+	/* do request */
+	ret = stt_dbus_request_start(client->uid, temp, type, client->profanity, client->punctuation, client->silence, 
+				     client->priority, client->wait_timeout, client->partial_interval, &position);
 
-		ecore_timer_add(0, __stt_notify_state_changed, (void*)stt);
-	}
+	__stt_start_completed(client, ret, position);
+
+	free(temp);
 
 	SLOG(LOG_DEBUG, TAG_STTC, "=====");
 	SLOG(LOG_DEBUG, TAG_STTC, " ");
@@ -569,13 +765,12 @@ int stt_stop(stt_h stt)
 	return ret;
 }
 
-
-int stt_cancel(stt_h stt)
+int stt_recognize_once(stt_h stt, const char* language, const char* type)
 {
-	SLOG(LOG_DEBUG, TAG_STTC, "===== STT CANCEL");
+	SLOG(LOG_DEBUG, TAG_STTC, "===== STT RECOGNIZE ONCE");
 
-	if (NULL == stt) {
-		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Input handle is null");
+	if (NULL == stt || NULL == type) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Input parameter is NULL");
 		SLOG(LOG_DEBUG, TAG_STTC, "=====");
 		SLOG(LOG_DEBUG, TAG_STTC, " ");
 		return STT_ERROR_INVALID_PARAMETER;
@@ -589,28 +784,37 @@ int stt_cancel(stt_h stt)
 		SLOG(LOG_DEBUG, TAG_STTC, "=====");
 		SLOG(LOG_DEBUG, TAG_STTC, " ");
 		return STT_ERROR_INVALID_PARAMETER;
-	} 	
+	}
 
 	/* check state */
-	if (STT_STATE_RECORDING != client->current_state && STT_STATE_PROCESSING != client->current_state) {
-		SLOG(LOG_DEBUG, TAG_STTC, "[ERROR] Invalid state : Current state is 'Ready'");
+	if (client->current_state != STT_STATE_CREATED) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Invalid State: Current state is not 'CREATED'"); 
 		SLOG(LOG_DEBUG, TAG_STTC, "=====");
 		SLOG(LOG_DEBUG, TAG_STTC, " ");
 		return STT_ERROR_INVALID_STATE;
 	}
 
-	int ret; 
-	/* do request */
-	ret = stt_dbus_request_cancel(client->uid);
+	if (NULL != client->request) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Invalid State: Daemon is being connected"); 
+		SLOG(LOG_DEBUG, TAG_STTC, "=====");
+		SLOG(LOG_DEBUG, TAG_STTC, " ");
+		return STT_ERROR_INVALID_STATE;
+	}
+
+	/* daemon registers uid, starts and removes uid when session ends */
+	int ret = stt_dbus_request_recognize_once(client->uid, (NULL == language) ? "default" : language, type, 
+				client->profanity, client->punctuation, client->silence);
 	if (0 != ret) {
-		SLOG(LOG_DEBUG, TAG_STTC, "[ERROR] Fail to cancel");
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to recognize once");
 	} else {
 		SLOG(LOG_DEBUG, TAG_STTC, "[SUCCESS]");
 
+		client->once = true;
+
 		client->before_state = client->current_state;
-		client->current_state = STT_STATE_READY;
+		client->current_state = STT_STATE_RECORDING;
 
-		ecore_timer_add(0, __stt_notify_state_changed, (void*)stt);
+		__stt_post_state_changed(client);
 	}
 
 	SLOG(LOG_DEBUG, TAG_STTC, "=====");
@@ -619,10 +823,14 @@ int stt_cancel(stt_h stt)
 	return ret;
 }
 
-int stt_get_recording_volume(stt_h stt, float* volume)
+int stt_prewarm(stt_h stt, const char* language, const char* type, int hold_ms)
 {
-	if (NULL == stt || NULL == volume) {
+	SLOG(LOG_DEBUG, TAG_STTC, "===== STT PREWARM");
+
+	if (NULL == stt || NULL == type) {
 		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Input parameter is NULL");
+		SLOG(LOG_DEBUG, TAG_STTC, "=====");
+		SLOG(LOG_DEBUG, TAG_STTC, " ");
 		return STT_ERROR_INVALID_PARAMETER;
 	}
 
@@ -631,185 +839,562 @@ int stt_get_recording_volume(stt_h stt, float* volume)
 	/* check handle */
 	if (NULL == client) {
 		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] A handle is not available");
+		SLOG(LOG_DEBUG, TAG_STTC, "=====");
+		SLOG(LOG_DEBUG, TAG_STTC, " ");
 		return STT_ERROR_INVALID_PARAMETER;
-	} 
-	
-	if (STT_STATE_RECORDING != client->current_state) {
-		SLOG(LOG_DEBUG, TAG_STTC, "[ERROR] Invalid state : NO 'Recording' state");
-		return STT_ERROR_INVALID_STATE;
-	}    
-	
-	int ret = 0; 
-	ret = stt_dbus_request_get_audio_volume(client->uid, volume);
-	if (ret) {
-		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to get audio volume");
+	}
+
+	int ret = __stt_check_start(client);
+	if (0 != ret) {
+		SLOG(LOG_DEBUG, TAG_STTC, "=====");
+		SLOG(LOG_DEBUG, TAG_STTC, " ");
 		return ret;
-	}    
+	}
 
-	return STT_ERROR_NONE;
+	/* options should be same with next start */
+	ret = stt_dbus_request_prewarm(client->uid, (NULL == language) ? "default" : language, type, 
+				client->profanity, client->punctuation, client->silence, hold_ms);
+	if (0 != ret) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to request prewarm");
+	}
+
+	SLOG(LOG_DEBUG, TAG_STTC, "=====");
+	SLOG(LOG_DEBUG, TAG_STTC, " ");
+
+	return ret;
 }
 
-static Eina_Bool __stt_notify_error(void *data)
+int stt_stop(stt_h stt)
 {
-	stt_h stt = (stt_h)data;
-
-	stt_client_s* client = stt_client_get(stt);
+	SLOG(LOG_DEBUG, TAG_STTC, "===== STT STOP");
 
-	/* check handle */
-	if (NULL == client) {
-		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to notify error : A handle is not valid");
-		return EINA_FALSE;
-	}
+	if (NULL == stt) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] [ERROR] Input parameter is NULL");
+		SLOG(LOG_DEBUG, TAG_STTC, "=====");
+		SLOG(LOG_DEBUG, TAG_STTC, " ");
+		return STT_ERROR_INVALID_PARAMETER;
+	}
 
-	if (NULL != client->error_cb) {
+	stt_client_s* client = stt_client_get(stt);
+
+	/* check handle */
+	if (NULL == client) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] A handle is not available");
+		SLOG(LOG_DEBUG, TAG_STTC, "=====");
+		SLOG(LOG_DEBUG, TAG_STTC, " ");
+		return STT_ERROR_INVALID_PARAMETER;
+	}   
+	
+	int ret = __stt_check_stop(client);
+	if (0 != ret) {
+		SLOG(LOG_DEBUG, TAG_STTC, "=====");
+		SLOG(LOG_DEBUG, TAG_STTC, " ");
+		return ret;
+	}
+
+	/* do request */
+	ret = stt_dbus_request_stop(client->uid);
+
+	__stt_stop_completed(client, ret);
+
+	SLOG(LOG_DEBUG, TAG_STTC, "=====");
+	SLOG(LOG_DEBUG, TAG_STTC, " ");
+
+	return ret;
+}
+
+
+int stt_cancel(stt_h stt)
+{
+	SLOG(LOG_DEBUG, TAG_STTC, "===== STT CANCEL");
+
+	if (NULL == stt) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Input handle is null");
+		SLOG(LOG_DEBUG, TAG_STTC, "=====");
+		SLOG(LOG_DEBUG, TAG_STTC, " ");
+		return STT_ERROR_INVALID_PARAMETER;
+	}
+
+	stt_client_s* client = stt_client_get(stt);
+
+	/* check handle */
+	if (NULL == client) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] A handle is not available");
+		SLOG(LOG_DEBUG, TAG_STTC, "=====");
+		SLOG(LOG_DEBUG, TAG_STTC, " ");
+		return STT_ERROR_INVALID_PARAMETER;
+	} 	
+
+	int ret = __stt_check_cancel(client);
+	if (0 != ret) {
+		SLOG(LOG_DEBUG, TAG_STTC, "=====");
+		SLOG(LOG_DEBUG, TAG_STTC, " ");
+		return ret;
+	}
+
+	bool queued = client->queued;
+
+	/* do request */
+	ret = stt_dbus_request_cancel(client->uid);
+
+	__stt_cancel_completed(client, ret, queued);
+
+	SLOG(LOG_DEBUG, TAG_STTC, "=====");
+	SLOG(LOG_DEBUG, TAG_STTC, " ");
+
+	return ret;
+}
+
+/*
+* Asynchronous API
+*/
+
+void __stt_notify_request_completed(stt_client_s* client, int result)
+{
+	stt_request_completed_cb callback = client->request_cb;
+	void* user_data = client->request_user_data;
+
+	/* callback can make next request */
+	client->request = NULL;
+	client->request_cb = NULL;
+	client->request_user_data = NULL;
+
+	if (NULL != callback) {
 		stt_client_use_callback(client);
-		client->error_cb(client->stt, client->reason, client->error_user_data); 
+		callback(client->stt, result, user_data);
 		stt_client_not_use_callback(client);
-		SLOG(LOG_DEBUG, TAG_STTC, "Error callback is called");
-	} else {
-		SLOG(LOG_WARN, TAG_STTC, "[WARNING] Error callback is null");
+		SLOG(LOG_DEBUG, TAG_STTC, "Request completed callback is called : result(%d)", result);
+	}
+}
+
+void __stt_start_reply(DBusMessage* reply, int result, void* user_data)
+{
+	stt_client_s* client = stt_client_get((stt_h)user_data);
+	if (NULL == client) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] A handle is not available");
+		return;
 	}
 
-	return EINA_FALSE;
+	int position = 0;
+	if (STT_ERROR_NONE == result)
+		result = stt_dbus_get_start_result(reply, &position);
+
+	__stt_start_completed(client, result, position);
+
+	__stt_notify_request_completed(client, result);
 }
 
-int __stt_cb_error(int uid, int reason)
+void __stt_stop_reply(DBusMessage* reply, int result, void* user_data)
 {
-	stt_client_s* client = stt_client_get_by_uid(uid);
-	if( NULL == client ) {
-		SLOG(LOG_ERROR, TAG_STTC, "Handle not found\n");
-		return -1;
+	stt_client_s* client = stt_client_get((stt_h)user_data);
+	if (NULL == client) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] A handle is not available");
+		return;
 	}
 
-	client->reason = reason;
+	if (STT_ERROR_NONE == result)
+		result = stt_dbus_get_result(reply);
 
-	if (NULL != client->error_cb) {
-		ecore_timer_add(0, __stt_notify_error, client->stt);
-	} else {
-		SLOG(LOG_WARN, TAG_STTC, "[WARNING] Error callback is null");
-	}    
+	__stt_stop_completed(client, result);
 
-	return 0;
+	__stt_notify_request_completed(client, result);
+}
+
+void __stt_cancel_reply(DBusMessage* reply, int result, void* user_data)
+{
+	stt_client_s* client = stt_client_get((stt_h)user_data);
+	if (NULL == client) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] A handle is not available");
+		return;
+	}
+
+	if (STT_ERROR_NONE == result)
+		result = stt_dbus_get_result(reply);
+
+	__stt_cancel_completed(client, result, client->queued);
+
+	__stt_notify_request_completed(client, result);
 }
 
-static Eina_Bool __stt_notify_result(void *data)
+int stt_start_async(stt_h stt, const char* language, const char* type, stt_request_completed_cb callback, void* user_data)
 {
-	stt_h stt = (stt_h)data;
+	SLOG(LOG_DEBUG, TAG_STTC, "===== STT START ASYNC");
+
+	if (NULL == stt) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Input parameter is NULL");
+		return STT_ERROR_INVALID_PARAMETER;
+	}
 
 	stt_client_s* client = stt_client_get(stt);
 
 	/* check handle */
 	if (NULL == client) {
-		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to notify error : A handle is not valid");
-		return EINA_FALSE;
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] A handle is not available");
+		return STT_ERROR_INVALID_PARAMETER;
 	}
 
-	if (NULL != client->result_cb) {
-		stt_client_use_callback(client);
-		client->result_cb(client->stt, client->type, (const char**)client->data_list, client->data_count, client->msg, client->result_user_data);
-		stt_client_not_use_callback(client);
-		SLOG(LOG_DEBUG, TAG_STTC, "client result callback called");
-	} else {
-		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] User result callback is null");
-	} 
+	int ret = __stt_check_start(client);
+	if (0 != ret) 
+		return ret;
 
-	/* Free result */
-	if (NULL != client->type)
-		free(client->type);
+	ret = stt_dbus_request_start_async(client->uid, (NULL == language) ? "default" : language, type, 
+				client->profanity, client->punctuation, client->silence, 
+				client->priority, client->wait_timeout, client->partial_interval, 
+				__stt_start_reply, (void*)stt, &client->request);
 
-	if (NULL != client->data_list) {
-		char **temp = NULL;
-		temp = client->data_list;
+	if (0 != ret) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to request start");
+		return ret;
+	}
 
-		int i = 0;
-		for (i = 0;i < client->data_count;i++) {
-			if(NULL != temp[i])
-				free(temp[i]);
-			else 
-				SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Result data is error");
-		}
-		free(client->data_list);
+	client->request_cb = callback;
+	client->request_user_data = user_data;
+
+	SLOG(LOG_DEBUG, TAG_STTC, "=====");
+	SLOG(LOG_DEBUG, TAG_STTC, " ");
+
+	return STT_ERROR_NONE;
+}
+
+int stt_stop_async(stt_h stt, stt_request_completed_cb callback, void* user_data)
+{
+	SLOG(LOG_DEBUG, TAG_STTC, "===== STT STOP ASYNC");
+
+	if (NULL == stt) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Input parameter is NULL");
+		return STT_ERROR_INVALID_PARAMETER;
 	}
-	
-	if (NULL != client->msg) 
-		free(client->msg);
 
-	client->data_count = 0;
+	stt_client_s* client = stt_client_get(stt);
+
+	/* check handle */
+	if (NULL == client) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] A handle is not available");
+		return STT_ERROR_INVALID_PARAMETER;
+	}
+
+	int ret = __stt_check_stop(client);
+	if (0 != ret) 
+		return ret;
+
+	ret = stt_dbus_request_stop_async(client->uid, __stt_stop_reply, (void*)stt, &client->request);
+	if (0 != ret) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to request stop");
+		return ret;
+	}
+
+	client->request_cb = callback;
+	client->request_user_data = user_data;
+
+	SLOG(LOG_DEBUG, TAG_STTC, "=====");
+	SLOG(LOG_DEBUG, TAG_STTC, " ");
 
-	return EINA_FALSE;
+	return STT_ERROR_NONE;
 }
 
-static Eina_Bool __stt_notify_state_changed(void *data)
+int stt_cancel_async(stt_h stt, stt_request_completed_cb callback, void* user_data)
 {
-	stt_h stt = (stt_h)data;
+	SLOG(LOG_DEBUG, TAG_STTC, "===== STT CANCEL ASYNC");
+
+	if (NULL == stt) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Input parameter is NULL");
+		return STT_ERROR_INVALID_PARAMETER;
+	}
 
 	stt_client_s* client = stt_client_get(stt);
 
 	/* check handle */
 	if (NULL == client) {
-		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to notify error : A handle is not valid");
-		return EINA_FALSE;
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] A handle is not available");
+		return STT_ERROR_INVALID_PARAMETER;
 	}
 
-	if (NULL != client->state_changed_cb) {
-		stt_client_use_callback(client);
-		client->state_changed_cb(client->stt, client->before_state, client->current_state, client->state_changed_user_data); 
-		stt_client_not_use_callback(client);
-		SLOG(LOG_DEBUG, TAG_STTC, "State changed callback is called");
-	} else {
-		SLOG(LOG_WARN, TAG_STTC, "[WARNING] State changed callback is null");
+	int ret = __stt_check_cancel(client);
+	if (0 != ret) 
+		return ret;
+
+	ret = stt_dbus_request_cancel_async(client->uid, __stt_cancel_reply, (void*)stt, &client->request);
+	if (0 != ret) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to request cancel");
+		return ret;
+	}
+
+	client->request_cb = callback;
+	client->request_user_data = user_data;
+
+	SLOG(LOG_DEBUG, TAG_STTC, "=====");
+	SLOG(LOG_DEBUG, TAG_STTC, " ");
+
+	return STT_ERROR_NONE;
+}
+
+/** Drop request in progress without callback */
+void __stt_drop_request(stt_client_s* client)
+{
+	if (NULL == client->request)
+		return;
+
+	stt_dbus_cancel_call(client->request);
+
+	client->request = NULL;
+	client->request_cb = NULL;
+	client->request_user_data = NULL;
+}
+
+int stt_cancel_request(stt_h stt)
+{
+	SLOG(LOG_DEBUG, TAG_STTC, "===== STT CANCEL REQUEST");
+
+	if (NULL == stt) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Input parameter is NULL");
+		return STT_ERROR_INVALID_PARAMETER;
+	}
+
+	stt_client_s* client = stt_client_get(stt);
+
+	/* check handle */
+	if (NULL == client) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] A handle is not available");
+		return STT_ERROR_INVALID_PARAMETER;
+	}
+
+	if (NULL == client->request) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Invalid State: No request is in progress"); 
+		return STT_ERROR_INVALID_STATE;
+	}
+
+	/* connecting daemon is not a request of app */
+	if (STT_STATE_CREATED == client->current_state) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Invalid State: Current state is 'CREATED'"); 
+		return STT_ERROR_INVALID_STATE;
+	}
+
+	__stt_drop_request(client);
+
+	/* daemon may have handled request already, so session is canceled without waiting */
+	stt_dbus_request_cancel_async(client->uid, NULL, NULL, NULL);
+
+	client->queued = false;
+
+	if (STT_STATE_READY != client->current_state) {
+		client->before_state = client->current_state;
+		client->current_state = __stt_get_idle_state(client);
+
+		__stt_post_state_changed(client);
+	}
+
+	SLOG(LOG_DEBUG, TAG_STTC, "=====");
+	SLOG(LOG_DEBUG, TAG_STTC, " ");
+
+	return STT_ERROR_NONE;
+}
+
+int stt_get_recording_volume(stt_h stt, float* volume)
+{
+	if (NULL == stt || NULL == volume) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Input parameter is NULL");
+		return STT_ERROR_INVALID_PARAMETER;
 	}
 
-	return EINA_FALSE;
+	stt_client_s* client = stt_client_get(stt);
+
+	/* check handle */
+	if (NULL == client) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] A handle is not available");
+		return STT_ERROR_INVALID_PARAMETER;
+	} 
+	
+	if (STT_STATE_RECORDING != client->current_state) {
+		SLOG(LOG_DEBUG, TAG_STTC, "[ERROR] Invalid state : NO 'Recording' state");
+		return STT_ERROR_INVALID_STATE;
+	}    
+	
+	int ret = 0; 
+	ret = stt_dbus_request_get_audio_volume(client->uid, volume);
+	if (ret) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to get audio volume");
+		return ret;
+	}    
+
+	return STT_ERROR_NONE;
 }
 
-int __stt_cb_result(int uid, const char* type, const char** data, int data_count, const char* msg)
+/* one loop call delivers events of all handles */
+static stt_loop_source_h g_event_call = NULL;
+
+void __stt_deliver_event(stt_client_s* client, stt_event_s* event)
+{
+	stt_client_use_callback(client);
+
+	switch (event->type) {
+	case STT_EVENT_STATE_CHANGED:
+		if (NULL != client->state_changed_cb) {
+			client->state_changed_cb(client->stt, event->before_state, event->current_state, client->state_changed_user_data); 
+			SLOG(LOG_DEBUG, TAG_STTC, "State changed callback is called");
+		} else {
+			SLOG(LOG_WARN, TAG_STTC, "[WARNING] State changed callback is null");
+		}
+		break;
+
+	case STT_EVENT_RESULT:
+		if (NULL != client->result_cb) {
+			client->result_cb(client->stt, event->result->type, (const char**)event->result->data_list, event->result->data_count, 
+				event->result->msg, client->result_user_data);
+			SLOG(LOG_DEBUG, TAG_STTC, "client result callback called");
+		} else {
+			SLOG(LOG_ERROR, TAG_STTC, "[ERROR] User result callback is null");
+		}
+		break;
+
+	case STT_EVENT_PARTIAL_RESULT:
+		if (NULL != client->partial_result_cb) {
+			client->partial_result_cb(client->stt, event->text, client->partial_result_user_data);
+			SLOG(LOG_DEBUG, TAG_STTC, "Partial result callback is called");
+		} else {
+			SLOG(LOG_WARN, TAG_STTC, "[WARNING] Partial result callback is null");
+		}
+		break;
+
+	case STT_EVENT_ERROR:
+		if (NULL != client->error_cb) {
+			client->error_cb(client->stt, event->value, client->error_user_data); 
+			SLOG(LOG_DEBUG, TAG_STTC, "Error callback is called");
+		} else {
+			SLOG(LOG_WARN, TAG_STTC, "[WARNING] Error callback is null");
+		}
+		break;
+
+	case STT_EVENT_QUEUE_POSITION:
+		/* request is started or dropped before notification */
+		if (true == client->queued && NULL != client->queue_position_cb) {
+			client->queue_position_cb(client->stt, event->value, client->queue_position_user_data); 
+			SLOG(LOG_DEBUG, TAG_STTC, "Queue position callback is called");
+		}
+		break;
+	}
+
+	stt_client_not_use_callback(client);
+}
+
+void __stt_deliver_events(void *data)
+{
+	stt_client_s* client = NULL;
+
+	/* callback can create or destroy other handle, so handle is looked up for each event */
+	while (NULL != (client = stt_client_get_with_event())) {
+		stt_event_s* event = stt_client_pop_event(client);
+
+		__stt_deliver_event(client, event);
+		stt_client_free_event(event);
+	}
+
+	g_event_call = NULL;
+}
+
+/** Queue event of handle in order. Event is freed after delivery */
+void __stt_post_event(stt_client_s* client, stt_event_s* event)
+{
+	stt_client_push_event(client, event);
+
+	if (NULL == g_event_call)
+		g_event_call = stt_loop_add_call(__stt_deliver_events, NULL);
+}
+
+stt_event_s* __stt_new_event(stt_event_type_e type)
+{
+	stt_event_s* event = (stt_event_s*)calloc(1, sizeof(stt_event_s));
+	if (NULL == event) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to allocate event");
+		return NULL;
+	}
+
+	event->type = type;
+
+	return event;
+}
+
+void __stt_post_state_changed(stt_client_s* client)
+{
+	stt_event_s* event = __stt_new_event(STT_EVENT_STATE_CHANGED);
+	if (NULL == event)
+		return;
+
+	/* states are captured now, so quick transitions are all delivered */
+	event->before_state = client->before_state;
+	event->current_state = client->current_state;
+
+	__stt_post_event(client, event);
+}
+
+void __stt_post_error(stt_client_s* client, int reason)
+{
+	stt_event_s* event = __stt_new_event(STT_EVENT_ERROR);
+	if (NULL == event)
+		return;
+
+	event->value = reason;
+
+	__stt_post_event(client, event);
+}
+
+int __stt_cb_error(int uid, int reason)
+{
+	stt_client_s* client = stt_client_get_by_uid(uid);
+	if( NULL == client ) {
+		SLOG(LOG_ERROR, TAG_STTC, "Handle not found\n");
+		return -1;
+	}
+
+	/* queued request is dropped by daemon */
+	client->queued = false;
+
+	if (NULL != client->error_cb) {
+		__stt_post_error(client, reason);
+	} else {
+		SLOG(LOG_WARN, TAG_STTC, "[WARNING] Error callback is null");
+	}    
+
+	return 0;
+}
+
+int __stt_cb_result(int uid, stt_result_s* result)
 {
 	stt_client_s* client = NULL;
 	
 	client = stt_client_get_by_uid(uid);
 	if (NULL == client) {
 		SLOG(LOG_ERROR, TAG_STTC, "Handle is NOT valid");
+		free(result);
 		return -1;
 	}
 
-	SLOG(LOG_DEBUG, TAG_STTC, "Recognition Result Message = %s", msg);
+	SLOG(LOG_DEBUG, TAG_STTC, "Recognition Result Message = %s", result->msg);
 
 	int i=0;
-	for (i = 0;i < data_count;i++) {
-		if(NULL != data[i])
-			SLOG(LOG_DEBUG, TAG_STTC, "Recognition Result[%d] = %s", i, data[i]);
+	for (i = 0;i < result->data_count;i++) {
+		if(NULL != result->data_list[i])
+			SLOG(LOG_DEBUG, TAG_STTC, "Recognition Result[%d] = %s", i, result->data_list[i]);
 	}	
 
 	if (NULL != client->result_cb) {
-		client->type = strdup(type);
-		client->msg = strdup(msg);
-		client->data_count = data_count;
-
-		if (data_count > 0) {
-			char **temp = NULL;
-			temp = malloc( sizeof(char*) * data_count);
-
-			for (i = 0;i < data_count;i++) {
-				if(NULL != data[i])
-					temp[i] = strdup(data[i]);
-				else 
-					SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Result data is error");
-			}
-
-			client->data_list = temp;
+		stt_event_s* event = __stt_new_event(STT_EVENT_RESULT);
+		if (NULL != event) {
+			/* result is freed with event after callback */
+			event->result = result;
+			__stt_post_event(client, event);
+		} else {
+			free(result);
 		}
-
-		ecore_timer_add(0, __stt_notify_result, client->stt);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] User result callback is null");
+		free(result);
 	}   
 
 	client->before_state = client->current_state;
-	client->current_state = STT_STATE_READY;
+	client->current_state = __stt_get_idle_state(client);
 
 	if (NULL != client->state_changed_cb) {
-		ecore_timer_add(0, __stt_notify_state_changed, client->stt);
+		__stt_post_state_changed(client);
 	} else {
 		SLOG(LOG_WARN, TAG_STTC, "[WARNING] State changed callback is null");
 	}
@@ -817,54 +1402,132 @@ int __stt_cb_result(int uid, const char* type, const char** data, int data_count
 	return 0;
 }
 
-static Eina_Bool __stt_notify_partial_result(void *data)
+int __stt_cb_partial_result(int uid, int keep, const char* suffix)
 {
-	stt_h stt = (stt_h)data;
-
-	stt_client_s* client = stt_client_get(stt);
+	stt_client_s* client = NULL;
 
-	/* check handle */
+	client = stt_client_get_by_uid(uid);
 	if (NULL == client) {
-		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to notify error : A handle is not valid");
-		return EINA_FALSE;
+		SLOG(LOG_ERROR, TAG_STTC, "Handle is NOT valid");
+		return -1;
+	}
+
+	if (client->current_state == STT_STATE_READY) {
+		SLOG(LOG_ERROR, TAG_STTC, "Current state has already been 'Ready' state");	
+		return 0;
 	}
 
+	if (NULL == suffix)
+		return -1;
+
+	/* rebuild full text with previous one */
+	int len = (NULL != client->partial_text) ? strlen(client->partial_text) : 0;
+	if (0 > keep || len < keep) {
+		SLOG(LOG_ERROR, TAG_STTC, "Partial result is out of sync : keep(%d), length(%d)", keep, len);
+		keep = 0;
+	}
+
+	char* text = (char*)calloc(keep + strlen(suffix) + 1, sizeof(char));
+	if (NULL == text) {
+		SLOG(LOG_ERROR, TAG_STTC, "Fail : memory allocation error");
+		return -1;
+	}
+
+	if (0 < keep)
+		memcpy(text, client->partial_text, keep);
+	strcpy(text + keep, suffix);
+
+	if (NULL != client->partial_text)
+		free(client->partial_text);
+	client->partial_text = text;
+
 	if (client->partial_result_cb) {
-		stt_client_use_callback(client);
-		client->partial_result_cb(client->stt, client->partial_result, client->partial_result_user_data);
-		stt_client_not_use_callback(client);
-		SLOG(LOG_DEBUG, TAG_STTC, "Partial result callback is called");
+		/* every partial result is delivered with its own text */
+		stt_event_s* event = __stt_new_event(STT_EVENT_PARTIAL_RESULT);
+		if (NULL != event) {
+			event->text = strdup(text);
+			__stt_post_event(client, event);
+		}
 	} else {
 		SLOG(LOG_WARN, TAG_STTC, "[WARNING] Partial result callback is null");
-	}   
-
-	if (NULL != client->partial_result)
-		free(client->partial_result);
+	}  
 
-	return EINA_FALSE;
+	return 0;
 }
 
-int __stt_cb_partial_result(int uid, const char* data)
+int __stt_cb_engine_ready(int uid, int result, bool silence, bool profanity, bool punctuation, stt_capability_s* capability)
 {
-	stt_client_s* client = NULL;
+	stt_client_s* client = stt_client_get_by_uid(uid);
+	if( NULL == client ) {
+		SLOG(LOG_ERROR, TAG_STTC, "Handle not found");
+		return -1;
+	}
 
-	client = stt_client_get_by_uid(uid);
-	if (NULL == client) {
-		SLOG(LOG_ERROR, TAG_STTC, "Handle is NOT valid");
+	if (STT_STATE_CREATED != client->current_state) {
+		SLOG(LOG_WARN, TAG_STTC, "[WARNING] Current state is not 'Created'");
 		return -1;
 	}
 
-	if (client->current_state == STT_STATE_READY) {
-		SLOG(LOG_ERROR, TAG_STTC, "Current state has already been 'Ready' state");	
+	if (0 != result) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to load engine : result(%d)", result);
+
+		__stt_post_error(client, result);
 		return 0;
 	}
 
-	if (client->partial_result_cb) {
-		client->partial_result = strdup(data);
-		ecore_timer_add(0, __stt_notify_partial_result, client->stt);
-	} else {
-		SLOG(LOG_WARN, TAG_STTC, "[WARNING] Partial result callback is null");
-	}  
+	stt_client_set_option_supported(client->stt, silence, profanity, punctuation);
+	SLOG(LOG_DEBUG, TAG_STTC, "Supported options : silence(%s), profanity(%s), punctuation(%s)", 
+		silence ? "true" : "false", profanity ? "true" : "false", punctuation ? "true" : "false");
+
+	stt_client_set_capability(client->stt, capability);
+
+	client->before_state = client->current_state;
+	client->current_state = STT_STATE_READY;
+
+	__stt_post_state_changed(client);
+
+	return 0;
+}
+
+int __stt_cb_engine_changed(int uid, bool silence, bool profanity, bool punctuation, stt_capability_s* capability)
+{
+	stt_client_s* client = stt_client_get_by_uid(uid);
+	if( NULL == client ) {
+		SLOG(LOG_ERROR, TAG_STTC, "Handle not found");
+		return -1;
+	}
+
+	if (NULL == capability || false == capability->valid) {
+		/* queries go to daemon until next prepare */
+		SLOG(LOG_DEBUG, TAG_STTC, "Capability cache is invalidated");
+		stt_client_set_capability(client->stt, NULL);
+		return 0;
+	}
+
+	stt_client_set_option_supported(client->stt, silence, profanity, punctuation);
+	stt_client_set_capability(client->stt, capability);
+
+	SLOG(LOG_DEBUG, TAG_STTC, "Capability is updated : default language(%s), partial(%s)", 
+		client->capability.default_lang, client->capability.partial_result ? "true" : "false");
+
+	return 0;
+}
+
+int __stt_cb_queue_position(int uid, int position)
+{
+	stt_client_s* client = stt_client_get_by_uid(uid);
+	if( NULL == client ) {
+		SLOG(LOG_ERROR, TAG_STTC, "Handle not found");
+		return -1;
+	}
+
+	if (NULL != client->queue_position_cb) {
+		stt_event_s* event = __stt_new_event(STT_EVENT_QUEUE_POSITION);
+		if (NULL != event) {
+			event->value = position;
+			__stt_post_event(client, event);
+		}
+	}
 
 	return 0;
 }
@@ -879,15 +1542,18 @@ int __stt_cb_set_state(int uid, int state)
 
 	stt_state_e state_from_daemon = (stt_state_e)state;
 
+	/* queued request is started */
+	client->queued = false;
+
 	if (client->current_state == state_from_daemon) {
 		SLOG(LOG_DEBUG, TAG_STTC, "Current state has already been %d", client->current_state);
 		return 0;
 	}
 
 	client->before_state = client->current_state;
-	client->current_state = state_from_daemon;
+	client->current_state = (STT_STATE_READY == state_from_daemon) ? __stt_get_idle_state(client) : state_from_daemon;
 
-	ecore_timer_add(0, __stt_notify_state_changed, client->stt);
+	__stt_post_state_changed(client);
 	return 0;
 }
 
@@ -1084,99 +1750,75 @@ int stt_unset_error_cb(stt_h stt)
 	return 0;
 }
 
-static bool __stt_is_alive()
+int stt_set_queue_position_cb(stt_h stt, stt_queue_position_cb callback, void* user_data)
 {
-	FILE *fp = NULL;
-	char buff[256] = {'\0',};
-	char cmd[256] = {'\0',};
+	if (NULL == stt || NULL == callback)
+		return STT_ERROR_INVALID_PARAMETER;
 
-	memset(buff, '\0', 256);
-	memset(cmd, '\0', 256);
+	stt_client_s* client = stt_client_get(stt);
 
-	fp = popen("ps", "r");
-	if (NULL == fp) {
-		SLOG(LOG_DEBUG, TAG_STTC, "[STT SETTING ERROR] popen error \n");
-		return FALSE;
+	/* check handle */
+	if (NULL == client) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] A handle is not available");
+		return STT_ERROR_INVALID_PARAMETER;
 	}
 
-	while (fgets(buff, 255, fp)) {
-		strcpy(cmd, buff + 26);
-
-		if( 0 == strncmp(cmd, "[stt-daemon]", strlen("[stt-daemon]")) ||
-		0 == strncmp(cmd, "stt-daemon", strlen("stt-daemon")) ||
-		0 == strncmp(cmd, "/usr/bin/stt-daemon", strlen("/usr/bin/stt-daemon"))) {
-			SLOG(LOG_DEBUG, TAG_STTC, "stt-daemon is ALIVE !! \n");
-			fclose(fp);
-			return TRUE;
-		}
+	if (STT_STATE_CREATED != client->current_state) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Current state is not 'ready'."); 
+		return STT_ERROR_INVALID_STATE;
 	}
 
-	fclose(fp);
+	client->queue_position_cb = callback;
+	client->queue_position_user_data = user_data;
 
-	SLOG(LOG_DEBUG, TAG_STTC, "THERE IS NO stt-daemon !! \n");
-
-	return FALSE;
+	return 0;
 }
 
-
-static void __my_sig_child(int signo, siginfo_t *info, void *data)
+int stt_unset_queue_position_cb(stt_h stt)
 {
-	int status;
-	pid_t child_pid, child_pgid;
+	if (NULL == stt)
+		return STT_ERROR_INVALID_PARAMETER;
+
+	stt_client_s* client = stt_client_get(stt);
 
-	child_pgid = getpgid(info->si_pid);
-	SLOG(LOG_DEBUG, TAG_STTC, "Signal handler: dead pid = %d, pgid = %d\n", info->si_pid, child_pgid);
+	/* check handle */
+	if (NULL == client) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] A handle is not available");
+		return STT_ERROR_INVALID_PARAMETER;
+	}
 
-	while((child_pid = waitpid(-1, &status, WNOHANG)) > 0) {
-		if(child_pid == child_pgid)
-			killpg(child_pgid, SIGKILL);
+	if (STT_STATE_CREATED != client->current_state) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Current state is not 'ready'."); 
+		return STT_ERROR_INVALID_STATE;
 	}
 
-	return;
-}
+	client->queue_position_cb = NULL;
+	client->queue_position_user_data = NULL;
 
+	return 0;
+}
 
-static int __check_stt_daemon()
+int stt_get_event_fd(int* fd)
 {
-	if( TRUE == __stt_is_alive() )
-		return 0;
-	
-	/* fork-exec stt-daemon */
-	int pid, i;
-	struct sigaction act, dummy;
-
-	act.sa_handler = NULL;
-	act.sa_sigaction = __my_sig_child;
-	sigemptyset(&act.sa_mask);
-	act.sa_flags = SA_NOCLDSTOP | SA_SIGINFO;
-		
-	if(sigaction(SIGCHLD, &act, &dummy) < 0) {
-		SLOG(LOG_DEBUG, TAG_STTC, "%s\n", "Cannot make a signal handler\n");
-		return -1;
+	if (NULL == fd) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Input parameter is NULL");
+		return STT_ERROR_INVALID_PARAMETER;
 	}
 
-	pid = fork();
-
-	switch(pid) {
-	case -1:
-		SLOG(LOG_DEBUG, TAG_STTC, "[STT ERROR] fail to create STT-DAEMON \n");
-		break;
-
-	case 0:
-		setsid();
-		for (i = 0;i < _NSIG;i++)
-			signal(i, SIG_DFL);
-
-		execl("/usr/bin/stt-daemon", "/usr/bin/stt-daemon", NULL);
-		break;
-
-	default:
-		break;
+	/* connection of existing handle is on Ecore main loop */
+	int ret = stt_loop_get_fd(fd);
+	if (STT_ERROR_INVALID_STATE == ret) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Handle already exists with Ecore main loop");
+		return ret;
+	} else if (0 != ret) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to get event fd");
+		return STT_ERROR_OPERATION_FAILED;
 	}
 
-	return 0;
+	return STT_ERROR_NONE;
 }
 
-
-
-
+int stt_dispatch()
+{
+	return stt_loop_dispatch();
+}
@@ -45,7 +45,8 @@ typedef enum {
 	STT_ERROR_INVALID_LANGUAGE	= -0x0100032,	/**< Invalid language */
 	STT_ERROR_ENGINE_NOT_FOUND	= -0x0100033,	/**< No available engine  */	
 	STT_ERROR_OPERATION_FAILED	= -0x0100034,	/**< Operation failed  */
-	STT_ERROR_NOT_SUPPORTED_FEATURE	= -0x0100035	/**< Not supported feature of current engine */
+	STT_ERROR_NOT_SUPPORTED_FEATURE	= -0x0100035,	/**< Not supported feature of current engine */
+	STT_ERROR_OUT_OF_HANDLE		= -0x0100036	/**< No more handle can be created */
 }stt_error_e;
 
 /** 
@@ -315,6 +316,36 @@ typedef void (*stt_state_changed_cb)(stt_h stt, stt_state_e previous, stt_state_
 */
 typedef void (*stt_error_cb)(stt_h stt, stt_error_e reason, void *user_data);
 
+/**
+* @brief Called when the position of start request in the daemon queue is changed. 
+*
+* @param[in] stt The handle for STT
+* @param[in] position The position in queue (1 means next to start)
+* @param[in] user_data The user data passed from the callback registration function
+*
+* @pre stt_start() is queued because the daemon is busy and queue option is set by stt_set_queue_option().
+*
+* @see stt_set_queue_position_cb()
+* @see stt_unset_queue_position_cb()
+*/
+typedef void (*stt_queue_position_cb)(stt_h stt, int position, void* user_data);
+
+/**
+* @brief Called when the daemon replies to an asynchronous request. 
+*
+* @param[in] stt The handle for STT
+* @param[in] result The result of request (e.g. #STT_ERROR_NONE, #STT_ERROR_TIMED_OUT)
+* @param[in] user_data The user data passed from the request function
+*
+* @pre stt_start_async(), stt_stop_async() or stt_cancel_async() will invoke this callback.
+* @post The state is already changed when this callback is called, so the next request can be made in this callback.
+*
+* @see stt_start_async()
+* @see stt_stop_async()
+* @see stt_cancel_async()
+*/
+typedef void (*stt_request_completed_cb)(stt_h stt, stt_error_e result, void* user_data);
+
 /**
 * @brief Called to retrieve the supported languages. 
 *
@@ -341,6 +372,9 @@ typedef bool(*stt_supported_language_cb)(stt_h stt, const char* language, void*
 * @retval #STT_ERROR_NONE Successful
 * @retval #STT_ERROR_INVALID_PARAMETER Invalid parameter
 * @retval #STT_ERROR_OPERATION_FAILED Operation failure
+* @retval #STT_ERROR_OUT_OF_HANDLE Too many handles are created
+*
+* @remark Handles should be created, used and destroyed in the thread which runs main loop.
 *
 * @post If this function is called, the STT state will be #STT_STATE_CREATED.
 *
@@ -364,12 +398,16 @@ int stt_destroy(stt_h stt);
 /**
 * @brief Connects the daemon. 
 *
+* @remark The daemon is started by D-Bus activation if it is not running. \n
+* If the daemon is not found in time, stt_error_cb() is called with #STT_ERROR_TIMED_OUT.
+*
 * @param[in] stt The handle for STT
 *
 * @return 0 on success, otherwise a negative error value
 * @retval #STT_ERROR_NONE Successful
 * @retval #STT_ERROR_INVALID_PARAMETER Invalid parameter
 * @retval #STT_ERROR_INVALID_STATE Invalid state
+* @retval #STT_ERROR_OPERATION_FAILED Operation failure
 *
 * @pre The state should be #STT_STATE_CREATED.
 * @post If this function is called, the STT state will be #STT_STATE_READY.
@@ -522,6 +560,50 @@ int stt_set_punctuation_override(stt_h stt, stt_option_punctuation_e type);
 */
 int stt_set_silence_detection(stt_h stt, stt_option_silence_detection_e type);
 
+/**
+* @brief Sets option to wait in the daemon queue when recorder is busy.
+*
+* @remark If wait time is 0, stt_start() returns #STT_ERROR_RECORDER_BUSY immediately when recorder is busy. \n
+* Otherwise the start request waits in queue and recording starts when recorder is free. \n
+* If the request is not started in wait time, stt_error_cb() is called with #STT_ERROR_RECORDER_BUSY.
+*
+* @param[in] stt The handle for STT
+* @param[in] priority The priority of start request. The higher priority is started first.
+* @param[in] wait_timeout The maximum wait time (msec)
+*
+* @return 0 on success, otherwise a negative error value
+* @retval #STT_ERROR_NONE Successful
+* @retval #STT_ERROR_INVALID_PARAMETER Invalid parameter
+* @retval #STT_ERROR_INVALID_STATE Invalid state
+*
+* @pre The state should be #STT_STATE_READY.
+*
+* @see stt_start()
+* @see stt_set_queue_position_cb()
+*/
+int stt_set_queue_option(stt_h stt, int priority, int wait_timeout);
+
+/**
+* @brief Sets minimum interval of partial results.
+*
+* @remark The daemon sends the latest partial result at most once per interval. 
+* Partial results between them are skipped. If interval is 0, every partial result is sent.
+*
+* @param[in] stt The handle for STT
+* @param[in] interval The minimum interval (msec)
+*
+* @return 0 on success, otherwise a negative error value
+* @retval #STT_ERROR_NONE Successful
+* @retval #STT_ERROR_INVALID_PARAMETER Invalid parameter
+* @retval #STT_ERROR_INVALID_STATE Invalid state
+*
+* @pre The state should be #STT_STATE_READY.
+*
+* @see stt_partial_result_cb()
+* @see stt_start()
+*/
+int stt_set_partial_result_interval(stt_h stt, int interval);
+
 /**
 * @brief Starts recording and recognition.
 *
@@ -542,7 +624,9 @@ int stt_set_silence_detection(stt_h stt, stt_option_silence_detection_e type);
 *
 * @pre The state should be #STT_STATE_READY.
 * @post It will invoke stt_state_changed_cb(), if you register a callback with stt_state_changed_cb(). \n
-* If this function succeeds, the STT state will be #STT_STATE_RECORDING.
+* If this function succeeds, the STT state will be #STT_STATE_RECORDING. \n
+* If the request is queued by stt_set_queue_option(), the state remains #STT_STATE_READY \n
+* and will be #STT_STATE_RECORDING when the request is started.
 *
 * @see stt_stop()
 * @see stt_cancel()
@@ -551,6 +635,63 @@ int stt_set_silence_detection(stt_h stt, stt_option_silence_detection_e type);
 */
 int stt_start(stt_h stt, const char* language, const char* type);
 
+/**
+* @brief Recognizes one utterance without preparing.
+*
+* @remark This function registers the handle in the daemon and starts recording with one request. \n
+* Recording is stopped by silence detection, or it can be stopped by stt_stop(). \n
+* When the result is delivered or the session is canceled, the handle is unregistered from the daemon. \n
+* If the engine is not loaded yet, this function returns after the daemon loads it. \n
+* Callbacks should be set before this function is called.
+*
+* @param[in] stt The handle for STT
+* @param[in] language The language selected from stt_foreach_supported_languages()
+* @param[in] type The type for recognition (e.g. #STT_RECOGNITION_TYPE_FREE, #STT_RECOGNITION_TYPE_WEB_SEARCH)
+*
+* @return 0 on success, otherwise a negative error value
+* @retval #STT_ERROR_NONE Successful
+* @retval #STT_ERROR_INVALID_PARAMETER Invalid parameter.
+* @retval #STT_ERROR_INVALID_STATE Invalid state
+* @retval #STT_ERROR_OPERATION_FAILED Operation failure
+* @retval #STT_ERROR_RECORDER_BUSY Recorder busy
+* @retval #STT_ERROR_TIMED_OUT No answer from the daemon
+*
+* @pre The state should be #STT_STATE_CREATED.
+* @post It will invoke stt_state_changed_cb(), if you register a callback with stt_state_changed_cb(). \n
+* If this function succeeds, the STT state will be #STT_STATE_RECORDING. \n
+* After stt_result_cb() is called or the session is canceled, the STT state will be #STT_STATE_CREATED.
+*
+* @see stt_result_cb()
+* @see stt_stop()
+* @see stt_cancel()
+*/
+int stt_recognize_once(stt_h stt, const char* language, const char* type);
+
+/**
+* @brief Prepares recording and recognition ahead of stt_start().
+*
+* @remark This function tells the daemon that stt_start() will be called soon. \n
+* The daemon prepares the microphone and starts the engine, and holds them for @a hold_ms. \n
+* If stt_start() is called with same language and type in the time, it only starts recording. \n
+* This function does not wait for the daemon, and prewarm is dropped if the engine is busy.
+*
+* @param[in] stt The handle for STT
+* @param[in] language The language selected from stt_foreach_supported_languages()
+* @param[in] type The type for recognition (e.g. #STT_RECOGNITION_TYPE_FREE, #STT_RECOGNITION_TYPE_WEB_SEARCH)
+* @param[in] hold_ms The time in milliseconds to hold prepared resources. 0 means default time of daemon.
+*
+* @return 0 on success, otherwise a negative error value
+* @retval #STT_ERROR_NONE Successful
+* @retval #STT_ERROR_INVALID_PARAMETER Invalid parameter.
+* @retval #STT_ERROR_INVALID_STATE Invalid state
+* @retval #STT_ERROR_OPERATION_FAILED Operation failure
+*
+* @pre The state should be #STT_STATE_READY.
+*
+* @see stt_start()
+*/
+int stt_prewarm(stt_h stt, const char* language, const char* type, int hold_ms);
+
 /**
 * @brief Finishes recording and starts recognition processing in engine.
 *
@@ -601,6 +742,103 @@ int stt_stop(stt_h stt);
 */
 int stt_cancel(stt_h stt);
 
+/**
+* @brief Starts recording and recognition without waiting for the reply of daemon.
+*
+* @remark The request is sent and this function returns at once. \n
+* The reply of daemon is delivered by stt_request_completed_cb() in main loop. \n
+* Only one request can be in progress for a handle.
+*
+* @param[in] stt The handle for STT
+* @param[in] language The language selected from stt_foreach_supported_languages()
+* @param[in] type The type for recognition (e.g. #STT_RECOGNITION_TYPE_FREE, #STT_RECOGNITION_TYPE_WEB_SEARCH)
+* @param[in] callback The callback function called when the request is completed. It can be NULL
+* @param[in] user_data The user data to be passed to the callback function
+*
+* @return 0 on success, otherwise a negative error value
+* @retval #STT_ERROR_NONE Successful
+* @retval #STT_ERROR_OUT_OF_MEMORY Not enough memory
+* @retval #STT_ERROR_INVALID_PARAMETER Invalid parameter
+* @retval #STT_ERROR_INVALID_STATE Invalid state or other request is in progress
+* @retval #STT_ERROR_OPERATION_FAILED Operation failure
+*
+* @pre The state should be #STT_STATE_READY.
+* @post If the request succeeds, the STT state will be #STT_STATE_RECORDING before stt_request_completed_cb() is called.
+*
+* @see stt_start()
+* @see stt_cancel_request()
+* @see stt_request_completed_cb()
+*/
+int stt_start_async(stt_h stt, const char* language, const char* type, stt_request_completed_cb callback, void* user_data);
+
+/**
+* @brief Finishes recording without waiting for the reply of daemon.
+*
+* @param[in] stt The handle for STT
+* @param[in] callback The callback function called when the request is completed. It can be NULL
+* @param[in] user_data The user data to be passed to the callback function
+*
+* @return 0 on success, otherwise a negative error value
+* @retval #STT_ERROR_NONE Successful
+* @retval #STT_ERROR_OUT_OF_MEMORY Not enough memory
+* @retval #STT_ERROR_INVALID_PARAMETER Invalid parameter
+* @retval #STT_ERROR_INVALID_STATE Invalid state or other request is in progress
+* @retval #STT_ERROR_OPERATION_FAILED Operation failure
+*
+* @pre The state should be #STT_STATE_RECORDING.
+* @post If the request succeeds, the STT state will be #STT_STATE_PROCESSING before stt_request_completed_cb() is called.
+*
+* @see stt_stop()
+* @see stt_cancel_request()
+* @see stt_request_completed_cb()
+*/
+int stt_stop_async(stt_h stt, stt_request_completed_cb callback, void* user_data);
+
+/**
+* @brief Cancels processing recognition and recording without waiting for the reply of daemon.
+*
+* @param[in] stt The handle for STT
+* @param[in] callback The callback function called when the request is completed. It can be NULL
+* @param[in] user_data The user data to be passed to the callback function
+*
+* @return 0 on success, otherwise a negative error value
+* @retval #STT_ERROR_NONE Successful
+* @retval #STT_ERROR_OUT_OF_MEMORY Not enough memory
+* @retval #STT_ERROR_INVALID_PARAMETER Invalid parameter
+* @retval #STT_ERROR_INVALID_STATE Invalid state or other request is in progress
+* @retval #STT_ERROR_OPERATION_FAILED Operation failure
+*
+* @pre The state should be #STT_STATE_RECORDING or #STT_STATE_PROCESSING.
+* @post If the request succeeds, the STT state will be #STT_STATE_READY before stt_request_completed_cb() is called.
+*
+* @see stt_cancel()
+* @see stt_cancel_request()
+* @see stt_request_completed_cb()
+*/
+int stt_cancel_async(stt_h stt, stt_request_completed_cb callback, void* user_data);
+
+/**
+* @brief Drops the asynchronous request in progress.
+*
+* @remark stt_request_completed_cb() of the dropped request is not called. \n
+* Because the daemon may have handled the request already, the session is canceled \n
+* and the handle goes back to #STT_STATE_READY.
+*
+* @param[in] stt The handle for STT
+*
+* @return 0 on success, otherwise a negative error value
+* @retval #STT_ERROR_NONE Successful
+* @retval #STT_ERROR_INVALID_PARAMETER Invalid parameter
+* @retval #STT_ERROR_INVALID_STATE No request is in progress
+*
+* @post It will invoke stt_state_changed_cb(), if the state is changed.
+*
+* @see stt_start_async()
+* @see stt_stop_async()
+* @see stt_cancel_async()
+*/
+int stt_cancel_request(stt_h stt);
+
 /**
 * @brief Gets the microphone volume during recording.
 *	
@@ -759,6 +997,76 @@ int stt_set_error_cb(stt_h stt, stt_error_cb callback, void* user_data);
 */
 int stt_unset_error_cb(stt_h stt);
 
+/**
+* @brief Registers a callback function to be called when the position in the daemon queue is changed.
+*
+* @param[in] stt The handle for STT
+* @param[in] callback The callback function to register
+* @param[in] user_data The user data to be passed to the callback function
+*
+* @return 0 on success, otherwise a negative error value
+* @retval #STT_ERROR_NONE Successful
+* @retval #STT_ERROR_INVALID_PARAMETER Invalid parameter
+* @retval #STT_ERROR_INVALID_STATE Invalid state
+*
+* @pre The state should be #STT_STATE_CREATED.
+*
+* @see stt_queue_position_cb()
+* @see stt_unset_queue_position_cb()
+*/
+int stt_set_queue_position_cb(stt_h stt, stt_queue_position_cb callback, void* user_data);
+
+/**
+* @brief Unregisters the callback function.
+*
+* @param[in] stt The handle for STT
+*
+* @return 0 on success, otherwise a negative error value
+* @retval #STT_ERROR_NONE Successful
+* @retval #STT_ERROR_INVALID_PARAMETER Invalid parameter
+* @retval #STT_ERROR_INVALID_STATE Invalid state
+*
+* @pre The state should be #STT_STATE_CREATED.
+*
+* @see stt_set_queue_position_cb()
+*/
+int stt_unset_queue_position_cb(stt_h stt);
+
+/**
+* @brief Gets a file descriptor to drive STT with a main loop other than Ecore.
+* @details Once this function is called, STT does not use Ecore main loop. \n
+*	The descriptor becomes readable when STT has work to do, then the application should call stt_dispatch(). \n
+*	It can be watched with GLib, epoll, libuv or any other poll based loop.
+*
+* @remark This function should be called before the first stt_create() or after all handles are destroyed. \n
+*	Callback functions are invoked in stt_dispatch() with the same arguments as before. \n
+*	The descriptor is owned by STT, so the application should not close it.
+*
+* @param[out] fd The file descriptor to watch for reading
+*
+* @return 0 on success, otherwise a negative error value
+* @retval #STT_ERROR_NONE Successful
+* @retval #STT_ERROR_INVALID_PARAMETER Invalid parameter
+* @retval #STT_ERROR_INVALID_STATE A handle already exists with Ecore main loop
+* @retval #STT_ERROR_OPERATION_FAILED Operation failure
+*
+* @see stt_dispatch()
+*/
+int stt_get_event_fd(int* fd);
+
+/**
+* @brief Handles messages of daemon, expired requests and pending callbacks once, without blocking.
+*
+* @remark The application should call this function when the descriptor from stt_get_event_fd() is readable.
+*
+* @return 0 on success, otherwise a negative error value
+* @retval #STT_ERROR_NONE Successful
+* @retval #STT_ERROR_INVALID_STATE stt_get_event_fd() is not called
+*
+* @see stt_get_event_fd()
+*/
+int stt_dispatch();
+
 
 #ifdef __cplusplus
 }
@@ -12,29 +12,70 @@
 */
 
 
+#include <limits.h>
+
 #include "stt_client.h"
 
 #define MUTEX_TIME 3
 
-/* Max number of handle */
-static const int g_max_handle = 999;
-/* allocated handle */
+/* Max number of handle. uid is pid * 1000 + slot, so slot should be smaller than 1000 */
+#define STT_CLIENT_MAX_HANDLE	999
+
+/* handle is generation of slot and slot index */
+#define STT_CLIENT_SLOT_BITS	10
+#define STT_CLIENT_SLOT_MASK	((1 << STT_CLIENT_SLOT_BITS) - 1)
+
+typedef struct {
+	stt_client_s*	client;
+	unsigned int	generation;	/* increased whenever slot is reused, to detect stale handle */
+} stt_client_slot_s;
+
+/* slot 0 is not used, so handle and uid are never 0 */
+static stt_client_slot_s g_client_table[STT_CLIENT_MAX_HANDLE + 1];
+/* last allocated slot. Slots are reused round robin, so uid of destroyed handle is not reused soon */
 static int g_allocated_handle = 0;
-/* client list */
+/* client list in order of creation */
 static GList *g_client_list = NULL;
+static int g_client_count = 0;
+/* handles which have events not delivered. Head is served first and goes to tail, so handles take turns */
+static GQueue g_event_client_queue = G_QUEUE_INIT;
+
+/*
+* Table is not locked. Handles are created, looked up and destroyed only in the thread
+* running main loop, where dbus handlers and callbacks run, so returned client is valid
+* until stt_client_destroy() in that thread.
+*/
 
 
 /* private functions */
-static int __client_generate_uid(int pid)
+static int __client_alloc_slot()
 {
-	g_allocated_handle++;
+	int i;
+	for (i = 0; i < STT_CLIENT_MAX_HANDLE; i++) {
+		g_allocated_handle++;
+
+		if (g_allocated_handle > STT_CLIENT_MAX_HANDLE) {
+			g_allocated_handle = 1;
+		}
 
-	if (g_allocated_handle > g_max_handle) {
-		g_allocated_handle = 1;
+		if (NULL == g_client_table[g_allocated_handle].client)
+			return g_allocated_handle;
 	}
 
-	/* generate uid, handle number should be smaller than 1000 */
-	return pid * 1000 + g_allocated_handle;
+	return -1;
+}
+
+static stt_client_s* __client_get_by_handle(int handle)
+{
+	int slot = handle & STT_CLIENT_SLOT_MASK;
+
+	if (0 >= slot || STT_CLIENT_MAX_HANDLE < slot)
+		return NULL;
+
+	if (g_client_table[slot].generation != ((unsigned int)handle >> STT_CLIENT_SLOT_BITS))
+		return NULL;
+
+	return g_client_table[slot].client;
 }
 
 int stt_client_new(stt_h* stt)
@@ -43,13 +84,24 @@ int stt_client_new(stt_h* stt)
 
 	client = (stt_client_s*)g_malloc0 (sizeof(stt_client_s));
 
-	stt_h temp = (stt_h)g_malloc0(sizeof(stt_h));
-	temp->handle = __client_generate_uid(getpid()); 
+	stt_h temp = (stt_h)g_malloc0(sizeof(struct stt_s));
+
+	int slot = __client_alloc_slot();
+	if (0 > slot) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Handle table is full");
+		g_free(temp);
+		g_free(client);
+		return STT_ERROR_OUT_OF_HANDLE;
+	}
+
+	/* generation wraps in bits left by slot index */
+	g_client_table[slot].generation = (g_client_table[slot].generation + 1) & ((unsigned int)INT_MAX >> STT_CLIENT_SLOT_BITS);
+	temp->handle = (int)((g_client_table[slot].generation << STT_CLIENT_SLOT_BITS) | slot);
 
 	/* initialize client data */
 	client->stt = temp;
 	client->pid = getpid(); 
-	client->uid = temp->handle;
+	client->uid = client->pid * 1000 + slot;
 	
 	client->result_cb = NULL;
 	client->result_user_data = NULL;
@@ -59,26 +111,43 @@ int stt_client_new(stt_h* stt)
 	client->state_changed_user_data = NULL;
 	client->error_cb = NULL;
 	client->error_user_data = NULL;
+	client->queue_position_cb = NULL;
+	client->queue_position_user_data = NULL;
 
 	client->silence_supported = false;
 	client->profanity_supported = false;
 	client->punctuation_supported = false;
 
+	memset(&client->capability, 0, sizeof(stt_capability_s));
+
 	client->profanity = STT_OPTION_PROFANITY_AUTO;	
 	client->punctuation = STT_OPTION_PUNCTUATION_AUTO;
 	client->silence = STT_OPTION_SILENCE_DETECTION_AUTO;
 
-	client->type = NULL;
-	client->data_list = NULL;
-	client->data_count = 0;
-	client->msg = NULL;
+	client->priority = 0;
+	client->wait_timeout = 0;
+	client->partial_interval = 0;
+
+	client->partial_text = NULL;
+
+	client->event_head = NULL;
+	client->event_tail = NULL;
 
 	client->before_state = STT_STATE_CREATED;
 	client->current_state = STT_STATE_CREATED; 
 
+	client->queued = false;
+	client->once = false;
+
+	client->request = NULL;
+	client->request_cb = NULL;
+	client->request_user_data = NULL;
+
 	client->cb_ref_count = 0;
 
+	g_client_table[slot].client = client;
 	g_client_list = g_list_append(g_client_list, client);
+	g_client_count++;
 
 	*stt = temp;
 
@@ -92,32 +161,29 @@ int stt_client_destroy(stt_h stt)
 		return 0;
 	}	
 
-	GList *iter = NULL;
-	stt_client_s *data = NULL;
-
-	/* if list have item */
-	if (g_list_length(g_client_list) > 0) {
-		/* Get a first item */
-		iter = g_list_first(g_client_list);
-
-		while (NULL != iter) {
-			data = iter->data;
-			if (stt->handle == data->stt->handle) {
-				g_client_list = g_list_remove_link(g_client_list, iter);
-
-				while (0 != data->cb_ref_count)
-				{
-					/* wait for release callback function */
-				}
-				free(data);
-				free(stt);
-
-				return 0;
-			}
+	stt_client_s *data = __client_get_by_handle(stt->handle);
+	if (NULL != data) {
+		g_client_table[stt->handle & STT_CLIENT_SLOT_MASK].client = NULL;
+		g_client_list = g_list_remove(g_client_list, data);
+		g_client_count--;
+	}
 
-			/* Next item */
-			iter = g_list_next(iter);
+	if (NULL != data) {
+		while (0 != data->cb_ref_count)
+		{
+			/* wait for release callback function */
 		}
+		if (NULL != data->partial_text)
+			free(data->partial_text);
+		/* events not delivered yet */
+		stt_event_s* event = NULL;
+		while (NULL != (event = stt_client_pop_event(data)))
+			stt_client_free_event(event);
+		stt_client_free_capability(&data->capability);
+		free(data);
+		free(stt);
+
+		return 0;
 	}
 
 	SLOG(LOG_ERROR, TAG_STTC, "[ERROR] client Not founded");
@@ -133,23 +199,10 @@ stt_client_s* stt_client_get(stt_h stt)
 		return NULL;
 	}
 
-	GList *iter = NULL;
-	stt_client_s *data = NULL;
-
-	if (g_list_length(g_client_list) > 0) {
-		/* Get a first item */
-		iter = g_list_first(g_client_list);
-
-		while (NULL != iter) {
-			data = iter->data;
-
-			if (stt->handle == data->stt->handle) 
-				return data;
+	stt_client_s *data = __client_get_by_handle(stt->handle);
 
-			/* Next item */
-			iter = g_list_next(iter);
-		}
-	}
+	if (NULL != data)
+		return data;
 
 	SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to get client by stt");
 
@@ -163,22 +216,15 @@ stt_client_s* stt_client_get_by_uid(const int uid)
 		return NULL;
 	}
 
-	GList *iter = NULL;
+	/* slot is lower part of uid and owner is checked with full uid */
+	int slot = uid % 1000;
 	stt_client_s *data = NULL;
 
-	if (g_list_length(g_client_list) > 0) {
-		/* Get a first item */
-		iter = g_list_first(g_client_list);
-
-		while (NULL != iter) {
-			data = iter->data;
-			if (uid == data->uid) {
-				return data;
-			}
+	if (0 < slot && STT_CLIENT_MAX_HANDLE >= slot) {
+		data = g_client_table[slot].client;
 
-			/* Next item */
-			iter = g_list_next(iter);
-		}
+		if (NULL != data && uid == data->uid)
+			return data;
 	}
 
 	SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to get client by uid");
@@ -188,7 +234,7 @@ stt_client_s* stt_client_get_by_uid(const int uid)
 
 int stt_client_get_size()
 {
-	return g_list_length(g_client_list);
+	return g_client_count;
 }
 
 int stt_client_use_callback(stt_client_s* client)
@@ -219,4 +265,102 @@ int stt_client_set_option_supported(stt_h stt, bool silence, bool profanity, boo
 	return 0;
 }
 
+void stt_client_free_capability(stt_capability_s* capability)
+{
+	if (NULL == capability)
+		return;
 
+	if (NULL != capability->default_lang)
+		free(capability->default_lang);
+
+	GList* iter = g_list_first(capability->lang_list);
+	while (NULL != iter) {
+		if (NULL != iter->data)
+			free(iter->data);
+		iter = g_list_next(iter);
+	}
+	g_list_free(capability->lang_list);
+
+	memset(capability, 0, sizeof(stt_capability_s));
+}
+
+int stt_client_set_capability(stt_h stt, stt_capability_s* capability)
+{
+	stt_client_s* client = stt_client_get(stt);
+	
+	/* check handle */
+	if (NULL == client) 
+		return STT_ERROR_INVALID_PARAMETER;
+
+	stt_client_free_capability(&client->capability);
+
+	if (NULL != capability) {
+		client->capability = *capability;
+		memset(capability, 0, sizeof(stt_capability_s));
+	}
+
+	return 0;
+}
+
+GList* stt_client_get_client_list()
+{
+	return g_client_list;
+}
+
+void stt_client_push_event(stt_client_s* client, stt_event_s* event)
+{
+	event->next = NULL;
+
+	if (NULL == client->event_head)
+		g_queue_push_tail(&g_event_client_queue, client);
+
+	if (NULL == client->event_tail)
+		client->event_head = event;
+	else
+		client->event_tail->next = event;
+
+	client->event_tail = event;
+}
+
+stt_event_s* stt_client_pop_event(stt_client_s* client)
+{
+	stt_event_s* event = client->event_head;
+	if (NULL == event)
+		return NULL;
+
+	client->event_head = event->next;
+	if (NULL == client->event_head)
+		client->event_tail = NULL;
+
+	if (client == g_queue_peek_head(&g_event_client_queue)) {
+		/* round robin : other handles are served before next event of this handle */
+		g_queue_pop_head(&g_event_client_queue);
+		if (NULL != client->event_head)
+			g_queue_push_tail(&g_event_client_queue, client);
+	} else if (NULL == client->event_head) {
+		g_queue_remove(&g_event_client_queue, client);
+	}
+
+	event->next = NULL;
+	return event;
+}
+
+stt_client_s* stt_client_get_with_event()
+{
+	return (stt_client_s*)g_queue_peek_head(&g_event_client_queue);
+}
+
+void stt_client_free_event(stt_event_s* event)
+{
+	if (NULL == event)
+		return;
+
+	/* result is single allocation */
+	if (NULL != event->result)
+		free(event->result);
+
+	if (NULL != event->text)
+		free(event->text);
+
+	free(event);
+}
@@ -18,12 +18,34 @@
 #include <pthread.h>
 #include "stt.h"
 #include "stt_main.h"
+#include "stt_dbus.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 
+typedef enum {
+	STT_EVENT_STATE_CHANGED = 0,
+	STT_EVENT_RESULT,
+	STT_EVENT_PARTIAL_RESULT,
+	STT_EVENT_ERROR,
+	STT_EVENT_QUEUE_POSITION
+} stt_event_type_e;
+
+/* notification waiting for delivery in main loop. Event owns its payload */
+typedef struct stt_event_s {
+	stt_event_type_e	type;
+
+	stt_state_e	before_state;
+	stt_state_e	current_state;
+	int		value;		/* error reason or queue position */
+	stt_result_s*	result;
+	char*		text;		/* partial result */
+
+	struct stt_event_s*	next;
+} stt_event_s;
+
 typedef struct {
 	/* base info */
 	stt_h	stt;
@@ -38,32 +60,52 @@ typedef struct {
 	void*			state_changed_user_data;
 	stt_error_cb		error_cb;
 	void*			error_user_data;
+	stt_queue_position_cb	queue_position_cb;
+	void*			queue_position_user_data;
 
 	/* option */
 	bool	silence_supported;
 	bool	profanity_supported;
 	bool	punctuation_supported;
 
+	/* capability of engine, so that queries need no round trip */
+	stt_capability_s	capability;
+
 	stt_option_profanity_e		profanity;	
 	stt_option_punctuation_e	punctuation;
 	stt_option_silence_detection_e	silence;
 
+	/* queue option */
+	int	priority;
+	int	wait_timeout;
+
+	/* msec between partial results */
+	int	partial_interval;
+
 	/* state */
 	stt_state_e	before_state;
 	stt_state_e	current_state;
 
+	/* start request is waiting in daemon queue */
+	bool	queued;
+
+	/* session is started by stt_recognize_once() and daemon forgets uid at its end */
+	bool	once;
+
+	/* asynchronous request in progress */
+	stt_dbus_call_h		request;
+	stt_request_completed_cb	request_cb;
+	void*			request_user_data;
+
 	/* mutex */
 	int		cb_ref_count;
 
 	/* result data */
-	char*	partial_result;
-	char*	type;
-	char**	data_list;
-	int	data_count;
-	char*	msg;
-
-	/* error data */
-	int	reason;
+	char*	partial_text;	/* full text rebuilt from delta of daemon */
+
+	/* events in order of arrival */
+	stt_event_s*	event_head;
+	stt_event_s*	event_tail;
 }stt_client_s;
 
 int stt_client_new(stt_h* stt);
@@ -82,6 +124,23 @@ int stt_client_not_use_callback(stt_client_s* client);
 
 int stt_client_set_option_supported(stt_h stt, bool silence, bool profanity, bool punctuation);
 
+/** Take contents of capability. Cache is invalidated if capability is NULL */
+int stt_client_set_capability(stt_h stt, stt_capability_s* capability);
+
+void stt_client_free_capability(stt_capability_s* capability);
+
+GList* stt_client_get_client_list();
+
+/* client takes event and frees it with stt_client_free_event() after delivery */
+void stt_client_push_event(stt_client_s* client, stt_event_s* event);
+
+stt_event_s* stt_client_pop_event(stt_client_s* client);
+
+/** Handle whose turn is next among handles with pending events, or NULL */
+stt_client_s* stt_client_get_with_event();
+
+void stt_client_free_event(stt_event_s* event);
+
 #ifdef __cplusplus
 }
 #endif
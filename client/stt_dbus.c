@@ -12,47 +12,275 @@
 */
 
 
+/* struct ucred of SO_PEERCRED */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include "stt_main.h"
 #include "stt_dbus.h"
 #include "stt_defs.h"
 
-#include <Ecore.h>
+#include <time.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
 #include "stt_client.h"
+#include "stt_loop.h"
 
 static int g_waiting_time = 1500;
 static int g_waiting_start_time = 2000;
 
-static Ecore_Fd_Handler* g_fd_handler = NULL;
+static stt_loop_source_h g_fd_handler = NULL;
 
 static DBusConnection* g_conn = NULL;
 
+/* private connection to daemon. Requests and results bypass the bus daemon */
+static stt_loop_source_h g_peer_fd_handler = NULL;
+
+static DBusConnection* g_peer_conn = NULL;
+
 
 extern int __stt_cb_error(int uid, int reason);
 
-extern int __stt_cb_result(int uid, const char* type, const char** data, int data_count, const char* msg);
+extern int __stt_cb_result(int uid, stt_result_s* result);
 	
-extern int __stt_cb_partial_result(int uid, const char* data);
+extern int __stt_cb_partial_result(int uid, int keep, const char* suffix);
 
 extern int __stt_cb_set_state(int uid, int state);
 
-static Eina_Bool listener_event_callback(void* data, Ecore_Fd_Handler *fd_handler)
+extern int __stt_cb_engine_ready(int uid, int result, bool silence, bool profanity, bool punctuation, stt_capability_s* capability);
+
+extern int __stt_cb_engine_changed(int uid, bool silence, bool profanity, bool punctuation, stt_capability_s* capability);
+
+extern int __stt_cb_queue_position(int uid, int position);
+
+void __stt_dbus_close_peer();
+
+/** Return private connection if it is opened, or bus connection */
+DBusConnection* __stt_dbus_get_conn()
 {
-	DBusConnection* conn = (DBusConnection*)data;
-	DBusMessage* msg = NULL;
-	DBusMessage *reply = NULL;
+	if (NULL != g_peer_conn)
+		return g_peer_conn;
 
-	if (NULL == conn)
-		return ECORE_CALLBACK_RENEW;
+	return g_conn;
+}
+
+double __stt_dbus_get_time_ms()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1000000.0;
+}
 
-	dbus_connection_read_write_dispatch(conn, 50);
+/** Allocate result with room for data_size bytes of strings, which start at *text */
+stt_result_s* __stt_dbus_alloc_result(const char* type, const char* msg, int count, int data_size, char** text)
+{
+	if (NULL == type)	type = "";
+	if (NULL == msg)	msg = "";
 
-	msg = dbus_connection_pop_message(conn);
+	int type_len = strlen(type) + 1;
+	int msg_len = strlen(msg) + 1;
 
-	/* loop again if we haven't read a message */
-	if (NULL == msg) { 
-		return ECORE_CALLBACK_RENEW;
+	stt_result_s* result = (stt_result_s*)malloc(sizeof(stt_result_s) + count * sizeof(char*) + type_len + msg_len + data_size);
+	if (NULL == result) {
+		SLOG(LOG_ERROR, TAG_STTC, "Fail : memory allocation error");
+		return NULL;
+	}
+
+	char** data_list = (char**)(result + 1);
+	char* strings = (char*)(data_list + count);
+
+	result->data_list = (0 < count) ? data_list : NULL;
+	result->data_count = count;
+
+	result->type = strings;
+	memcpy(result->type, type, type_len);
+
+	result->msg = strings + type_len;
+	memcpy(result->msg, msg, msg_len);
+
+	*text = result->msg + msg_len;
+
+	return result;
+}
+
+/** Results are copied out of message arguments into single allocation */
+stt_result_s* __stt_dbus_get_result_from_args(DBusMessageIter* args, const char* type, const char* msg, int count)
+{
+	DBusMessageIter first = *args;
+	char* temp_char = NULL;
+	int data_size = 0;
+	int i;
+
+	/* first pass only measures */
+	for (i = 0;i < count;i++) {
+		if (DBUS_TYPE_STRING == dbus_message_iter_get_arg_type(args)) {
+			dbus_message_iter_get_basic(args, &temp_char);
+			data_size += strlen(temp_char) + 1;
+		}
+		dbus_message_iter_next(args);
+	}
+
+	char* text = NULL;
+	stt_result_s* result = __stt_dbus_alloc_result(type, msg, count, data_size, &text);
+	if (NULL == result)
+		return NULL;
+
+	*args = first;
+	for (i = 0;i < count;i++) {
+		result->data_list[i] = NULL;
+
+		if (DBUS_TYPE_STRING == dbus_message_iter_get_arg_type(args)) {
+			dbus_message_iter_get_basic(args, &temp_char);
+
+			int len = strlen(temp_char) + 1;
+			memcpy(text, temp_char, len);
+			result->data_list[i] = text;
+			text += len;
+		}
+		dbus_message_iter_next(args);
+	}
+
+	return result;
+}
+
+#ifndef F_GET_SEALS
+#define F_GET_SEALS		1034
+#define F_SEAL_SHRINK		0x0002
+#define F_SEAL_WRITE		0x0008
+#endif
+
+/** Read results which daemon wrote into sealed memfd as NULL-terminated strings. Block is copied into single allocation */
+stt_result_s* __stt_dbus_get_result_from_fd(DBusMessageIter* args, const char* type, const char* msg, int count)
+{
+	int fd = -1;
+	int size = 0;
+
+	dbus_message_iter_get_basic(args, &fd);
+	dbus_message_iter_next(args);
+
+	if (DBUS_TYPE_INT32 == dbus_message_iter_get_arg_type(args)) {
+		dbus_message_iter_get_basic(args, &size);
+		dbus_message_iter_next(args);
+	}
+
+	if (0 > fd || 0 >= size || STT_RESULT_FD_MAX_SIZE < size) {
+		SLOG(LOG_ERROR, TAG_STTC, "Invalid result fd(%d) or size(%d)", fd, size);
+		if (0 <= fd)
+			close(fd);
+		return NULL;
+	}
+
+	/* mapping beyond end of file raises SIGBUS, and unsealed data can be changed while it is read */
+	struct stat st;
+	int seals = fcntl(fd, F_GET_SEALS);
+	if (0 != fstat(fd, &st) || st.st_size < size || 0 > seals 
+		|| (F_SEAL_WRITE | F_SEAL_SHRINK) != (seals & (F_SEAL_WRITE | F_SEAL_SHRINK))) {
+		SLOG(LOG_ERROR, TAG_STTC, "Result fd is not sealed or shorter than size(%d)", size);
+		close(fd);
+		return NULL;
+	}
+
+	char* buf = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if (MAP_FAILED == buf) {
+		SLOG(LOG_ERROR, TAG_STTC, "Fail to map result fd");
+		return NULL;
+	}
+
+	/* one more byte terminates the block even if daemon does not */
+	char* text = NULL;
+	stt_result_s* result = __stt_dbus_alloc_result(type, msg, count, size + 1, &text);
+	if (NULL == result) {
+		munmap(buf, size);
+		return NULL;
+	}
+
+	memcpy(text, buf, size);
+	text[size] = '\0';
+
+	munmap(buf, size);
+
+	int i = 0;
+	int offset = 0;
+	for (i = 0;i < count;i++) {
+		if (offset < size) {
+			result->data_list[i] = text + offset;
+			offset += strlen(text + offset) + 1;
+		} else {
+			result->data_list[i] = NULL;
+		}
+	}
+
+	return result;
+}
+
+/** Handle message from daemon */
+/** Read capability bundle from index-th argument. capability is invalid if the bundle is missing */
+int __stt_dbus_get_capability(DBusMessage* msg, int index, stt_capability_s* capability)
+{
+	memset(capability, 0, sizeof(stt_capability_s));
+
+	DBusMessageIter args;
+	if (!dbus_message_iter_init(msg, &args))
+		return -1;
+
+	int i;
+	for (i = 0;i < index;i++) {
+		if (!dbus_message_iter_next(&args))
+			return -1;
+	}
+
+	int partial = 0;
+	int size = 0;
+	char* temp = NULL;
+
+	/* partial result support */
+	if (DBUS_TYPE_INT32 != dbus_message_iter_get_arg_type(&args))
+		return -1;
+	dbus_message_iter_get_basic(&args, &partial);
+	dbus_message_iter_next(&args);
+
+	/* default language */
+	if (DBUS_TYPE_STRING != dbus_message_iter_get_arg_type(&args))
+		return -1;
+	dbus_message_iter_get_basic(&args, &temp);
+	dbus_message_iter_next(&args);
+
+	/* language list */
+	if (DBUS_TYPE_INT32 != dbus_message_iter_get_arg_type(&args))
+		return -1;
+	dbus_message_iter_get_basic(&args, &size);
+	dbus_message_iter_next(&args);
+
+	capability->partial_result = (bool)partial;
+	capability->default_lang = strdup(temp);
+
+	for (i = 0;i < size;i++) {
+		if (DBUS_TYPE_STRING != dbus_message_iter_get_arg_type(&args)) {
+			SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Language list is broken : size(%d), index(%d)", size, i);
+			stt_client_free_capability(capability);
+			return -1;
+		}
+
+		dbus_message_iter_get_basic(&args, &temp);
+		dbus_message_iter_next(&args);
+
+		capability->lang_list = g_list_append(capability->lang_list, strdup(temp));
 	}
 
+	capability->valid = true;
+
+	return 0;
+}
+
+void __stt_dbus_handle_message(DBusConnection* conn, DBusMessage* msg)
+{
+	DBusMessage *reply = NULL;
+
 	DBusError err;
 	dbus_error_init(&err);
 
@@ -138,6 +366,101 @@ static Eina_Bool listener_event_callback(void* data, Ecore_Fd_Handler *fd_handle
 		SLOG(LOG_DEBUG, TAG_STTC, " ");
 	} /* STTD_METHOD_SET_STATE */
 
+	else if (dbus_message_is_method_call(msg, if_name, STTD_METHOD_ENGINE_READY)) {
+		SLOG(LOG_DEBUG, TAG_STTC, "===== Engine Ready");
+		int uid = 0;
+		int response = -1;
+		int result = -1;
+		int silence = 0;
+		int profanity = 0;
+		int punctuation = 0;
+
+		dbus_message_get_args(msg, &err, 
+			DBUS_TYPE_INT32, &uid, 
+			DBUS_TYPE_INT32, &result,
+			DBUS_TYPE_INT32, &silence,
+			DBUS_TYPE_INT32, &profanity,
+			DBUS_TYPE_INT32, &punctuation,
+			DBUS_TYPE_INVALID);
+
+		if (dbus_error_is_set(&err)) { 
+			SLOG(LOG_ERROR, TAG_STTC, "<<<< stt engine ready : Get arguments error (%s)", err.message);
+			dbus_error_free(&err); 
+		} else if (uid > 0) {
+			SLOG(LOG_DEBUG, TAG_STTC, "<<<< stt engine ready : uid(%d), result(%d)", uid, result);
+
+			stt_capability_s capability;
+			if (0 == result && 0 != __stt_dbus_get_capability(msg, 5, &capability))
+				SLOG(LOG_WARN, TAG_STTC, "[WARNING] Capability is missing in engine ready");
+
+			response = __stt_cb_engine_ready(uid, result, (bool)silence, (bool)profanity, (bool)punctuation, 
+							 (0 == result) ? &capability : NULL);
+
+			if (0 == result)
+				stt_client_free_capability(&capability);
+		} else {
+			SLOG(LOG_ERROR, TAG_STTC, "<<<< stt engine ready : invalid uid");
+		}
+
+		reply = dbus_message_new_method_return(msg);
+
+		if (NULL != reply) {
+			dbus_message_append_args(reply, DBUS_TYPE_INT32, &response, DBUS_TYPE_INVALID);
+
+			if (!dbus_connection_send(conn, reply, NULL))
+				SLOG(LOG_ERROR, TAG_STTC, ">>>> stt engine ready : fail to send reply");
+			else 
+				SLOG(LOG_DEBUG, TAG_STTC, ">>>> stt engine ready : result(%d)", response);
+
+			dbus_connection_flush(conn);
+			dbus_message_unref(reply); 
+		} else {
+			SLOG(LOG_ERROR, TAG_STTC, ">>>> stt engine ready : fail to create reply message");
+		}
+
+		SLOG(LOG_DEBUG, TAG_STTC, "=====");
+		SLOG(LOG_DEBUG, TAG_STTC, " ");
+	} /* STTD_METHOD_ENGINE_READY */
+
+	else if (dbus_message_is_method_call(msg, if_name, STTD_METHOD_ENGINE_CHANGED)) {
+		SLOG(LOG_DEBUG, TAG_STTC, "===== Engine Changed");
+		int uid = 0;
+		int silence = 0;
+		int profanity = 0;
+		int punctuation = 0;
+
+		dbus_message_get_args(msg, &err, DBUS_TYPE_INT32, &uid, DBUS_TYPE_INVALID);
+
+		if (dbus_error_is_set(&err)) { 
+			SLOG(LOG_ERROR, TAG_STTC, "<<<< stt engine changed : Get arguments error (%s)", err.message);
+			dbus_error_free(&err); 
+		} else if (uid > 0) {
+			/* options and capability are missing if daemon fails to get them */
+			dbus_message_get_args(msg, NULL, 
+				DBUS_TYPE_INT32, &uid, 
+				DBUS_TYPE_INT32, &silence,
+				DBUS_TYPE_INT32, &profanity,
+				DBUS_TYPE_INT32, &punctuation,
+				DBUS_TYPE_INVALID);
+
+			stt_capability_s capability;
+			__stt_dbus_get_capability(msg, 4, &capability);
+
+			SLOG(LOG_DEBUG, TAG_STTC, "<<<< stt engine changed : uid(%d), capability(%s)", 
+				uid, capability.valid ? "valid" : "invalid");
+
+			__stt_cb_engine_changed(uid, (bool)silence, (bool)profanity, (bool)punctuation, &capability);
+
+			stt_client_free_capability(&capability);
+		} else {
+			SLOG(LOG_ERROR, TAG_STTC, "<<<< stt engine changed : invalid uid");
+		}
+
+		/* daemon does not wait for reply */
+		SLOG(LOG_DEBUG, TAG_STTC, "=====");
+		SLOG(LOG_DEBUG, TAG_STTC, " ");
+	} /* STTD_METHOD_ENGINE_CHANGED */
+
 	else if (dbus_message_is_method_call(msg, if_name, STTD_METHOD_GET_STATE)) {
 		SLOG(LOG_DEBUG, TAG_STTC, "===== Get state");
 		int uid = 0;
@@ -194,9 +517,8 @@ static Eina_Bool listener_event_callback(void* data, Ecore_Fd_Handler *fd_handle
 		
 		if (uid > 0) {
 			SLOG(LOG_DEBUG, TAG_STTC, "<<<< stt get result : uid(%d) \n", uid);
-			char** temp_result;
+			stt_result_s* result = NULL;
 			char* temp_msg = NULL;
-			char* temp_char = NULL;
 			char* temp_type = 0;
 			int temp_count = 0;
 
@@ -219,32 +541,21 @@ static Eina_Bool listener_event_callback(void* data, Ecore_Fd_Handler *fd_handle
 
 			if (temp_count <= 0) {
 				SLOG(LOG_ERROR, TAG_STTC, "Result count is 0");
-				__stt_cb_result(uid, temp_type, NULL, 0, temp_msg);
+				result = __stt_dbus_get_result_from_args(&args, temp_type, temp_msg, 0);
+			} else if (DBUS_TYPE_UNIX_FD == dbus_message_iter_get_arg_type(&args)) {
+				/* large result on private connection */
+				result = __stt_dbus_get_result_from_fd(&args, temp_type, temp_msg, temp_count);
+
+				/* state of client still changes with empty result */
+				if (NULL == result)
+					result = __stt_dbus_get_result_from_args(&args, temp_type, temp_msg, 0);
 			} else {
-				temp_result = g_malloc0(temp_count * sizeof(char*));
-
-				if (NULL == temp_result)	{
-					SLOG(LOG_ERROR, TAG_STTC, "Fail : memory allocation error \n");
-				} else {
-					int i = 0;
-					for (i = 0;i < temp_count;i++) {
-						dbus_message_iter_get_basic(&args, &(temp_char) );
-						dbus_message_iter_next(&args);
-						
-						if (NULL != temp_char)
-							temp_result[i] = strdup(temp_char);
-					}
-		
-					__stt_cb_result(uid, temp_type, (const char**)temp_result, temp_count, temp_msg);
-
-					for (i = 0;i < temp_count;i++) {
-						if (NULL != temp_result[i])
-							free(temp_result[i]);
-					}
+				result = __stt_dbus_get_result_from_args(&args, temp_type, temp_msg, temp_count);
+			}
 
-					g_free(temp_result);
-				}
-			}	
+			/* client frees result after callback */
+			if (NULL != result)
+				__stt_cb_result(uid, result);
 		} else {
 			SLOG(LOG_ERROR, TAG_STTC, "<<<< stt get result : invalid uid \n");
 		} 
@@ -269,13 +580,20 @@ static Eina_Bool listener_event_callback(void* data, Ecore_Fd_Handler *fd_handle
 		if (uid > 0) {
 			SLOG(LOG_DEBUG, TAG_STTC, "<<<< stt get partial result : uid(%d) \n", uid);
 			char* temp_char = NULL;
+			int keep = 0;
+
+			/* bytes of previous partial result to keep */
+			if (DBUS_TYPE_INT32 == dbus_message_iter_get_arg_type(&args)) {
+				dbus_message_iter_get_basic(&args, &keep);
+				dbus_message_iter_next(&args);
+			}
 
 			if (DBUS_TYPE_STRING == dbus_message_iter_get_arg_type(&args)) {
 				dbus_message_iter_get_basic(&args, &(temp_char) );
 				dbus_message_iter_next(&args);
 			}
 
-			__stt_cb_partial_result(uid, temp_char);
+			__stt_cb_partial_result(uid, keep, temp_char);
 		} else {
 			SLOG(LOG_ERROR, TAG_STTC, "<<<< stt get partial result : invalid uid \n");
 		}
@@ -284,6 +602,31 @@ static Eina_Bool listener_event_callback(void* data, Ecore_Fd_Handler *fd_handle
 		SLOG(LOG_DEBUG, TAG_STTC, " ");
 	}/* STTD_METHOD_PARTIAL_RESULT */
 
+	else if (dbus_message_is_method_call(msg, if_name, STTD_METHOD_QUEUE_POSITION)) {
+		SLOG(LOG_DEBUG, TAG_STTC, "===== Queue Position");
+		int uid = 0;
+		int position = 0;
+
+		dbus_message_get_args(msg, &err, 
+			DBUS_TYPE_INT32, &uid, 
+			DBUS_TYPE_INT32, &position,
+			DBUS_TYPE_INVALID);
+
+		if (dbus_error_is_set(&err)) { 
+			SLOG(LOG_ERROR, TAG_STTC, "<<<< stt queue position : Get arguments error (%s)", err.message);
+			dbus_error_free(&err); 
+		} else if (uid > 0) {
+			SLOG(LOG_DEBUG, TAG_STTC, "<<<< stt queue position : uid(%d), position(%d)", uid, position);
+
+			__stt_cb_queue_position(uid, position);
+		} else {
+			SLOG(LOG_ERROR, TAG_STTC, "<<<< stt queue position : invalid uid");
+		}
+
+		SLOG(LOG_DEBUG, TAG_STTC, "=====");
+		SLOG(LOG_DEBUG, TAG_STTC, " ");
+	} /* STTD_METHOD_QUEUE_POSITION */
+
 	else if (dbus_message_is_method_call(msg, if_name, STTD_METHOD_ERROR)) {
 		SLOG(LOG_DEBUG, TAG_STTC, "===== Get Error");
 		int uid;
@@ -322,10 +665,206 @@ static Eina_Bool listener_event_callback(void* data, Ecore_Fd_Handler *fd_handle
 		SLOG(LOG_DEBUG, TAG_STTC, " ");
 	}/* STTD_METHOD_ERROR */
 
-	/* free the message */
+	return;
+}
+
+static void listener_event_callback(void* data)
+{
+	DBusConnection* conn = (DBusConnection*)data;
+	DBusMessage* msg = NULL;
+
+	if (NULL == conn)
+		return;
+
+	dbus_connection_read_write(conn, 0);
+
+	/* daemon closed private connection. Requests go through the bus */
+	if (conn == g_peer_conn && !dbus_connection_get_is_connected(conn)) {
+		SLOG(LOG_WARN, TAG_STTC, "Private connection is closed");
+		__stt_dbus_close_peer();
+		return;
+	}
+
+	while (DBUS_DISPATCH_DATA_REMAINS == dbus_connection_get_dispatch_status(conn)) {
+		msg = dbus_connection_borrow_message(conn);
+		if (NULL == msg)
+			break;
+
+		/* reply completes its pending call through dispatch */
+		if (DBUS_MESSAGE_TYPE_METHOD_RETURN == dbus_message_get_type(msg) || DBUS_MESSAGE_TYPE_ERROR == dbus_message_get_type(msg)) {
+			dbus_connection_return_message(conn, msg);
+			dbus_connection_dispatch(conn);
+			continue;
+		}
+
+		dbus_connection_steal_borrowed_message(conn, msg);
+
+		__stt_dbus_handle_message(conn, msg);
+
+		/* free the message */
+		dbus_message_unref(msg);
+	}
+}
+
+/*
+* Asynchronous request
+*/
+
+/** request waiting for reply of daemon */
+struct stt_dbus_call_s {
+	DBusPendingCall*	pending;
+	stt_loop_source_h	timer;
+	stt_dbus_reply_cb	callback;
+	void*			user_data;
+};
+
+void __stt_dbus_complete_call(stt_dbus_call_h call, DBusMessage* reply, int result)
+{
+	if (NULL != call->timer) {
+		stt_loop_remove(call->timer);
+		call->timer = NULL;
+	}
+
+	if (NULL != call->pending) {
+		dbus_pending_call_unref(call->pending);
+		call->pending = NULL;
+	}
+
+	if (NULL != call->callback)
+		call->callback(reply, result, call->user_data);
+
+	free(call);
+}
+
+void __stt_dbus_call_notify(DBusPendingCall* pending, void* data)
+{
+	stt_dbus_call_h call = (stt_dbus_call_h)data;
+
+	DBusMessage* reply = dbus_pending_call_steal_reply(pending);
+
+	if (NULL == reply) {
+		__stt_dbus_complete_call(call, NULL, STT_ERROR_OPERATION_FAILED);
+		return;
+	}
+
+	if (DBUS_MESSAGE_TYPE_ERROR == dbus_message_get_type(reply)) {
+		SLOG(LOG_ERROR, TAG_STTC, "<<<< Error reply (%s)", dbus_message_get_error_name(reply));
+
+		/* libdbus makes error reply when timeout of blocking wait is expired */
+		if (dbus_message_is_error(reply, DBUS_ERROR_NO_REPLY)) 
+			__stt_dbus_complete_call(call, NULL, STT_ERROR_TIMED_OUT);
+		else 
+			__stt_dbus_complete_call(call, NULL, STT_ERROR_OPERATION_FAILED);
+	} else {
+		__stt_dbus_complete_call(call, reply, STT_ERROR_NONE);
+	}
+
+	dbus_message_unref(reply);
+}
+
+/* libdbus timeout is not serviced by main loop, so main loop timer expires async request */
+void __stt_dbus_call_expired(void* data)
+{
+	stt_dbus_call_h call = (stt_dbus_call_h)data;
+
+	SLOG(LOG_ERROR, TAG_STTC, "<<<< Daemon does not reply in time");
+
+	call->timer = NULL;
+	dbus_pending_call_cancel(call->pending);
+
+	__stt_dbus_complete_call(call, NULL, STT_ERROR_TIMED_OUT);
+}
+
+/** Send request on conn without waiting. It takes ownership of msg */
+int __stt_dbus_send_async_on(DBusConnection* conn, DBusMessage* msg, int timeout, stt_dbus_reply_cb callback, void* user_data, stt_dbus_call_h* call)
+{
+	stt_dbus_call_h temp = (stt_dbus_call_h)calloc(1, sizeof(struct stt_dbus_call_s));
+	if (NULL == temp) {
+		SLOG(LOG_ERROR, TAG_STTC, ">>>> Fail : memory allocation error");
+		dbus_message_unref(msg);
+		return STT_ERROR_OUT_OF_MEMORY;
+	}
+
+	/* pending is NULL if connection is closed */
+	if (!dbus_connection_send_with_reply(conn, msg, &temp->pending, timeout) || NULL == temp->pending) {
+		SLOG(LOG_ERROR, TAG_STTC, ">>>> Fail to send request");
+		dbus_message_unref(msg);
+		free(temp);
+		return STT_ERROR_OPERATION_FAILED;
+	}
+
 	dbus_message_unref(msg);
 
-	return ECORE_CALLBACK_PASS_ON;
+	temp->callback = callback;
+	temp->user_data = user_data;
+	temp->timer = stt_loop_add_timer(timeout, __stt_dbus_call_expired, temp);
+
+	dbus_pending_call_set_notify(temp->pending, __stt_dbus_call_notify, temp, NULL);
+
+	dbus_connection_flush(conn);
+
+	if (NULL != call)
+		*call = temp;
+
+	return STT_ERROR_NONE;
+}
+
+/** Send request without waiting. It takes ownership of msg */
+int __stt_dbus_send_async(DBusMessage* msg, int timeout, stt_dbus_reply_cb callback, void* user_data, stt_dbus_call_h* call)
+{
+	return __stt_dbus_send_async_on(__stt_dbus_get_conn(), msg, timeout, callback, user_data, call);
+}
+
+int stt_dbus_cancel_call(stt_dbus_call_h call)
+{
+	if (NULL == call)
+		return STT_ERROR_INVALID_PARAMETER;
+
+	/* reply is dropped and callback is not called */
+	dbus_pending_call_cancel(call->pending);
+	call->callback = NULL;
+
+	__stt_dbus_complete_call(call, NULL, STT_ERROR_NONE);
+
+	return STT_ERROR_NONE;
+}
+
+/** Block until request is completed. Callback is called before return */
+void __stt_dbus_wait_call(stt_dbus_call_h call)
+{
+	DBusPendingCall* pending = dbus_pending_call_ref(call->pending);
+
+	dbus_pending_call_block(pending);
+
+	dbus_pending_call_unref(pending);
+}
+
+typedef struct {
+	DBusMessage*	reply;
+	int		result;
+} stt_dbus_sync_s;
+
+void __stt_dbus_sync_reply(DBusMessage* reply, int result, void* user_data)
+{
+	stt_dbus_sync_s* sync = (stt_dbus_sync_s*)user_data;
+
+	sync->result = result;
+	if (NULL != reply)
+		sync->reply = dbus_message_ref(reply);
+}
+
+/** Blocking request over async one. Caller keeps msg and gets reply or NULL */
+DBusMessage* __stt_dbus_send_and_wait(DBusMessage* msg, int timeout)
+{
+	stt_dbus_sync_s sync = {NULL, STT_ERROR_OPERATION_FAILED};
+	stt_dbus_call_h call = NULL;
+
+	if (0 != __stt_dbus_send_async(dbus_message_ref(msg), timeout, __stt_dbus_sync_reply, &sync, &call))
+		return NULL;
+
+	__stt_dbus_wait_call(call);
+
+	return sync.reply;
 }
 
 int stt_dbus_open_connection()
@@ -401,10 +940,10 @@ int stt_dbus_open_connection()
 		SLOG(LOG_DEBUG, TAG_STTC, "Get fd from dbus : %d\n", fd);
 	}
 
-	g_fd_handler = ecore_main_fd_handler_add(fd, ECORE_FD_READ, (Ecore_Fd_Cb)listener_event_callback, g_conn, NULL, NULL);
+	g_fd_handler = stt_loop_add_fd(fd, listener_event_callback, g_conn);
 
 	if (NULL == g_fd_handler) {
-		SLOG(LOG_ERROR, TAG_STTC, "fail to get fd handler from ecore \n");
+		SLOG(LOG_ERROR, TAG_STTC, "fail to get fd handler from main loop \n");
 		return STT_ERROR_OPERATION_FAILED;
 	}
 
@@ -422,58 +961,172 @@ int stt_dbus_close_connection()
 	memset(service_name, '\0', 64);
 	snprintf(service_name, 64, "%s%d", STT_CLIENT_SERVICE_NAME, pid);
 
+	__stt_dbus_close_peer();
+
 	dbus_bus_release_name (g_conn, service_name, &err);
 
+	if (NULL != g_fd_handler) {
+		stt_loop_remove(g_fd_handler);
+		g_fd_handler = NULL;
+	}
+
 	dbus_connection_close(g_conn);
 
-	g_fd_handler = NULL;
 	g_conn = NULL;
 
 	return 0;
 }
 
-int stt_dbus_request_hello()
+void __stt_dbus_close_peer()
+{
+	if (NULL != g_peer_fd_handler) {
+		stt_loop_remove(g_peer_fd_handler);
+		g_peer_fd_handler = NULL;
+	}
+
+	if (NULL != g_peer_conn) {
+		dbus_connection_close(g_peer_conn);
+		dbus_connection_unref(g_peer_conn);
+		g_peer_conn = NULL;
+	}
+}
+
+/** Open private connection to daemon. Client keeps using the bus if it fails */
+/** Daemon runs as root. Socket of other user is not trusted */
+bool __stt_dbus_is_daemon_peer(DBusConnection* conn)
 {
+	int fd = -1;
+	if (1 != dbus_connection_get_unix_fd(conn, &fd))
+		return false;
+
+	struct ucred cred;
+	socklen_t len = sizeof(cred);
+	if (0 != getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len)) 
+		return false;
+
+	return (0 == cred.uid);
+}
+
+int __stt_dbus_open_peer()
+{
+	/* bus only, to compare latency of transports */
+	const char* transport = getenv("STT_DBUS_TRANSPORT");
+	if (NULL != transport && 0 == strcmp(transport, "bus")) 
+		return STT_ERROR_NONE;
+
+	DBusError err;
+	dbus_error_init(&err);
+
+	DBusConnection* conn = dbus_connection_open_private(STT_PEER_ADDRESS, &err);
+
+	if (NULL == conn) {
+		SLOG(LOG_WARN, TAG_STTC, "Fail to open private connection (%s)", err.message);
+		dbus_error_free(&err);
+		return STT_ERROR_OPERATION_FAILED;
+	}
+
+	if (false == __stt_dbus_is_daemon_peer(conn)) {
+		SLOG(LOG_ERROR, TAG_STTC, "Private connection is not opened by daemon. Use bus");
+		dbus_connection_close(conn);
+		dbus_connection_unref(conn);
+		return STT_ERROR_OPERATION_FAILED;
+	}
+
 	DBusMessage* msg;
 
 	msg = dbus_message_new_method_call(
 		STT_SERVER_SERVICE_NAME, 
 		STT_SERVER_SERVICE_OBJECT_PATH, 
 		STT_SERVER_SERVICE_INTERFACE, 
-		STT_METHOD_HELLO);
+		STT_METHOD_PEER_HELLO);
 
 	if (NULL == msg) { 
-		SLOG(LOG_ERROR, TAG_STTC, ">>>> Request stt hello : Fail to make message \n"); 
+		SLOG(LOG_ERROR, TAG_STTC, ">>>> stt peer hello : Fail to make message \n"); 
+		dbus_connection_close(conn);
+		dbus_connection_unref(conn);
 		return STT_ERROR_OPERATION_FAILED;
-	} else {
-		SLOG(LOG_DEBUG, TAG_STTC, ">>>> Request stt hello");
 	}
 
-	DBusError err;
-	dbus_error_init(&err);
+	int pid = getpid();
+	dbus_message_append_args(msg, DBUS_TYPE_INT32, &pid, DBUS_TYPE_INVALID);
 
-	DBusMessage* result_msg = NULL;
-	int result = 0;
+	DBusMessage* result_msg;
+	int result = STT_ERROR_OPERATION_FAILED;
+	double start = __stt_dbus_get_time_ms();
 
-	result_msg = dbus_connection_send_with_reply_and_block(g_conn, msg, 500, &err);
+	result_msg = dbus_connection_send_with_reply_and_block(conn, msg, 500, &err);
 
 	dbus_message_unref(msg);
 
 	if (NULL != result_msg) {
+		dbus_message_get_args(result_msg, &err, DBUS_TYPE_INT32, &result, DBUS_TYPE_INVALID);
+
+		if (dbus_error_is_set(&err)) { 
+			SLOG(LOG_ERROR, TAG_STTC, "<<<< Get arguments error (%s)\n", err.message);
+			dbus_error_free(&err); 
+			result = STT_ERROR_OPERATION_FAILED;
+		}
+
 		dbus_message_unref(result_msg);
+	} else {
+		SLOG(LOG_ERROR, TAG_STTC, "<<<< stt peer hello : no response");
+		if (dbus_error_is_set(&err)) 
+			dbus_error_free(&err);
+	}
+
+	int fd = 0;
+	if (0 == result && 1 == dbus_connection_get_unix_fd(conn, &fd)) {
+		g_peer_fd_handler = stt_loop_add_fd(fd, listener_event_callback, conn);
+	}
+
+	if (NULL == g_peer_fd_handler) {
+		SLOG(LOG_WARN, TAG_STTC, "<<<< stt peer hello : result = %d, use bus", result);
+		dbus_connection_close(conn);
+		dbus_connection_unref(conn);
+		return STT_ERROR_OPERATION_FAILED;
+	}
+
+	g_peer_conn = conn;
+
+	SLOG(LOG_DEBUG, TAG_STTC, "<<<< stt peer hello : round trip %.3f msec", __stt_dbus_get_time_ms() - start);
 
-		SLOG(LOG_DEBUG, TAG_STTC, "<<<< stt hello");
-		result = 0;
+	return STT_ERROR_NONE;
+}
+
+int stt_dbus_request_hello_async(stt_dbus_reply_cb callback, void* user_data, stt_dbus_call_h* call)
+{
+	DBusMessage* msg;
+
+	msg = dbus_message_new_method_call(
+		STT_SERVER_SERVICE_NAME, 
+		STT_SERVER_SERVICE_OBJECT_PATH, 
+		STT_SERVER_SERVICE_INTERFACE, 
+		STT_METHOD_HELLO);
+
+	if (NULL == msg) { 
+		SLOG(LOG_ERROR, TAG_STTC, ">>>> Request stt hello : Fail to make message \n"); 
+		return STT_ERROR_OPERATION_FAILED;
 	} else {
-		SLOG(LOG_ERROR, TAG_STTC, "<<<< stt hello : no response");
-		result = STT_ERROR_OPERATION_FAILED;
+		SLOG(LOG_DEBUG, TAG_STTC, ">>>> Request stt hello");
 	}
 
-	return result;
+	/* bus starts daemon by service file and holds hello until daemon owns its name */
+	dbus_message_set_auto_start(msg, TRUE);
+
+	/* hello always goes through the bus to find daemon */
+	return __stt_dbus_send_async_on(g_conn, msg, STT_DAEMON_ACTIVATION_TIMEOUT, callback, user_data, call);
 }
 
+int stt_dbus_connect_peer()
+{
+	/* negotiate private connection after daemon is found */
+	if (NULL != g_peer_conn)
+		return STT_ERROR_NONE;
 
-int stt_dbus_request_initialize(int uid, bool* silence_supported, bool* profanity_supported, bool* punctuation_supported)
+	return __stt_dbus_open_peer();
+}
+
+int stt_dbus_request_initialize(int uid, bool* silence_supported, bool* profanity_supported, bool* punctuation_supported, bool* engine_loading, stt_capability_s* capability)
 {
 	DBusMessage* msg;
 
@@ -501,8 +1154,10 @@ int stt_dbus_request_initialize(int uid, bool* silence_supported, bool* profanit
 
 	DBusMessage* result_msg;
 	int result = STT_ERROR_OPERATION_FAILED;
+	int loading = 0;
 
-	result_msg = dbus_connection_send_with_reply_and_block(g_conn, msg, g_waiting_time, &err);
+	/* freshly activated daemon answers initialize after engine scan */
+	result_msg = __stt_dbus_send_and_wait(msg, STT_DAEMON_ACTIVATION_TIMEOUT);
 
 	if (NULL != result_msg) {
 		dbus_message_get_args(result_msg, &err, 
@@ -510,6 +1165,7 @@ int stt_dbus_request_initialize(int uid, bool* silence_supported, bool* profanit
 			DBUS_TYPE_INT32, silence_supported,
 			DBUS_TYPE_INT32, profanity_supported,
 			DBUS_TYPE_INT32, punctuation_supported,
+			DBUS_TYPE_INT32, &loading,
 			DBUS_TYPE_INVALID);
 
 		if (dbus_error_is_set(&err)) { 
@@ -518,14 +1174,19 @@ int stt_dbus_request_initialize(int uid, bool* silence_supported, bool* profanit
 			result = STT_ERROR_OPERATION_FAILED;
 		}
 
+		/* capability comes with engine ready, if engine is loading */
+		if (0 == result && 0 == loading)
+			__stt_dbus_get_capability(result_msg, 5, capability);
+
 		dbus_message_unref(result_msg);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTC, "<<<< Result message is NULL \n");
 	}
 
 	if (0 == result) {
-		SLOG(LOG_DEBUG, TAG_STTC, "<<<< stt initialize : result = %d , silence(%d), profanity(%d), punctuation(%d)", 
-			result, *silence_supported, *profanity_supported, *punctuation_supported);
+		*engine_loading = (bool)loading;
+		SLOG(LOG_DEBUG, TAG_STTC, "<<<< stt initialize : result = %d , silence(%d), profanity(%d), punctuation(%d), loading(%d)", 
+			result, *silence_supported, *profanity_supported, *punctuation_supported, loading);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTC, "<<<< stt initialize : result = %d \n", result);
 	}
@@ -560,7 +1221,7 @@ int stt_dbus_request_finalize(int uid)
 	DBusMessage* result_msg;
 	int result = STT_ERROR_OPERATION_FAILED;
 
-	result_msg = dbus_connection_send_with_reply_and_block(g_conn, msg, g_waiting_time, &err);
+	result_msg = __stt_dbus_send_and_wait(msg, g_waiting_time);
 
 	if (NULL != result_msg) {
 		dbus_message_get_args(result_msg, &err, 
@@ -620,7 +1281,7 @@ int stt_dbus_request_get_support_langs(int uid, stt_h stt, stt_supported_languag
 	DBusMessageIter args;
 	int result = STT_ERROR_OPERATION_FAILED;
 
-	result_msg = dbus_connection_send_with_reply_and_block(g_conn, msg, g_waiting_time, &err );
+	result_msg = __stt_dbus_send_and_wait(msg, g_waiting_time);
 
 	if (NULL != result_msg) {
 		if (dbus_message_iter_init(result_msg, &args)) {
@@ -703,7 +1364,7 @@ int stt_dbus_request_get_default_lang(int uid, char** language)
 	int result = STT_ERROR_OPERATION_FAILED;
 	char* temp_lang = NULL;
 
-	result_msg = dbus_connection_send_with_reply_and_block(g_conn, msg, g_waiting_time, &err);
+	result_msg = __stt_dbus_send_and_wait(msg, g_waiting_time);
 
 	if (NULL != result_msg) {
 		dbus_message_get_args(result_msg, &err,
@@ -766,7 +1427,7 @@ int stt_dbus_request_is_partial_result_supported(int uid, bool* partial_result)
 	int result = STT_ERROR_OPERATION_FAILED;
 	int support = -1;
 
-	result_msg = dbus_connection_send_with_reply_and_block(g_conn, msg, g_waiting_time, &err);
+	result_msg = __stt_dbus_send_and_wait(msg, g_waiting_time);
 
 	if (NULL != result_msg) {
 		dbus_message_get_args(result_msg, &err,
@@ -796,7 +1457,8 @@ int stt_dbus_request_is_partial_result_supported(int uid, bool* partial_result)
 	return result;
 }
 
-int stt_dbus_request_start(int uid, const char* lang, const char* type, int profanity, int punctuation, int silence)
+int stt_dbus_request_start_async(int uid, const char* lang, const char* type, int profanity, int punctuation, int silence, 
+			   int priority, int wait_timeout, int partial_interval, stt_dbus_reply_cb callback, void* user_data, stt_dbus_call_h* call)
 {
 	if (NULL == lang || NULL == type) {
 		SLOG(LOG_ERROR, TAG_STTC, "Input parameter is NULL");
@@ -826,62 +1488,102 @@ int stt_dbus_request_start(int uid, const char* lang, const char* type, int prof
 		DBUS_TYPE_INT32, &profanity,
 		DBUS_TYPE_INT32, &punctuation,
 		DBUS_TYPE_INT32, &silence,
+		DBUS_TYPE_INT32, &priority,
+		DBUS_TYPE_INT32, &wait_timeout,
+		DBUS_TYPE_INT32, &partial_interval,
 		DBUS_TYPE_INVALID);
-	
-	DBusError err;
-	dbus_error_init(&err);
 
-	DBusMessage* result_msg;
+	return __stt_dbus_send_async(msg, g_waiting_start_time, callback, user_data, call);
+}
+
+int stt_dbus_get_start_result(DBusMessage* reply, int* queue_position)
+{
 	int result = STT_ERROR_OPERATION_FAILED;
+	int position = 0;
 
-	result_msg = dbus_connection_send_with_reply_and_block(g_conn, msg, g_waiting_start_time, &err);
+	if (NULL != reply) {
+		DBusMessageIter args;
+		dbus_message_iter_init(reply, &args);
 
-	if (NULL != result_msg) {
-		dbus_message_get_args(result_msg, &err,
-			DBUS_TYPE_INT32, &result,
-			DBUS_TYPE_INVALID);
+		/* queue position is appended by daemon supporting queue */
+		if (DBUS_TYPE_INT32 == dbus_message_iter_get_arg_type(&args)) {
+			dbus_message_iter_get_basic(&args, &result);
+			dbus_message_iter_next(&args);
 
-		if (dbus_error_is_set(&err)) { 
-			printf("<<<< Get arguments error (%s)\n", err.message);
-			dbus_error_free(&err); 
+			if (DBUS_TYPE_INT32 == dbus_message_iter_get_arg_type(&args)) 
+				dbus_message_iter_get_basic(&args, &position);
+		} else {
+			SLOG(LOG_ERROR, TAG_STTC, "<<<< stt start : Get arguments error");
 			result = STT_ERROR_OPERATION_FAILED;
 		}
-		dbus_message_unref(result_msg);
 	} else {
 		SLOG(LOG_DEBUG, TAG_STTC, "<<<< Result Message is NULL");
 	}
 
 	if (0 == result) {
-		SLOG(LOG_DEBUG, TAG_STTC, "<<<< stt start : result = %d ", result);
+		SLOG(LOG_DEBUG, TAG_STTC, "<<<< stt start : result = %d, queue position = %d", result, position);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTC, "<<<< stt start : result = %d ", result);
 	}
 
-	dbus_message_unref(msg);
+	if (NULL != queue_position)
+		*queue_position = position;
 
 	return result;
 }
 
-int stt_dbus_request_stop(int uid)
+int stt_dbus_request_start(int uid, const char* lang, const char* type, int profanity, int punctuation, int silence, 
+			   int priority, int wait_timeout, int partial_interval, int* queue_position)
 {
+	stt_dbus_sync_s sync = {NULL, STT_ERROR_OPERATION_FAILED};
+	stt_dbus_call_h call = NULL;
+
+	int ret = stt_dbus_request_start_async(uid, lang, type, profanity, punctuation, silence, priority, wait_timeout, 
+						partial_interval, __stt_dbus_sync_reply, &sync, &call);
+	if (0 != ret)
+		return ret;
+
+	__stt_dbus_wait_call(call);
+
+	ret = stt_dbus_get_start_result(sync.reply, queue_position);
+
+	if (NULL != sync.reply)
+		dbus_message_unref(sync.reply);
+
+	return ret;
+}
+
+int stt_dbus_request_recognize_once(int uid, const char* lang, const char* type, int profanity, int punctuation, int silence)
+{
+	if (NULL == lang || NULL == type) {
+		SLOG(LOG_ERROR, TAG_STTC, "Input parameter is NULL");
+		return STT_ERROR_INVALID_PARAMETER;
+	}
+
 	DBusMessage* msg;
 
-	/* create a signal & check for errors */
 	msg = dbus_message_new_method_call(
-		STT_SERVER_SERVICE_NAME,
-		STT_SERVER_SERVICE_OBJECT_PATH,	
-		STT_SERVER_SERVICE_INTERFACE,	
-		STT_METHOD_STOP);
+		STT_SERVER_SERVICE_NAME, 
+		STT_SERVER_SERVICE_OBJECT_PATH, 
+		STT_SERVER_SERVICE_INTERFACE, 
+		STT_METHOD_RECOGNIZE_ONCE);
 
 	if (NULL == msg) { 
-		SLOG(LOG_ERROR, TAG_STTC, ">>>> stt stop : Fail to make message \n"); 
+		SLOG(LOG_ERROR, TAG_STTC, ">>>> stt recognize once : Fail to make message \n"); 
 		return STT_ERROR_OPERATION_FAILED;
 	} else {
-		SLOG(LOG_DEBUG, TAG_STTC, ">>>> stt stop : uid(%d)", uid);
+		SLOG(LOG_DEBUG, TAG_STTC, ">>>> stt recognize once : uid(%d), language(%s), type(%s)", uid, lang, type);
 	}
 
-	dbus_message_append_args(msg, 
+	int pid = getpid();
+	dbus_message_append_args( msg, 
+		DBUS_TYPE_INT32, &pid,
 		DBUS_TYPE_INT32, &uid, 
+		DBUS_TYPE_STRING, &lang,   
+		DBUS_TYPE_STRING, &type,
+		DBUS_TYPE_INT32, &profanity,
+		DBUS_TYPE_INT32, &punctuation,
+		DBUS_TYPE_INT32, &silence,
 		DBUS_TYPE_INVALID);
 
 	DBusError err;
@@ -890,27 +1592,30 @@ int stt_dbus_request_stop(int uid)
 	DBusMessage* result_msg;
 	int result = STT_ERROR_OPERATION_FAILED;
 
-	result_msg = dbus_connection_send_with_reply_and_block(g_conn, msg, g_waiting_time, &err);
+	/* request may start daemon */
+	result_msg = __stt_dbus_send_and_wait(msg, STT_DAEMON_ACTIVATION_TIMEOUT);
 
 	if (NULL != result_msg) {
-		dbus_message_get_args(result_msg, &err,
-			DBUS_TYPE_INT32, &result,
-			DBUS_TYPE_INVALID);
+		dbus_message_get_args(result_msg, &err, 
+				DBUS_TYPE_INT32, &result,
+				DBUS_TYPE_INVALID);
 
 		if (dbus_error_is_set(&err)) { 
-			printf("<<<< Get arguments error (%s)\n", err.message);
+			SLOG(LOG_ERROR, TAG_STTC, "<<<< Get arguments error (%s)", err.message);
 			dbus_error_free(&err); 
 			result = STT_ERROR_OPERATION_FAILED;
 		}
+
 		dbus_message_unref(result_msg);
 	} else {
-		SLOG(LOG_DEBUG, TAG_STTC, "<<<< Result Message is NULL");
+		SLOG(LOG_ERROR, TAG_STTC, "<<<< Result message is NULL");
+		result = STT_ERROR_TIMED_OUT;
 	}
 
 	if (0 == result) {
-		SLOG(LOG_DEBUG, TAG_STTC, "<<<< stt stop : result = %d ", result);
+		SLOG(LOG_DEBUG, TAG_STTC, "<<<< stt recognize once : result = %d", result);
 	} else {
-		SLOG(LOG_ERROR, TAG_STTC, "<<<< stt stop : result = %d ", result);
+		SLOG(LOG_ERROR, TAG_STTC, "<<<< stt recognize once : result = %d", result);
 	}
 
 	dbus_message_unref(msg);
@@ -918,62 +1623,152 @@ int stt_dbus_request_stop(int uid)
 	return result;
 }
 
-int stt_dbus_request_cancel(int uid)
+int stt_dbus_request_prewarm(int uid, const char* lang, const char* type, int profanity, int punctuation, int silence, int hold_ms)
 {
+	if (NULL == lang || NULL == type) {
+		SLOG(LOG_ERROR, TAG_STTC, "Input parameter is NULL");
+		return STT_ERROR_INVALID_PARAMETER;
+	}
+
 	DBusMessage* msg;
 
 	/* create a signal & check for errors */
 	msg = dbus_message_new_method_call(
 		STT_SERVER_SERVICE_NAME,
-		STT_SERVER_SERVICE_OBJECT_PATH,	/* object name of the signal */
-		STT_SERVER_SERVICE_INTERFACE,	/* interface name of the signal */
-		STT_METHOD_CANCEL);	/* name of the signal */
+		STT_SERVER_SERVICE_OBJECT_PATH,	
+		STT_SERVER_SERVICE_INTERFACE,	
+		STT_METHOD_PREWARM);		
 
 	if (NULL == msg) { 
-		SLOG(LOG_ERROR, TAG_STTC, ">>>> stt cancel : Fail to make message \n"); 
+		SLOG(LOG_ERROR, TAG_STTC, ">>>> stt prewarm : Fail to make message \n"); 
 		return STT_ERROR_OPERATION_FAILED;
 	} else {
-		SLOG(LOG_DEBUG, TAG_STTC, ">>>> stt cancel : uid(%d)", uid);
+		SLOG(LOG_DEBUG, TAG_STTC, ">>>> stt prewarm : uid(%d), language(%s), type(%s), hold(%d)", uid, lang, type, hold_ms);
+	}
+
+	dbus_message_append_args( msg, 
+		DBUS_TYPE_INT32, &uid, 
+		DBUS_TYPE_STRING, &lang,   
+		DBUS_TYPE_STRING, &type,
+		DBUS_TYPE_INT32, &profanity,
+		DBUS_TYPE_INT32, &punctuation,
+		DBUS_TYPE_INT32, &silence,
+		DBUS_TYPE_INT32, &hold_ms,
+		DBUS_TYPE_INVALID);
+
+	/* daemon does not reply */
+	dbus_message_set_no_reply(msg, TRUE);
+
+	DBusConnection* conn = __stt_dbus_get_conn();
+
+	int ret = STT_ERROR_NONE;
+	if (NULL == conn || !dbus_connection_send(conn, msg, NULL)) {
+		SLOG(LOG_ERROR, TAG_STTC, ">>>> Fail to send request");
+		ret = STT_ERROR_OPERATION_FAILED;
+	} else {
+		dbus_connection_flush(conn);
+	}
+
+	dbus_message_unref(msg);
+
+	return ret;
+}
+
+/** Send request which has only uid and gets only result */
+int __stt_dbus_request_simple_async(int uid, const char* method, stt_dbus_reply_cb callback, void* user_data, stt_dbus_call_h* call)
+{
+	DBusMessage* msg;
+
+	/* create a signal & check for errors */
+	msg = dbus_message_new_method_call(
+		STT_SERVER_SERVICE_NAME,
+		STT_SERVER_SERVICE_OBJECT_PATH,	
+		STT_SERVER_SERVICE_INTERFACE,	
+		method);
+
+	if (NULL == msg) { 
+		SLOG(LOG_ERROR, TAG_STTC, ">>>> %s : Fail to make message \n", method); 
+		return STT_ERROR_OPERATION_FAILED;
+	} else {
+		SLOG(LOG_DEBUG, TAG_STTC, ">>>> %s : uid(%d)", method, uid);
 	}
 
 	dbus_message_append_args(msg, 
 		DBUS_TYPE_INT32, &uid, 
 		DBUS_TYPE_INVALID);
 
-	DBusError err;
-	dbus_error_init(&err);
+	return __stt_dbus_send_async(msg, g_waiting_time, callback, user_data, call);
+}
 
-	DBusMessage* result_msg;
+int stt_dbus_get_result(DBusMessage* reply)
+{
 	int result = STT_ERROR_OPERATION_FAILED;
 
-	result_msg = dbus_connection_send_with_reply_and_block(g_conn, msg, g_waiting_time, &err);
+	if (NULL != reply) {
+		DBusError err;
+		dbus_error_init(&err);
 
-	if (NULL != result_msg) {
-		dbus_message_get_args(result_msg, &err,
+		dbus_message_get_args(reply, &err,
 			DBUS_TYPE_INT32, &result,
 			DBUS_TYPE_INVALID);
 
 		if (dbus_error_is_set(&err)) { 
-			printf("<<<< Get arguments error (%s)\n", err.message);
+			SLOG(LOG_ERROR, TAG_STTC, "<<<< Get arguments error (%s)", err.message);
 			dbus_error_free(&err); 
 			result = STT_ERROR_OPERATION_FAILED;
 		}
-		dbus_message_unref(result_msg);
 	} else {
 		SLOG(LOG_DEBUG, TAG_STTC, "<<<< Result Message is NULL");
 	}
 
 	if (0 == result) {
-		SLOG(LOG_DEBUG, TAG_STTC, "<<<< stt cancel : result = %d ", result);
+		SLOG(LOG_DEBUG, TAG_STTC, "<<<< result = %d ", result);
 	} else {
-		SLOG(LOG_ERROR, TAG_STTC, "<<<< stt cancel : result = %d ", result);
+		SLOG(LOG_ERROR, TAG_STTC, "<<<< result = %d ", result);
 	}
 
-	dbus_message_unref(msg);
-
 	return result;
 }
 
+int __stt_dbus_request_simple(int uid, const char* method)
+{
+	stt_dbus_sync_s sync = {NULL, STT_ERROR_OPERATION_FAILED};
+	stt_dbus_call_h call = NULL;
+
+	int ret = __stt_dbus_request_simple_async(uid, method, __stt_dbus_sync_reply, &sync, &call);
+	if (0 != ret)
+		return ret;
+
+	__stt_dbus_wait_call(call);
+
+	ret = stt_dbus_get_result(sync.reply);
+
+	if (NULL != sync.reply)
+		dbus_message_unref(sync.reply);
+
+	return ret;
+}
+
+int stt_dbus_request_stop_async(int uid, stt_dbus_reply_cb callback, void* user_data, stt_dbus_call_h* call)
+{
+	return __stt_dbus_request_simple_async(uid, STT_METHOD_STOP, callback, user_data, call);
+}
+
+int stt_dbus_request_stop(int uid)
+{
+	return __stt_dbus_request_simple(uid, STT_METHOD_STOP);
+}
+
+int stt_dbus_request_cancel_async(int uid, stt_dbus_reply_cb callback, void* user_data, stt_dbus_call_h* call)
+{
+	return __stt_dbus_request_simple_async(uid, STT_METHOD_CANCEL, callback, user_data, call);
+}
+
+int stt_dbus_request_cancel(int uid)
+{
+	return __stt_dbus_request_simple(uid, STT_METHOD_CANCEL);
+}
+
 
 int stt_dbus_request_get_audio_volume(int uid, float* volume)
 {
@@ -1008,7 +1803,7 @@ int stt_dbus_request_get_audio_volume(int uid, float* volume)
 	int result = STT_ERROR_OPERATION_FAILED;
 	double vol = 0;
 
-	result_msg = dbus_connection_send_with_reply_and_block(g_conn, msg, g_waiting_time, &err);
+	result_msg = __stt_dbus_send_and_wait(msg, g_waiting_time);
 
 	if (NULL != result_msg) {
 		dbus_message_get_args(result_msg, &err,
@@ -22,14 +22,25 @@
 extern "C" {
 #endif
 
+/** request waiting for reply of daemon */
+typedef struct stt_dbus_call_s* stt_dbus_call_h;
+
+/** Called in main loop when request is completed. reply is NULL if result is not STT_ERROR_NONE */
+typedef void (*stt_dbus_reply_cb)(DBusMessage* reply, int result, void* user_data);
+
 int stt_dbus_open_connection();
 
 int stt_dbus_close_connection();
 
 
-int stt_dbus_request_hello();
+/** Daemon is started by the bus if it is not running. Reply comes when daemon owns its name */
+int stt_dbus_request_hello_async(stt_dbus_reply_cb callback, void* user_data, stt_dbus_call_h* call);
+
+/** Open private connection to daemon found by hello. Requests go through the bus if it fails */
+int stt_dbus_connect_peer();
 
-int stt_dbus_request_initialize(int uid, bool* silence_supported, bool* profanity_supported, bool* punctuation_supported);
+/** capability is valid only if daemon sends it with reply */
+int stt_dbus_request_initialize(int uid, bool* silence_supported, bool* profanity_supported, bool* punctuation_supported, bool* engine_loading, stt_capability_s* capability);
 
 int stt_dbus_request_finalize(int uid);
 
@@ -41,12 +52,37 @@ int stt_dbus_request_get_audio_volume(int uid, float* volume);
 
 int stt_dbus_request_is_partial_result_supported(int uid, bool* partial_result);
 
-int stt_dbus_request_start(int uid, const char* lang, const char* type, int profanity, int punctuation, int silence);
+int stt_dbus_request_start(int uid, const char* lang, const char* type, int profanity, int punctuation, int silence, 
+			   int priority, int wait_timeout, int partial_interval, int* queue_position);
+
+/** Register uid and start recognition in one request. Daemon removes uid when session ends */
+int stt_dbus_request_recognize_once(int uid, const char* lang, const char* type, int profanity, int punctuation, int silence);
+
+/** Prewarm is sent without waiting for reply */
+int stt_dbus_request_prewarm(int uid, const char* lang, const char* type, int profanity, int punctuation, int silence, int hold_ms);
 
 int stt_dbus_request_stop(int uid);
 
 int stt_dbus_request_cancel(int uid);
 
+/* Async requests return at once and callback is called with reply. Blocking requests above wrap them */
+
+int stt_dbus_request_start_async(int uid, const char* lang, const char* type, int profanity, int punctuation, int silence, 
+			   int priority, int wait_timeout, int partial_interval, stt_dbus_reply_cb callback, void* user_data, stt_dbus_call_h* call);
+
+int stt_dbus_request_stop_async(int uid, stt_dbus_reply_cb callback, void* user_data, stt_dbus_call_h* call);
+
+int stt_dbus_request_cancel_async(int uid, stt_dbus_reply_cb callback, void* user_data, stt_dbus_call_h* call);
+
+/** Get result and queue position from reply of start */
+int stt_dbus_get_start_result(DBusMessage* reply, int* queue_position);
+
+/** Get result from reply of stop and cancel */
+int stt_dbus_get_result(DBusMessage* reply);
+
+/** Drop request. Callback is not called */
+int stt_dbus_cancel_call(stt_dbus_call_h call);
+
 
 #ifdef __cplusplus
 }
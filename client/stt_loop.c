@@ -0,0 +1,415 @@
+/*
+*  Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*  http://www.apache.org/licenses/LICENSE-2.0
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+
+
+#include <Ecore.h>
+#include <time.h>
+#include <errno.h>
+#include <stdint.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+
+#include "stt.h"
+#include "stt_loop.h"
+
+#define STT_LOOP_MAX_EVENTS	16
+
+typedef enum {
+	STT_LOOP_SOURCE_FD = 0,
+	STT_LOOP_SOURCE_TIMER,
+	STT_LOOP_SOURCE_CALL
+} stt_loop_source_type_e;
+
+struct stt_loop_source_s {
+	stt_loop_source_type_e	type;
+	int			fd;
+	double			deadline;	/* monotonic msec of timer */
+	stt_loop_cb		callback;
+	void*			data;
+	bool			dispatched;	/* timer or call is running, dispatcher frees it */
+
+	void*			ecore_handle;	/* fd handler, timer or idler of Ecore */
+};
+
+/* sources are on Ecore main loop until application asks for fd */
+static bool g_loop_external = false;
+static int g_ecore_source_count = 0;
+
+/* external loop : epoll fd holds sources, wake fd for calls and timer fd for nearest deadline */
+static int g_loop_epoll = -1;
+static int g_loop_wake = -1;
+static int g_loop_timer = -1;
+
+static GList* g_fd_list = NULL;
+static GList* g_timer_list = NULL;	/* in order of deadline */
+static GList* g_call_list = NULL;
+
+/* sources removed while dispatching are freed at the end of dispatch */
+static bool g_loop_dispatching = false;
+static GList* g_garbage_list = NULL;
+
+/* marker of internal fds in epoll data */
+static int g_wake_marker;
+static int g_timer_marker;
+
+
+double __stt_loop_get_time_ms()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1000000.0;
+}
+
+void __stt_loop_free_source(stt_loop_source_h source)
+{
+	if (true == g_loop_dispatching)
+		g_garbage_list = g_list_append(g_garbage_list, source);
+	else
+		free(source);
+}
+
+/*
+* Ecore main loop
+*/
+
+static Eina_Bool __stt_loop_ecore_fd_cb(void* data, Ecore_Fd_Handler* fd_handler)
+{
+	stt_loop_source_h source = (stt_loop_source_h)data;
+
+	/* handler may be deleted in callback, ecore keeps it until return */
+	source->callback(source->data);
+
+	return ECORE_CALLBACK_RENEW;
+}
+
+static Eina_Bool __stt_loop_ecore_once_cb(void* data)
+{
+	stt_loop_source_h source = (stt_loop_source_h)data;
+
+	source->ecore_handle = NULL;
+	source->dispatched = true;
+	source->callback(source->data);
+
+	free(source);
+	g_ecore_source_count--;
+
+	return EINA_FALSE;
+}
+
+/*
+* External loop
+*/
+
+void __stt_loop_wake()
+{
+	uint64_t value = 1;
+	if (0 > write(g_loop_wake, &value, sizeof(value)))
+		SLOG(LOG_WARN, TAG_STTC, "[WARNING] Fail to wake loop");
+}
+
+void __stt_loop_arm_timer()
+{
+	struct itimerspec spec;
+	memset(&spec, 0, sizeof(spec));
+
+	/* zero value disarms */
+	if (NULL != g_timer_list) {
+		stt_loop_source_h first = g_timer_list->data;
+		double deadline = first->deadline;
+
+		spec.it_value.tv_sec = (time_t)(deadline / 1000);
+		spec.it_value.tv_nsec = (long)((deadline - (double)spec.it_value.tv_sec * 1000) * 1000000);
+	}
+
+	timerfd_settime(g_loop_timer, TFD_TIMER_ABSTIME, &spec, NULL);
+}
+
+gint __stt_loop_compare_deadline(gconstpointer a, gconstpointer b)
+{
+	const struct stt_loop_source_s* timer_a = a;
+	const struct stt_loop_source_s* timer_b = b;
+
+	if (timer_a->deadline == timer_b->deadline)
+		return 0;
+
+	return (timer_a->deadline < timer_b->deadline) ? -1 : 1;
+}
+
+int __stt_loop_add_internal_fd(int fd, void* marker)
+{
+	struct epoll_event event;
+	memset(&event, 0, sizeof(event));
+	event.events = EPOLLIN;
+	event.data.ptr = marker;
+
+	return epoll_ctl(g_loop_epoll, EPOLL_CTL_ADD, fd, &event);
+}
+
+int __stt_loop_open_external()
+{
+	g_loop_epoll = epoll_create1(EPOLL_CLOEXEC);
+	g_loop_wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	g_loop_timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+	if (0 > g_loop_epoll || 0 > g_loop_wake || 0 > g_loop_timer
+		|| 0 != __stt_loop_add_internal_fd(g_loop_wake, &g_wake_marker)
+		|| 0 != __stt_loop_add_internal_fd(g_loop_timer, &g_timer_marker)) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to create loop fd : %s", strerror(errno));
+
+		if (0 <= g_loop_epoll)	close(g_loop_epoll);
+		if (0 <= g_loop_wake)	close(g_loop_wake);
+		if (0 <= g_loop_timer)	close(g_loop_timer);
+
+		g_loop_epoll = g_loop_wake = g_loop_timer = -1;
+		return STT_ERROR_OPERATION_FAILED;
+	}
+
+	return STT_ERROR_NONE;
+}
+
+/*
+* Interfaces
+*/
+
+stt_loop_source_h __stt_loop_new_source(stt_loop_source_type_e type, stt_loop_cb callback, void* data)
+{
+	stt_loop_source_h source = (stt_loop_source_h)calloc(1, sizeof(struct stt_loop_source_s));
+	if (NULL == source) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to allocate memory");
+		return NULL;
+	}
+
+	source->type = type;
+	source->fd = -1;
+	source->callback = callback;
+	source->data = data;
+
+	return source;
+}
+
+stt_loop_source_h stt_loop_add_fd(int fd, stt_loop_cb callback, void* data)
+{
+	stt_loop_source_h source = __stt_loop_new_source(STT_LOOP_SOURCE_FD, callback, data);
+	if (NULL == source)
+		return NULL;
+
+	source->fd = fd;
+
+	if (false == g_loop_external) {
+		source->ecore_handle = ecore_main_fd_handler_add(fd, ECORE_FD_READ, __stt_loop_ecore_fd_cb, source, NULL, NULL);
+	} else {
+		struct epoll_event event;
+		memset(&event, 0, sizeof(event));
+		event.events = EPOLLIN;
+		event.data.ptr = source;
+
+		if (0 == epoll_ctl(g_loop_epoll, EPOLL_CTL_ADD, fd, &event)) {
+			g_fd_list = g_list_append(g_fd_list, source);
+			source->ecore_handle = source;
+		}
+	}
+
+	if (NULL == source->ecore_handle) {
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to watch fd(%d)", fd);
+		free(source);
+		return NULL;
+	}
+
+	if (false == g_loop_external)
+		g_ecore_source_count++;
+
+	return source;
+}
+
+stt_loop_source_h stt_loop_add_timer(int msec, stt_loop_cb callback, void* data)
+{
+	stt_loop_source_h source = __stt_loop_new_source(STT_LOOP_SOURCE_TIMER, callback, data);
+	if (NULL == source)
+		return NULL;
+
+	if (false == g_loop_external) {
+		source->ecore_handle = ecore_timer_add((double)msec / 1000.0, __stt_loop_ecore_once_cb, source);
+		if (NULL == source->ecore_handle) {
+			free(source);
+			return NULL;
+		}
+		g_ecore_source_count++;
+	} else {
+		source->deadline = __stt_loop_get_time_ms() + msec;
+		g_timer_list = g_list_insert_sorted(g_timer_list, source, __stt_loop_compare_deadline);
+
+		if (source == g_timer_list->data)
+			__stt_loop_arm_timer();
+	}
+
+	return source;
+}
+
+stt_loop_source_h stt_loop_add_call(stt_loop_cb callback, void* data)
+{
+	stt_loop_source_h source = __stt_loop_new_source(STT_LOOP_SOURCE_CALL, callback, data);
+	if (NULL == source)
+		return NULL;
+
+	if (false == g_loop_external) {
+		source->ecore_handle = ecore_idler_add(__stt_loop_ecore_once_cb, source);
+		if (NULL == source->ecore_handle) {
+			free(source);
+			return NULL;
+		}
+		g_ecore_source_count++;
+	} else {
+		g_call_list = g_list_append(g_call_list, source);
+		__stt_loop_wake();
+	}
+
+	return source;
+}
+
+void stt_loop_remove(stt_loop_source_h source)
+{
+	if (NULL == source)
+		return;
+
+	/* source removes itself in its callback and is already detached */
+	if (true == source->dispatched)
+		return;
+
+	if (false == g_loop_external) {
+		switch (source->type) {
+		case STT_LOOP_SOURCE_FD:	ecore_main_fd_handler_del(source->ecore_handle);	break;
+		case STT_LOOP_SOURCE_TIMER:	ecore_timer_del(source->ecore_handle);			break;
+		case STT_LOOP_SOURCE_CALL:	ecore_idler_del(source->ecore_handle);			break;
+		}
+
+		free(source);
+		g_ecore_source_count--;
+		return;
+	}
+
+	switch (source->type) {
+	case STT_LOOP_SOURCE_FD:
+		epoll_ctl(g_loop_epoll, EPOLL_CTL_DEL, source->fd, NULL);
+		g_fd_list = g_list_remove(g_fd_list, source);
+		break;
+	case STT_LOOP_SOURCE_TIMER:
+		g_timer_list = g_list_remove(g_timer_list, source);
+		__stt_loop_arm_timer();
+		break;
+	case STT_LOOP_SOURCE_CALL:
+		g_call_list = g_list_remove(g_call_list, source);
+		break;
+	}
+
+	/* ready event of removed fd may be in the batch of dispatch */
+	source->callback = NULL;
+
+	__stt_loop_free_source(source);
+}
+
+int stt_loop_get_fd(int* fd)
+{
+	if (true == g_loop_external) {
+		*fd = g_loop_epoll;
+		return STT_ERROR_NONE;
+	}
+
+	/* sources on Ecore can not be moved */
+	if (0 < g_ecore_source_count)
+		return STT_ERROR_INVALID_STATE;
+
+	if (0 != __stt_loop_open_external())
+		return STT_ERROR_OPERATION_FAILED;
+
+	g_loop_external = true;
+
+	SLOG(LOG_DEBUG, TAG_STTC, "Client library is driven by application loop : fd(%d)", g_loop_epoll);
+
+	*fd = g_loop_epoll;
+	return STT_ERROR_NONE;
+}
+
+int stt_loop_dispatch()
+{
+	if (false == g_loop_external)
+		return STT_ERROR_INVALID_STATE;
+
+	struct epoll_event events[STT_LOOP_MAX_EVENTS];
+	uint64_t value = 0;
+	int i;
+
+	g_loop_dispatching = true;
+
+	/* readable fds */
+	int count = epoll_wait(g_loop_epoll, events, STT_LOOP_MAX_EVENTS, 0);
+
+	for (i = 0; i < count; i++) {
+		if (&g_wake_marker == events[i].data.ptr) {
+			if (0 > read(g_loop_wake, &value, sizeof(value)))
+				value = 0;
+		} else if (&g_timer_marker == events[i].data.ptr) {
+			if (0 > read(g_loop_timer, &value, sizeof(value)))
+				value = 0;
+		} else {
+			stt_loop_source_h source = events[i].data.ptr;
+			if (NULL != source->callback)
+				source->callback(source->data);
+		}
+	}
+
+	/* expired timers */
+	double now = __stt_loop_get_time_ms();
+	while (NULL != g_timer_list) {
+		stt_loop_source_h source = g_timer_list->data;
+		if (source->deadline > now)
+			break;
+
+		g_timer_list = g_list_delete_link(g_timer_list, g_timer_list);
+		source->dispatched = true;
+		source->callback(source->data);
+		__stt_loop_free_source(source);
+	}
+
+	__stt_loop_arm_timer();
+
+	/* calls added until now. Calls added by them wait for next dispatch */
+	GList* calls = g_call_list;
+	g_call_list = NULL;
+
+	while (NULL != calls) {
+		stt_loop_source_h source = calls->data;
+		calls = g_list_delete_link(calls, calls);
+
+		/* removed by earlier call, it is freed as garbage */
+		if (NULL == source->callback)
+			continue;
+
+		source->dispatched = true;
+		source->callback(source->data);
+		__stt_loop_free_source(source);
+	}
+
+	if (NULL != g_call_list)
+		__stt_loop_wake();
+
+	g_loop_dispatching = false;
+
+	while (NULL != g_garbage_list) {
+		free(g_garbage_list->data);
+		g_garbage_list = g_list_delete_link(g_garbage_list, g_garbage_list);
+	}
+
+	return STT_ERROR_NONE;
+}
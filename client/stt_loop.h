@@ -0,0 +1,56 @@
+/*
+*  Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*  http://www.apache.org/licenses/LICENSE-2.0
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+
+
+#ifndef __STT_LOOP_H_
+#define __STT_LOOP_H_
+
+#include "stt_main.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+* Main loop sources of client library.
+* They run on Ecore main loop, or on stt_loop_dispatch() once stt_loop_get_fd() is called.
+*/
+
+typedef void (*stt_loop_cb)(void* data);
+
+typedef struct stt_loop_source_s* stt_loop_source_h;
+
+/** Callback is called whenever fd is readable, until source is removed */
+stt_loop_source_h stt_loop_add_fd(int fd, stt_loop_cb callback, void* data);
+
+/** One-shot timer. Source is freed after callback, so it should not be removed in callback */
+stt_loop_source_h stt_loop_add_timer(int msec, stt_loop_cb callback, void* data);
+
+/** One-shot call in next iteration of loop. Calls run in order they are added */
+stt_loop_source_h stt_loop_add_call(stt_loop_cb callback, void* data);
+
+/** Timer and call are freed after their callback, so removing them in own callback does nothing */
+void stt_loop_remove(stt_loop_source_h source);
+
+/** Switch to loop of application. It is possible only while no source exists */
+int stt_loop_get_fd(int* fd);
+
+/** Run ready sources once without blocking */
+int stt_loop_dispatch();
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* __STT_LOOP_H_ */
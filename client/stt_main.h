@@ -39,6 +39,26 @@ struct stt_s {
 	int handle;
 };
 
+/** 
+* @brief A structure of engine capability cached from daemon
+*/
+typedef struct {
+	bool	valid;		/**< false until daemon reports capability */
+	bool	partial_result;
+	char*	default_lang;
+	GList*	lang_list;
+} stt_capability_s;
+
+/** 
+* @brief A structure of recognition result. Pointer array and strings follow it in the same allocation
+*/
+typedef struct {
+	char*	type;
+	char*	msg;
+	char**	data_list;	/**< NULL if data_count is 0 */
+	int	data_count;
+} stt_result_s;
+
 
 #ifdef __cplusplus
 }
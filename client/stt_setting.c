@@ -12,8 +12,6 @@
 */
 
 
-#include <sys/wait.h>
-
 #include "stt_main.h"
 #include "stt_setting.h"
 #include "stt_setting_dbus.h"
@@ -22,7 +20,6 @@
 
 static bool g_is_setting_initialized = false;
 
-static int __check_stt_daemon();
 
 int stt_setting_initialize ()
 {
@@ -43,9 +40,13 @@ int stt_setting_initialize ()
 		return STT_SETTING_ERROR_OPERATION_FAILED;
 	}
 
-	/* Send hello */
+	/* Send hello. Bus starts daemon if it is not running and answers when daemon is ready */
 	if (0 != stt_setting_dbus_request_hello()) {
-		__check_stt_daemon();
+		SLOG(LOG_ERROR, TAG_STTC, "[ERROR] Fail to find daemon");
+		stt_setting_dbus_close_connection();
+		SLOG(LOG_DEBUG, TAG_STTC, "=====");
+		SLOG(LOG_DEBUG, TAG_STTC, " ");
+		return STT_SETTING_ERROR_TIMED_OUT;
 	}
 
 	/* do request */
@@ -543,94 +544,3 @@ int stt_setting_set_engine_setting(const char* key, const char* value)
 	return ret;
 }
 
-static bool __stt_is_alive()
-{
-	FILE *fp = NULL;
-	char buff[256] = {'\0',};
-	char cmd[256] = {'\0',};
-
-	memset(buff, '\0', sizeof(char) * 256);
-	memset(cmd, '\0', sizeof(char) * 256);
-
-	fp = popen("ps", "r");
-	if (NULL == fp) {
-		SLOG(LOG_DEBUG, TAG_STTC, "[STT SETTING ERROR] popen error \n");
-		return FALSE;
-	}
-
-	while (fgets(buff, 255, fp)) {
-		strcpy(cmd, buff + 26);
-
-		if( 0 == strncmp(cmd, "[stt-daemon]", strlen("[stt-daemon]")) ||
-		0 == strncmp(cmd, "stt-daemon", strlen("stt-daemon")) ||
-		0 == strncmp(cmd, "/usr/bin/stt-daemon", strlen("/usr/bin/stt-daemon"))) {
-			SLOG(LOG_DEBUG, TAG_STTC, "stt-daemon is ALIVE !! \n");
-			fclose(fp);
-			return TRUE;
-		}
-	}
-
-	fclose(fp);
-
-	SLOG(LOG_DEBUG, TAG_STTC, "THERE IS NO stt-daemon !! \n");
-
-	return FALSE;
-}
-
-static void __my_sig_child(int signo, siginfo_t *info, void *data)
-{
-	int status = 0;
-	pid_t child_pid, child_pgid;
-
-	child_pgid = getpgid(info->si_pid);
-	SLOG(LOG_DEBUG, TAG_STTC, "Signal handler: dead pid = %d, pgid = %d\n", info->si_pid, child_pgid);
-
-	while ((child_pid = waitpid(-1, &status, WNOHANG)) > 0) {
-		if(child_pid == child_pgid)
-			killpg(child_pgid, SIGKILL);
-	}
-
-	return;
-}
-
-int __check_stt_daemon()
-{
-	if (TRUE == __stt_is_alive()) 
-		return 0;
-	
-	/* fork-exec stt-daemom */
-	int pid = 0, i = 0;
-	struct sigaction act, dummy;
-	act.sa_handler = NULL;
-	act.sa_sigaction = __my_sig_child;
-	sigemptyset(&act.sa_mask);
-	act.sa_flags = SA_NOCLDSTOP | SA_SIGINFO;
-	
-	if (sigaction(SIGCHLD, &act, &dummy) < 0) {
-		SLOG(LOG_ERROR, TAG_STTC, "%s\n", "Cannot make a signal handler\n");
-		return -1;
-	}
-
-	pid = fork();
-
-	switch(pid) {
-	case -1:
-		SLOG(LOG_DEBUG, TAG_STTC, "Fail to create stt-daemon");
-		break;
-
-	case 0:
-		setsid();
-		for( i = 0 ; i < _NSIG ; i++ )
-			signal(i, SIG_DFL);
-
-		execl("/usr/bin/stt-daemon", "/usr/bin/stt-daemon", NULL);
-		break;
-
-	default:
-		sleep(1);
-		break;
-	}
-
-	return 0;
-}
-
@@ -113,7 +113,10 @@ int stt_setting_dbus_request_hello()
 	DBusMessage* result_msg = NULL;
 	int result = 0;
 
-	result_msg = dbus_connection_send_with_reply_and_block(g_conn, msg, 500, &err);
+	/* bus starts daemon by service file and holds hello until daemon owns its name */
+	dbus_message_set_auto_start(msg, TRUE);
+
+	result_msg = dbus_connection_send_with_reply_and_block(g_conn, msg, STT_DAEMON_ACTIVATION_TIMEOUT, &err);
 
 	dbus_message_unref(msg);
 
@@ -159,7 +162,8 @@ int stt_setting_dbus_request_initialize()
 	DBusMessage* result_msg;
 	int result = STT_SETTING_ERROR_OPERATION_FAILED;
 
-	result_msg = dbus_connection_send_with_reply_and_block(g_conn, msg, g_waiting_time, &err);
+	/* daemon replies after engine is loaded */
+	result_msg = dbus_connection_send_with_reply_and_block(g_conn, msg, STT_DAEMON_ACTIVATION_TIMEOUT, &err);
 
 	if (NULL != result_msg) {
 		dbus_message_get_args(result_msg, &err, DBUS_TYPE_INT32, &result, DBUS_TYPE_INVALID);
@@ -35,12 +35,25 @@ extern "C" {
 #define STT_SERVER_SERVICE_OBJECT_PATH  "/com/samsung/voice/sttserver"
 #define STT_SERVER_SERVICE_INTERFACE    "com.samsung.voice.sttserver"
 
+/* msec for the bus to start daemon by service file and daemon to own its name */
+#define STT_DAEMON_ACTIVATION_TIMEOUT	10000
+
+/* private peer-to-peer connection of client and daemon. Directory is owned by root and group of clients */
+#define STT_PEER_SOCKET_DIR		"/run/stt"
+#define STT_PEER_SOCKET_PATH		"/run/stt/daemon-peer"
+#define STT_PEER_ADDRESS		"unix:path=/run/stt/daemon-peer"
+#define STT_PEER_SOCKET_GROUP		"app"
+
+/* result passed as memfd is not bigger than this */
+#define STT_RESULT_FD_MAX_SIZE		(16 * 1024 * 1024)
+
 
 /******************************************************************************************
 * Message Definition for Client
 *******************************************************************************************/
 
 #define STT_METHOD_HELLO		"stt_method_hello"
+#define STT_METHOD_PEER_HELLO		"stt_method_peer_hello"
 #define STT_METHOD_INITIALIZE		"stt_method_initialize"
 #define STT_METHOD_FINALIZE		"stt_method_finalilze"
 #define STT_METHOD_GET_SUPPORT_LANGS	"stt_method_get_support_langs"
@@ -51,6 +64,8 @@ extern "C" {
 #define STT_METHOD_START		"stt_method_start"
 #define STT_METHOD_STOP			"stt_method_stop"
 #define STT_METHOD_CANCEL		"stt_method_cancel"
+#define STT_METHOD_PREWARM		"stt_method_prewarm"
+#define STT_METHOD_RECOGNIZE_ONCE	"stt_method_recognize_once"
 
 #define STTD_METHOD_RESULT		"sttd_method_result"
 #define STTD_METHOD_PARTIAL_RESULT	"sttd_method_partial_result"
@@ -58,6 +73,9 @@ extern "C" {
 #define STTD_METHOD_HELLO		"sttd_method_hello"
 #define STTD_METHOD_SET_STATE		"sttd_method_set_state"
 #define STTD_METHOD_GET_STATE		"sttd_method_get_state"
+#define STTD_METHOD_ENGINE_READY	"sttd_method_engine_ready"
+#define STTD_METHOD_ENGINE_CHANGED	"sttd_method_engine_changed"
+#define STTD_METHOD_QUEUE_POSITION	"sttd_method_queue_position"
 
 #define STTD_METHOD_STOP_BY_DAEMON	"sttd_method_stop_by_daemon"
 
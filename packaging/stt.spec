@@ -62,6 +62,7 @@ rm -rf %{buildroot}
 %{_libdir}/libstt_setting.so
 %{_libdir}/voice/stt/1.0/sttd.conf
 %{_bindir}/stt-daemon
+%{_datadir}/dbus-1/system-services/service.connect.sttserver.service
 
 
 %files devel
@@ -0,0 +1,808 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*  http://www.apache.org/licenses/LICENSE-2.0
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+
+
+/*
+* Mock engine for benchmarking and deterministic testing of the daemon.
+*
+* Behaviour is controlled by environment variables read on load and by engine settings
+* (stt_setting_set_engine_setting) at run time. Keys are same as engine setting keys.
+*
+*   STT_MOCK_LOAD_MS		Time to initialize engine (ms)
+*   STT_MOCK_OPTION_MS		Time to apply one option setter (ms)
+*   STT_MOCK_DECODE_MS		Decode time per second of audio after stop (ms)
+*   STT_MOCK_PARTIAL_MS		Audio length between partial results (ms, 0 = no partial result)
+*   STT_MOCK_SILENCE_MS		Audio length until silence is detected (ms, 0 = no silence detection)
+*   STT_MOCK_RESULT_COUNT	Count of result texts
+*   STT_MOCK_RESULT_LEN		Length of each result text
+*   STT_MOCK_FOOTPRINT_KB	Memory held by engine while loaded (kB)
+*   STT_MOCK_FAIL		Failure point : none, load, init, start, audio, stop, result
+*   STT_MOCK_FAIL_RATE		Failure probability of the failure point (%)
+*   STT_MOCK_SEED		Seed of failure injection
+*   STT_MOCK_MAX_SESSIONS	Count of concurrent sessions (1 = single session engine)
+*/
+
+#include <Ecore.h>
+#include <dlog.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "sttp.h"
+
+#define TAG_STT_MOCK	"sttmock"
+
+#define MOCK_ENGINE_UUID	"8E5C2C40-6D8B-4A57-9C2B-5354544D4F43"
+#define MOCK_ENGINE_NAME	"Mock STT Engine"
+
+#define MOCK_SAMPLE_RATE	16000
+#define MOCK_CHANNELS		1
+#define MOCK_BYTES_PER_MS	(MOCK_SAMPLE_RATE * MOCK_CHANNELS * 2 / 1000)
+
+#define MOCK_SESSION_LIMIT	16
+
+typedef enum {
+	MOCK_FAIL_NONE = 0,
+	MOCK_FAIL_LOAD,
+	MOCK_FAIL_INIT,
+	MOCK_FAIL_START,
+	MOCK_FAIL_AUDIO,
+	MOCK_FAIL_STOP,
+	MOCK_FAIL_RESULT
+} mock_fail_e;
+
+typedef struct {
+	const char*	key;
+	int*		value;
+} mock_param_s;
+
+typedef struct {
+	int		id;		/* 0 if not used */
+	bool		recording;
+	char*		type;
+	void*		user_data;
+	unsigned int	audio_bytes;
+	int		partial_count;
+	bool		silence_sent;
+	Ecore_Timer*	decode_timer;
+} mock_session_s;
+
+/* simulated behaviour */
+static int g_load_ms = 0;
+static int g_option_ms = 0;
+static int g_decode_ms = 200;
+static int g_partial_ms = 500;
+static int g_silence_ms = 0;
+static int g_result_count = 1;
+static int g_result_len = 16;
+static int g_footprint_kb = 0;
+static int g_fail = MOCK_FAIL_NONE;
+static int g_fail_rate = 100;
+static int g_seed = 1;
+static int g_max_sessions = 1;
+
+static mock_param_s g_params[] = {
+	{"STT_MOCK_LOAD_MS",		&g_load_ms},
+	{"STT_MOCK_OPTION_MS",		&g_option_ms},
+	{"STT_MOCK_DECODE_MS",		&g_decode_ms},
+	{"STT_MOCK_PARTIAL_MS",		&g_partial_ms},
+	{"STT_MOCK_SILENCE_MS",		&g_silence_ms},
+	{"STT_MOCK_RESULT_COUNT",	&g_result_count},
+	{"STT_MOCK_RESULT_LEN",		&g_result_len},
+	{"STT_MOCK_FOOTPRINT_KB",	&g_footprint_kb},
+	{"STT_MOCK_FAIL",		&g_fail},
+	{"STT_MOCK_FAIL_RATE",		&g_fail_rate},
+	{"STT_MOCK_SEED",		&g_seed},
+	{"STT_MOCK_MAX_SESSIONS",	&g_max_sessions},
+	{NULL,				NULL}
+};
+
+static const char* g_fail_names[] = {"none", "load", "init", "start", "audio", "stop", "result", NULL};
+
+static const char* g_langs[] = {"en_US", "ko_KR", NULL};
+
+/* engine state */
+static bool g_initialized = false;
+
+static sttpe_result_cb g_result_cb = NULL;
+static sttpe_partial_result_cb g_partial_result_cb = NULL;
+static sttpe_silence_detected_cb g_silence_cb = NULL;
+
+static bool g_profanity = true;
+static bool g_punctuation = false;
+static bool g_silence = true;
+
+static char* g_footprint = NULL;
+static unsigned int g_rand_state = 1;
+
+/* recognition sessions : audio is set from recorder thread */
+static pthread_mutex_t g_session_mutex = PTHREAD_MUTEX_INITIALIZER;
+static mock_session_s g_sessions[MOCK_SESSION_LIMIT];
+static int g_last_session_id = 0;
+
+/* session of single session functions */
+static mock_session_s* g_default_session = NULL;
+
+static int __mock_parse_fail(const char* value)
+{
+	int i;
+	for (i = 0; NULL != g_fail_names[i]; i++) {
+		if (0 == strcmp(value, g_fail_names[i]))
+			return i;
+	}
+
+	return atoi(value);
+}
+
+static int __mock_set_param(const char* key, const char* value)
+{
+	int i;
+	for (i = 0; NULL != g_params[i].key; i++) {
+		if (0 == strcmp(key, g_params[i].key)) {
+			if (&g_fail == g_params[i].value) {
+				*g_params[i].value = __mock_parse_fail(value);
+			} else {
+				*g_params[i].value = atoi(value);
+			}
+
+			if (&g_seed == g_params[i].value) {
+				g_rand_state = (unsigned int)g_seed;
+			}
+
+			SLOG(LOG_DEBUG, TAG_STT_MOCK, "[Mock] Set %s : %d", key, *g_params[i].value);
+			return STTP_ERROR_NONE;
+		}
+	}
+
+	return STTP_ERROR_INVALID_PARAMETER;
+}
+
+static void __mock_read_env()
+{
+	int i;
+	char* value;
+	for (i = 0; NULL != g_params[i].key; i++) {
+		value = getenv(g_params[i].key);
+		if (NULL != value) {
+			__mock_set_param(g_params[i].key, value);
+		}
+	}
+
+	g_rand_state = (unsigned int)g_seed;
+}
+
+static bool __mock_should_fail(mock_fail_e point)
+{
+	if (point != g_fail)
+		return false;
+
+	if (100 <= g_fail_rate)
+		return true;
+
+	return (int)(rand_r(&g_rand_state) % 100) < g_fail_rate;
+}
+
+static void __mock_delay(int ms)
+{
+	if (0 < ms)
+		usleep(ms * 1000);
+}
+
+static void __mock_alloc_footprint()
+{
+	if (NULL != g_footprint || 0 >= g_footprint_kb)
+		return;
+
+	/* touch pages to make them resident */
+	g_footprint = (char*)malloc(g_footprint_kb * 1024);
+	if (NULL != g_footprint) {
+		memset(g_footprint, 0x5A, g_footprint_kb * 1024);
+	}
+}
+
+static void __mock_free_footprint()
+{
+	if (NULL != g_footprint) {
+		free(g_footprint);
+		g_footprint = NULL;
+	}
+}
+
+static int __mock_max_sessions()
+{
+	if (1 > g_max_sessions)
+		return 1;
+	if (MOCK_SESSION_LIMIT < g_max_sessions)
+		return MOCK_SESSION_LIMIT;
+	return g_max_sessions;
+}
+
+/* It should be called with lock */
+static mock_session_s* __mock_session_find(int id)
+{
+	int i;
+	for (i = 0; i < MOCK_SESSION_LIMIT; i++) {
+		if (0 != id && id == g_sessions[i].id)
+			return &g_sessions[i];
+	}
+
+	return NULL;
+}
+
+/* It should be called with lock */
+static mock_session_s* __mock_session_alloc()
+{
+	int i;
+	int used = 0;
+	mock_session_s* empty = NULL;
+
+	for (i = 0; i < MOCK_SESSION_LIMIT; i++) {
+		if (0 != g_sessions[i].id)
+			used++;
+		else if (NULL == empty)
+			empty = &g_sessions[i];
+	}
+
+	if (used >= __mock_max_sessions() || NULL == empty)
+		return NULL;
+
+	memset(empty, 0, sizeof(mock_session_s));
+	empty->id = ++g_last_session_id;
+
+	return empty;
+}
+
+static void __mock_session_release(mock_session_s* session)
+{
+	pthread_mutex_lock(&g_session_mutex);
+	Ecore_Timer* timer = session->decode_timer;
+	session->decode_timer = NULL;
+	pthread_mutex_unlock(&g_session_mutex);
+
+	if (NULL != timer)
+		ecore_timer_del(timer);
+
+	pthread_mutex_lock(&g_session_mutex);
+	if (NULL != session->type)
+		free(session->type);
+	if (session == g_default_session)
+		g_default_session = NULL;
+	memset(session, 0, sizeof(mock_session_s));
+	pthread_mutex_unlock(&g_session_mutex);
+}
+
+/*
+* Callbacks to the daemon are called in main loop
+*/
+
+static void __mock_partial_result_async(void* data)
+{
+	int id = (int)(intptr_t)data;
+
+	pthread_mutex_lock(&g_session_mutex);
+	mock_session_s* session = __mock_session_find(id);
+	if (NULL == session || false == session->recording) {
+		pthread_mutex_unlock(&g_session_mutex);
+		return;
+	}
+	int count = session->partial_count;
+	void* user_data = session->user_data;
+	pthread_mutex_unlock(&g_session_mutex);
+
+	char text[64];
+	snprintf(text, sizeof(text), "mock partial %d", count);
+
+	if (NULL != g_partial_result_cb)
+		g_partial_result_cb(STTP_RESULT_EVENT_SUCCESS, text, user_data);
+}
+
+static void __mock_silence_async(void* data)
+{
+	int id = (int)(intptr_t)data;
+
+	pthread_mutex_lock(&g_session_mutex);
+	mock_session_s* session = __mock_session_find(id);
+	if (NULL == session || false == session->recording) {
+		pthread_mutex_unlock(&g_session_mutex);
+		return;
+	}
+	void* user_data = session->user_data;
+	pthread_mutex_unlock(&g_session_mutex);
+
+	if (NULL != g_silence_cb)
+		g_silence_cb(user_data);
+}
+
+static Eina_Bool __mock_decode_done(void* data)
+{
+	int id = (int)(intptr_t)data;
+
+	pthread_mutex_lock(&g_session_mutex);
+	mock_session_s* session = __mock_session_find(id);
+	if (NULL == session) {
+		pthread_mutex_unlock(&g_session_mutex);
+		return EINA_FALSE;
+	}
+	char* type = session->type;
+	void* user_data = session->user_data;
+	session->type = NULL;
+	session->decode_timer = NULL;
+	pthread_mutex_unlock(&g_session_mutex);
+
+	/* session is released before result callback because the daemon can start new one in callback */
+	__mock_session_release(session);
+
+	if (true == __mock_should_fail(MOCK_FAIL_RESULT)) {
+		SLOG(LOG_DEBUG, TAG_STT_MOCK, "[Mock] Inject result error");
+		g_result_cb(STTP_RESULT_EVENT_ERROR, type, NULL, 0, STTP_RESULT_MESSAGE_ERROR_TOO_SHORT, user_data);
+		free(type);
+		return EINA_FALSE;
+	}
+
+	if (0 >= g_result_count) {
+		g_result_cb(STTP_RESULT_EVENT_NO_RESULT, type, NULL, 0, STTP_RESULT_MESSAGE_NONE, user_data);
+		free(type);
+		return EINA_FALSE;
+	}
+
+	char** texts = (char**)calloc(g_result_count, sizeof(char*));
+	int i;
+	int len = (0 < g_result_len) ? g_result_len : 1;
+
+	for (i = 0; NULL != texts && i < g_result_count; i++) {
+		texts[i] = (char*)malloc(len + 1);
+		if (NULL == texts[i])
+			break;
+		memset(texts[i], 'a' + (i % 26), len);
+		texts[i][len] = '\0';
+	}
+
+	if (NULL == texts || i < g_result_count) {
+		g_result_cb(STTP_RESULT_EVENT_ERROR, type, NULL, 0, STTP_RESULT_MESSAGE_NONE, user_data);
+	} else {
+		g_result_cb(STTP_RESULT_EVENT_SUCCESS, type, (const char**)texts, g_result_count, STTP_RESULT_MESSAGE_NONE, user_data);
+	}
+
+	if (NULL != texts) {
+		for (i = 0; i < g_result_count; i++) {
+			if (NULL != texts[i])
+				free(texts[i]);
+		}
+		free(texts);
+	}
+	free(type);
+
+	return EINA_FALSE;
+}
+
+/*
+* Engine functions
+*/
+
+static int mock_initialize(sttpe_result_cb result_cb, sttpe_partial_result_cb partial_result_cb, sttpe_silence_detected_cb silence_cb)
+{
+	if (NULL == result_cb || NULL == partial_result_cb || NULL == silence_cb)
+		return STTP_ERROR_INVALID_PARAMETER;
+
+	if (true == g_initialized)
+		return STTP_ERROR_INVALID_STATE;
+
+	__mock_delay(g_load_ms);
+
+	if (true == __mock_should_fail(MOCK_FAIL_INIT)) {
+		SLOG(LOG_DEBUG, TAG_STT_MOCK, "[Mock] Inject initialize error");
+		return STTP_ERROR_OPERATION_FAILED;
+	}
+
+	__mock_alloc_footprint();
+
+	g_result_cb = result_cb;
+	g_partial_result_cb = partial_result_cb;
+	g_silence_cb = silence_cb;
+	g_initialized = true;
+
+	return STTP_ERROR_NONE;
+}
+
+static int mock_deinitialize()
+{
+	if (false == g_initialized)
+		return STTP_ERROR_INVALID_STATE;
+
+	int i;
+	for (i = 0; i < MOCK_SESSION_LIMIT; i++) {
+		if (0 != g_sessions[i].id)
+			__mock_session_release(&g_sessions[i]);
+	}
+
+	__mock_free_footprint();
+
+	g_initialized = false;
+
+	return STTP_ERROR_NONE;
+}
+
+static int mock_foreach_langs(sttpe_supported_language_cb callback, void* user_data)
+{
+	if (NULL == callback)
+		return STTP_ERROR_INVALID_PARAMETER;
+
+	int i;
+	for (i = 0; NULL != g_langs[i]; i++) {
+		if (false == callback(g_langs[i], user_data))
+			break;
+	}
+
+	return STTP_ERROR_NONE;
+}
+
+static bool mock_is_valid_lang(const char* language)
+{
+	if (NULL == language)
+		return false;
+
+	int i;
+	for (i = 0; NULL != g_langs[i]; i++) {
+		if (0 == strcmp(language, g_langs[i]))
+			return true;
+	}
+
+	return false;
+}
+
+static bool mock_support_silence()
+{
+	return (0 < g_silence_ms);
+}
+
+static bool mock_support_partial_result()
+{
+	return (0 < g_partial_ms);
+}
+
+static int mock_get_audio_format(sttp_audio_type_e* types, int* rate, int* channels)
+{
+	if (NULL == types || NULL == rate || NULL == channels)
+		return STTP_ERROR_INVALID_PARAMETER;
+
+	*types = STTP_AUDIO_TYPE_PCM_S16_LE;
+	*rate = MOCK_SAMPLE_RATE;
+	*channels = MOCK_CHANNELS;
+
+	return STTP_ERROR_NONE;
+}
+
+static int mock_set_profanity_filter(bool value)
+{
+	__mock_delay(g_option_ms);
+	g_profanity = value;
+	return STTP_ERROR_NONE;
+}
+
+static int mock_set_punctuation(bool value)
+{
+	__mock_delay(g_option_ms);
+	g_punctuation = value;
+	return STTP_ERROR_NONE;
+}
+
+static int mock_set_silence_detection(bool value)
+{
+	if (0 >= g_silence_ms)
+		return STTP_ERROR_NOT_SUPPORTED_FEATURE;
+
+	__mock_delay(g_option_ms);
+	g_silence = value;
+	return STTP_ERROR_NONE;
+}
+
+static int mock_session_start(const char* language, const char* type, void* user_data, void** session)
+{
+	if (NULL == language || NULL == type || NULL == session)
+		return STTP_ERROR_INVALID_PARAMETER;
+
+	if (false == g_initialized)
+		return STTP_ERROR_INVALID_STATE;
+
+	if (false == mock_is_valid_lang(language))
+		return STTP_ERROR_INVALID_LANGUAGE;
+
+	if (true == __mock_should_fail(MOCK_FAIL_START)) {
+		SLOG(LOG_DEBUG, TAG_STT_MOCK, "[Mock] Inject start error");
+		return STTP_ERROR_OPERATION_FAILED;
+	}
+
+	/* caches may be released by shrink_memory */
+	__mock_alloc_footprint();
+
+	pthread_mutex_lock(&g_session_mutex);
+	mock_session_s* temp = __mock_session_alloc();
+	if (NULL == temp) {
+		pthread_mutex_unlock(&g_session_mutex);
+		SLOG(LOG_DEBUG, TAG_STT_MOCK, "[Mock] No more session : max(%d)", __mock_max_sessions());
+		return STTP_ERROR_INVALID_STATE;
+	}
+	temp->type = strdup(type);
+	temp->user_data = user_data;
+	temp->recording = true;
+	pthread_mutex_unlock(&g_session_mutex);
+
+	*session = temp;
+
+	return STTP_ERROR_NONE;
+}
+
+static int mock_session_set_recording(void* session, const void* data, unsigned int length)
+{
+	mock_session_s* temp = (mock_session_s*)session;
+
+	if (NULL == temp || NULL == data)
+		return STTP_ERROR_INVALID_PARAMETER;
+
+	pthread_mutex_lock(&g_session_mutex);
+	if (0 == temp->id || false == temp->recording) {
+		pthread_mutex_unlock(&g_session_mutex);
+		return STTP_ERROR_INVALID_STATE;
+	}
+
+	if (true == __mock_should_fail(MOCK_FAIL_AUDIO)) {
+		pthread_mutex_unlock(&g_session_mutex);
+		SLOG(LOG_DEBUG, TAG_STT_MOCK, "[Mock] Inject audio error");
+		return STTP_ERROR_OPERATION_FAILED;
+	}
+
+	temp->audio_bytes += length;
+	int audio_ms = temp->audio_bytes / MOCK_BYTES_PER_MS;
+	int id = temp->id;
+
+	bool partial = false;
+	if (0 < g_partial_ms && audio_ms / g_partial_ms > temp->partial_count) {
+		temp->partial_count = audio_ms / g_partial_ms;
+		partial = true;
+	}
+
+	bool silence = false;
+	if (0 < g_silence_ms && true == g_silence && false == temp->silence_sent && audio_ms >= g_silence_ms) {
+		temp->silence_sent = true;
+		silence = true;
+	}
+	pthread_mutex_unlock(&g_session_mutex);
+
+	if (true == partial)
+		ecore_main_loop_thread_safe_call_async(__mock_partial_result_async, (void*)(intptr_t)id);
+
+	if (true == silence)
+		ecore_main_loop_thread_safe_call_async(__mock_silence_async, (void*)(intptr_t)id);
+
+	return STTP_ERROR_NONE;
+}
+
+static int mock_session_stop(void* session)
+{
+	mock_session_s* temp = (mock_session_s*)session;
+
+	if (NULL == temp)
+		return STTP_ERROR_INVALID_PARAMETER;
+
+	pthread_mutex_lock(&g_session_mutex);
+	if (0 == temp->id || false == temp->recording) {
+		pthread_mutex_unlock(&g_session_mutex);
+		return STTP_ERROR_INVALID_STATE;
+	}
+
+	/* no more audio. result is sent after simulated decode time */
+	temp->recording = false;
+	int audio_ms = temp->audio_bytes / MOCK_BYTES_PER_MS;
+	int id = temp->id;
+	pthread_mutex_unlock(&g_session_mutex);
+
+	if (true == __mock_should_fail(MOCK_FAIL_STOP)) {
+		SLOG(LOG_DEBUG, TAG_STT_MOCK, "[Mock] Inject stop error");
+		__mock_session_release(temp);
+		return STTP_ERROR_OPERATION_FAILED;
+	}
+
+	double decode_time = (double)g_decode_ms * audio_ms / 1000 / 1000;
+
+	SLOG(LOG_DEBUG, TAG_STT_MOCK, "[Mock] Stop session(%d) : audio(%d ms), decode(%f sec)", id, audio_ms, decode_time);
+
+	Ecore_Timer* timer = ecore_timer_add(decode_time, __mock_decode_done, (void*)(intptr_t)id);
+	if (NULL == timer) {
+		__mock_decode_done((void*)(intptr_t)id);
+		return STTP_ERROR_NONE;
+	}
+
+	/* timer is read with lock by result and release */
+	pthread_mutex_lock(&g_session_mutex);
+	temp->decode_timer = timer;
+	pthread_mutex_unlock(&g_session_mutex);
+
+	return STTP_ERROR_NONE;
+}
+
+static int mock_session_cancel(void* session)
+{
+	mock_session_s* temp = (mock_session_s*)session;
+
+	if (NULL == temp)
+		return STTP_ERROR_INVALID_PARAMETER;
+
+	if (0 != temp->id)
+		__mock_session_release(temp);
+
+	return STTP_ERROR_NONE;
+}
+
+static int mock_get_max_sessions(int* count)
+{
+	if (NULL == count)
+		return STTP_ERROR_INVALID_PARAMETER;
+
+	*count = __mock_max_sessions();
+
+	return STTP_ERROR_NONE;
+}
+
+/* single session functions use default session */
+
+static int mock_start(const char* language, const char* type, void *user_data)
+{
+	if (NULL != g_default_session)
+		return STTP_ERROR_INVALID_STATE;
+
+	void* session = NULL;
+	int ret = mock_session_start(language, type, user_data, &session);
+	if (STTP_ERROR_NONE == ret)
+		g_default_session = (mock_session_s*)session;
+
+	return ret;
+}
+
+static int mock_set_recording(const void* data, unsigned int length)
+{
+	mock_session_s* session = g_default_session;
+
+	if (NULL == session)
+		return STTP_ERROR_INVALID_STATE;
+
+	return mock_session_set_recording(session, data, length);
+}
+
+static int mock_stop()
+{
+	if (NULL == g_default_session)
+		return STTP_ERROR_INVALID_STATE;
+
+	return mock_session_stop(g_default_session);
+}
+
+static int mock_cancel()
+{
+	if (NULL == g_default_session)
+		return STTP_ERROR_NONE;
+
+	return mock_session_cancel(g_default_session);
+}
+
+static int mock_foreach_engine_settings(sttpe_engine_setting_cb callback, void* user_data)
+{
+	if (NULL == callback)
+		return STTP_ERROR_INVALID_PARAMETER;
+
+	int i;
+	char value[16];
+	for (i = 0; NULL != g_params[i].key; i++) {
+		snprintf(value, sizeof(value), "%d", *g_params[i].value);
+		if (false == callback(g_params[i].key, value, user_data))
+			break;
+	}
+
+	return STTP_ERROR_NONE;
+}
+
+static int mock_set_engine_setting(const char* key, const char* value)
+{
+	if (NULL == key || NULL == value)
+		return STTP_ERROR_INVALID_PARAMETER;
+
+	return __mock_set_param(key, value);
+}
+
+static int mock_shrink_memory()
+{
+	int i;
+	for (i = 0; i < MOCK_SESSION_LIMIT; i++) {
+		if (0 != g_sessions[i].id)
+			return STTP_ERROR_INVALID_STATE;
+	}
+
+	__mock_free_footprint();
+
+	return STTP_ERROR_NONE;
+}
+
+/*
+* Plugin interface
+*/
+
+int sttp_get_engine_info(sttpe_engine_info_cb callback, void* user_data)
+{
+	if (NULL == callback)
+		return STTP_ERROR_INVALID_PARAMETER;
+
+	callback(MOCK_ENGINE_UUID, MOCK_ENGINE_NAME, "", false, user_data);
+
+	return STTP_ERROR_NONE;
+}
+
+int sttp_load_engine(sttpd_funcs_s* pdfuncs, sttpe_funcs_s* pefuncs)
+{
+	if (NULL == pdfuncs || NULL == pefuncs)
+		return STTP_ERROR_INVALID_PARAMETER;
+
+	__mock_read_env();
+
+	if (true == __mock_should_fail(MOCK_FAIL_LOAD)) {
+		SLOG(LOG_DEBUG, TAG_STT_MOCK, "[Mock] Inject load error");
+		return STTP_ERROR_OPERATION_FAILED;
+	}
+
+	pefuncs->size = sizeof(sttpe_funcs_s);
+	pefuncs->version = 1;
+
+	pefuncs->initialize = mock_initialize;
+	pefuncs->deinitialize = mock_deinitialize;
+
+	pefuncs->foreach_langs = mock_foreach_langs;
+	pefuncs->is_valid_lang = mock_is_valid_lang;
+	pefuncs->support_silence = mock_support_silence;
+	pefuncs->support_partial_result = mock_support_partial_result;
+	pefuncs->get_audio_format = mock_get_audio_format;
+
+	pefuncs->set_profanity_filter = mock_set_profanity_filter;
+	pefuncs->set_punctuation = mock_set_punctuation;
+	pefuncs->set_silence_detection = mock_set_silence_detection;
+
+	pefuncs->start = mock_start;
+	pefuncs->set_recording = mock_set_recording;
+	pefuncs->stop = mock_stop;
+	pefuncs->cancel = mock_cancel;
+
+	pefuncs->foreach_engine_settings = mock_foreach_engine_settings;
+	pefuncs->set_engine_setting = mock_set_engine_setting;
+
+	pefuncs->shrink_memory = mock_shrink_memory;
+
+	pefuncs->get_max_sessions = mock_get_max_sessions;
+	pefuncs->session_start = mock_session_start;
+	pefuncs->session_set_recording = mock_session_set_recording;
+	pefuncs->session_stop = mock_session_stop;
+	pefuncs->session_cancel = mock_session_cancel;
+
+	SLOG(LOG_DEBUG, TAG_STT_MOCK, "[Mock] Engine loaded : decode(%d ms/sec), partial(%d ms), silence(%d ms), result(%d x %d), footprint(%d kB), fail(%s, %d%%), sessions(%d)",
+		g_decode_ms, g_partial_ms, g_silence_ms, g_result_count, g_result_len, g_footprint_kb,
+		(0 <= g_fail && MOCK_FAIL_RESULT >= g_fail) ? g_fail_names[g_fail] : "unknown", g_fail_rate, __mock_max_sessions());
+
+	return STTP_ERROR_NONE;
+}
+
+void sttp_unload_engine()
+{
+	if (true == g_initialized)
+		mock_deinitialize();
+
+	__mock_free_footprint();
+}
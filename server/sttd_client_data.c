@@ -131,6 +131,26 @@ int sttd_client_add(const int pid, const int uid)
 	return 0;
 }
 
+void __client_clear_partial(partial_result_s* partial)
+{
+	if (NULL != partial->timer) {
+		ecore_timer_del(partial->timer);
+		partial->timer = NULL;
+	}
+
+	if (NULL != partial->sent) {
+		free(partial->sent);
+		partial->sent = NULL;
+	}
+
+	if (NULL != partial->pending) {
+		free(partial->pending);
+		partial->pending = NULL;
+	}
+
+	partial->sent_time = 0;
+}
+
 int sttd_client_delete(const int uid)
 {
 	GList *tmp = NULL;
@@ -146,6 +166,7 @@ int sttd_client_delete(const int uid)
 	/*Free client structure*/
 	hnd = tmp->data;
 	if (NULL != hnd) {
+		__client_clear_partial(&hnd->partial);
 		g_free(hnd);
 	}
 
@@ -220,6 +241,28 @@ int sttd_client_get_pid(const int uid)
 	return hnd->pid;
 }
 
+int sttd_client_get_uid_by_pid(const int pid)
+{
+	GList *iter = NULL;
+	client_info_s *data = NULL;
+
+	if (0 < g_list_length(g_client_list)) {
+		iter = g_list_first(g_client_list);
+
+		while (NULL != iter) {
+			/* Get handle data from list */
+			data = iter->data;
+
+			if (pid == data->pid) 
+				return data->uid;
+
+			iter = g_list_next(iter);
+		}
+	}
+
+	return -1;
+}
+
 int sttd_client_get_current_recording()
 {
 	GList *iter = NULL;
@@ -264,6 +307,29 @@ int sttd_client_get_current_thinking()
 	return -1;
 }
 
+int sttd_client_get_processing_count()
+{
+	GList *iter = NULL;
+	client_info_s *data = NULL;
+	int count = 0;
+
+	if (0 < g_list_length(g_client_list)) {
+		iter = g_list_first(g_client_list);
+
+		while (NULL != iter) {
+			/* Get handle data from list */
+			data = iter->data;
+
+			if (APP_STATE_PROCESSING == data->state) 
+				count++;
+
+			iter = g_list_next(iter);
+		}
+	}
+
+	return count;
+}
+
 int sttd_cliet_set_timer(int uid, Ecore_Timer* timer)
 {
 	GList *tmp = NULL;
@@ -302,6 +368,102 @@ int sttd_cliet_get_timer(int uid, Ecore_Timer** timer)
 	return 0;
 }
 
+int sttd_client_set_partial_interval(int uid, int interval)
+{
+	GList *tmp = NULL;
+	client_info_s* hnd = NULL;
+
+	tmp = __client_get_item(uid);
+	if (NULL == tmp) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Client Data ERROR] uid(%d) is NOT valid", uid); 
+		return STTD_ERROR_INVALID_PARAMETER;
+	}
+
+	hnd = tmp->data;
+	hnd->partial_interval = interval;
+
+	return 0;
+}
+
+int sttd_client_get_partial_interval(int uid, int* interval)
+{
+	GList *tmp = NULL;
+	client_info_s* hnd = NULL;
+
+	tmp = __client_get_item(uid);
+	if (NULL == tmp) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Client Data ERROR] uid(%d) is NOT valid", uid); 
+		return STTD_ERROR_INVALID_PARAMETER;
+	}
+
+	hnd = tmp->data;
+	*interval = hnd->partial_interval;
+
+	return 0;
+}
+
+partial_result_s* sttd_client_get_partial_result(int uid)
+{
+	GList *tmp = NULL;
+	client_info_s* hnd = NULL;
+
+	tmp = __client_get_item(uid);
+	if (NULL == tmp) 
+		return NULL;
+
+	hnd = tmp->data;
+
+	return &hnd->partial;
+}
+
+int sttd_client_reset_partial_result(int uid)
+{
+	GList *tmp = NULL;
+	client_info_s* hnd = NULL;
+
+	tmp = __client_get_item(uid);
+	if (NULL == tmp) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Client Data ERROR] uid(%d) is NOT valid", uid); 
+		return STTD_ERROR_INVALID_PARAMETER;
+	}
+
+	hnd = tmp->data;
+	__client_clear_partial(&hnd->partial);
+
+	return 0;
+}
+
+int sttd_client_set_once(int uid, bool once)
+{
+	GList *tmp = NULL;
+	client_info_s* hnd = NULL;
+
+	tmp = __client_get_item(uid);
+	if (NULL == tmp) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Client Data ERROR] uid(%d) is NOT valid", uid); 
+		return STTD_ERROR_INVALID_PARAMETER;
+	}
+
+	hnd = tmp->data;
+	hnd->once = once;
+
+	return 0;
+}
+
+bool sttd_client_is_once(int uid)
+{
+	GList *tmp = NULL;
+	client_info_s* hnd = NULL;
+
+	tmp = __client_get_item(uid);
+	if (NULL == tmp) 
+		return false;
+
+	hnd = tmp->data;
+
+	return hnd->once;
+}
+
 
 int sttd_client_get_list(int** uids, int* uid_count)
 {
@@ -29,11 +29,22 @@ typedef enum {
 	APP_STATE_PROCESSING	= 3
 }app_state_e;
 
+/** partial results of recognizing session. Only changed suffix is sent to client */
+typedef struct {
+	char*		sent;		/* text which client has */
+	char*		pending;	/* latest text from engine, not sent yet */
+	double		sent_time;
+	Ecore_Timer*	timer;
+} partial_result_s;
+
 typedef struct {
 	int	pid;
 	int	uid;
 	app_state_e	state;
 	Ecore_Timer*	timer;
+	int	partial_interval;	/* msec between partial results */
+	partial_result_s	partial;
+	bool	once;			/* client is removed when its session ends */
 } client_info_s;
 
 typedef struct {
@@ -52,16 +63,37 @@ int sttd_client_get_ref_count();
 
 int sttd_client_get_pid(const int uid);
 
+/** Get first uid of process. If there is no uid, return -1 */
+int sttd_client_get_uid_by_pid(const int pid);
+
 int sttd_client_get_current_recording();
 
 int sttd_client_get_current_thinking();
 
+int sttd_client_get_processing_count();
+
 int sttd_cliet_set_timer(int uid, Ecore_Timer* timer);
 
 int sttd_cliet_get_timer(int uid, Ecore_Timer** timer);
 
 int sttd_client_get_list(int** uids, int* uid_count);
 
+/** Minimum interval(msec) of partial results which client wants. 0 means every partial result */
+int sttd_client_set_partial_interval(int uid, int interval);
+
+int sttd_client_get_partial_interval(int uid, int* interval);
+
+/** Partial result state of uid. It is valid until client is deleted */
+partial_result_s* sttd_client_get_partial_result(int uid);
+
+/** Clear partial result state of uid and delete its timer */
+int sttd_client_reset_partial_result(int uid);
+
+/** One-shot client is registered for a session only */
+int sttd_client_set_once(int uid, bool once);
+
+bool sttd_client_is_once(int uid);
+
 
 int sttd_setting_client_add(int pid);
 
@@ -23,6 +23,16 @@
 #define SILENCE		"SILENCE"
 #define PROFANITY	"PROFANITY"
 #define PUNCTUATION	"PUNCTUATION"
+#define RESIDENCY	"RESIDENCY"
+#define UNLOAD_DELAY	"UNLOAD_DELAY"
+#define IDLE_RECLAIM	"IDLE_RECLAIM"
+#define CALL_DEADLINE	"CALL_DEADLINE"
+#define LOAD_DEADLINE	"LOAD_DEADLINE"
+
+#define DEFAULT_UNLOAD_DELAY	10
+#define DEFAULT_IDLE_RECLAIM	30
+#define DEFAULT_CALL_DEADLINE	3000
+#define DEFAULT_LOAD_DEADLINE	10000
 
 
 static char*	g_engine_id;
@@ -30,6 +40,11 @@ static char*	g_language;
 static int	g_silence;
 static int	g_profanity;
 static int	g_punctuation;
+static int	g_residency;
+static int	g_unload_delay;
+static int	g_idle_reclaim;
+static int	g_call_deadline;
+static int	g_load_deadline;
 
 int __sttd_config_save()
 {
@@ -57,6 +72,19 @@ int __sttd_config_save()
 	/* Write punctuation */
 	fprintf(config_fp, "%s %d\n", PUNCTUATION, g_punctuation);
 
+	/* Write engine residency */
+	fprintf(config_fp, "%s %d\n", RESIDENCY, g_residency);
+
+	/* Write unload delay */
+	fprintf(config_fp, "%s %d\n", UNLOAD_DELAY, g_unload_delay);
+
+	/* Write idle reclaim delay */
+	fprintf(config_fp, "%s %d\n", IDLE_RECLAIM, g_idle_reclaim);
+
+	/* Write deadline of engine calls */
+	fprintf(config_fp, "%s %d\n", CALL_DEADLINE, g_call_deadline);
+	fprintf(config_fp, "%s %d\n", LOAD_DEADLINE, g_load_deadline);
+
 	fclose(config_fp);
 
 	return 0;
@@ -137,8 +165,67 @@ int __sttd_config_load()
 		return 0;
 	}
 
-	SLOG(LOG_DEBUG, TAG_STTD, "[Config] Load config : engine(%s), language(%s), silence(%d), profanity(%d), punctuation(%d)",
-		g_engine_id, g_language, g_silence, g_profanity, g_punctuation);
+	/* Read engine residency. Old config files do not have it, so keep default and rewrite */
+	if (2 == fscanf(config_fp, "%s %d", buf_id, &int_param) && 0 == strncmp(RESIDENCY, buf_id, strlen(RESIDENCY))) {
+		if (STTD_RESIDENCY_ON_DEMAND <= int_param && STTD_RESIDENCY_PINNED >= int_param)
+			g_residency = int_param;
+		else
+			SLOG(LOG_WARN, TAG_STTD, "[Config WARNING] Invalid residency(%d)", int_param);
+	} else {
+		fclose(config_fp);
+		SLOG(LOG_WARN, TAG_STTD, "[Config WARNING] Fail to load config (residency)");
+		__sttd_config_save();
+		return 0;
+	}
+
+	/* Read unload delay */
+	if (2 == fscanf(config_fp, "%s %d", buf_id, &int_param) && 0 == strncmp(UNLOAD_DELAY, buf_id, strlen(UNLOAD_DELAY))) {
+		if (0 <= int_param)
+			g_unload_delay = int_param;
+	} else {
+		fclose(config_fp);
+		SLOG(LOG_WARN, TAG_STTD, "[Config WARNING] Fail to load config (unload delay)");
+		__sttd_config_save();
+		return 0;
+	}
+
+	/* Read idle reclaim delay */
+	if (2 == fscanf(config_fp, "%s %d", buf_id, &int_param) && 0 == strncmp(IDLE_RECLAIM, buf_id, strlen(IDLE_RECLAIM))) {
+		if (0 <= int_param)
+			g_idle_reclaim = int_param;
+	} else {
+		fclose(config_fp);
+		SLOG(LOG_WARN, TAG_STTD, "[Config WARNING] Fail to load config (idle reclaim)");
+		__sttd_config_save();
+		return 0;
+	}
+
+	/* Read deadline of engine calls */
+	if (2 == fscanf(config_fp, "%s %d", buf_id, &int_param) && 0 == strncmp(CALL_DEADLINE, buf_id, strlen(CALL_DEADLINE))) {
+		if (0 <= int_param)
+			g_call_deadline = int_param;
+	} else {
+		fclose(config_fp);
+		SLOG(LOG_WARN, TAG_STTD, "[Config WARNING] Fail to load config (call deadline)");
+		__sttd_config_save();
+		return 0;
+	}
+
+	if (2 == fscanf(config_fp, "%s %d", buf_id, &int_param) && 0 == strncmp(LOAD_DEADLINE, buf_id, strlen(LOAD_DEADLINE))) {
+		if (0 <= int_param)
+			g_load_deadline = int_param;
+	} else {
+		fclose(config_fp);
+		SLOG(LOG_WARN, TAG_STTD, "[Config WARNING] Fail to load config (load deadline)");
+		__sttd_config_save();
+		return 0;
+	}
+
+	fclose(config_fp);
+
+	SLOG(LOG_DEBUG, TAG_STTD, "[Config] Load config : engine(%s), language(%s), silence(%d), profanity(%d), punctuation(%d), residency(%d), unload delay(%d), idle reclaim(%d), call deadline(%d), load deadline(%d)",
+		g_engine_id, g_language, g_silence, g_profanity, g_punctuation, g_residency, g_unload_delay, g_idle_reclaim, 
+		g_call_deadline, g_load_deadline);
 
 	return 0;
 }
@@ -150,6 +237,11 @@ int sttd_config_initialize()
 	g_silence = 1;
 	g_profanity = 0;
 	g_punctuation = 0;
+	g_residency = STTD_RESIDENCY_ON_DEMAND;
+	g_unload_delay = DEFAULT_UNLOAD_DELAY;
+	g_idle_reclaim = DEFAULT_IDLE_RECLAIM;
+	g_call_deadline = DEFAULT_CALL_DEADLINE;
+	g_load_deadline = DEFAULT_LOAD_DEADLINE;
 
 	__sttd_config_load();
 
@@ -258,4 +350,54 @@ int sttd_config_set_default_punctuation_override(int punctuation)
 	g_punctuation = punctuation;
 	__sttd_config_save();
 	return 0;
-}
\ No newline at end of file
+}
+
+int sttd_config_get_engine_residency(int* residency)
+{
+	if (NULL == residency)
+		return -1;
+
+	*residency = g_residency;
+
+	return 0;
+}
+
+int sttd_config_get_engine_unload_delay(int* seconds)
+{
+	if (NULL == seconds)
+		return -1;
+
+	*seconds = g_unload_delay;
+
+	return 0;
+}
+
+int sttd_config_get_idle_reclaim_delay(int* seconds)
+{
+	if (NULL == seconds)
+		return -1;
+
+	*seconds = g_idle_reclaim;
+
+	return 0;
+}
+
+int sttd_config_get_engine_call_deadline(int* msec)
+{
+	if (NULL == msec)
+		return -1;
+
+	*msec = g_call_deadline;
+
+	return 0;
+}
+
+int sttd_config_get_engine_load_deadline(int* msec)
+{
+	if (NULL == msec)
+		return -1;
+
+	*msec = g_load_deadline;
+
+	return 0;
+}
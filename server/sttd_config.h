@@ -43,6 +43,16 @@ int sttd_config_get_default_punctuation_override(int* punctuation);
 
 int sttd_config_set_default_punctuation_override(int punctuation);
 
+int sttd_config_get_engine_residency(int* residency);
+
+int sttd_config_get_engine_unload_delay(int* seconds);
+
+int sttd_config_get_idle_reclaim_delay(int* seconds);
+
+int sttd_config_get_engine_call_deadline(int* msec);
+
+int sttd_config_get_engine_load_deadline(int* msec);
+
 
 #ifdef __cplusplus
 }
@@ -14,6 +14,16 @@
 
 #include <dbus/dbus.h>
 #include <Ecore.h>
+#include <time.h>
+#include <pthread.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <pwd.h>
+#include <grp.h>
 
 #include "sttd_main.h"
 #include "sttd_dbus.h"
@@ -24,7 +34,207 @@
 static DBusConnection* g_conn;
 static int g_waiting_time = 3000;
 
-int sttdc_send_hello(int uid)
+/* pid of clients whose bus name is watched */
+static GList* g_watch_list = NULL;
+
+/** private connection of client process. It bypasses the bus daemon */
+typedef struct {
+	int			pid;
+	DBusConnection*		conn;
+} sttd_peer_s;
+
+static GList* g_peer_list = NULL;
+static DBusServer* g_peer_server = NULL;
+
+/* result bigger than this is sent as memfd on private connection */
+#define STTD_DBUS_MEMFD_THRESHOLD	4096
+
+/* messages handled in one main loop iteration */
+#define STTD_DBUS_DISPATCH_BUDGET	32
+static Ecore_Timer* g_drain_timer = NULL;
+
+/** daemon-to-client call waiting for reply */
+typedef struct {
+	int			uid;
+	DBusConnection*		conn;
+	dbus_uint32_t		serial;
+	Ecore_Timer*		timer;
+	sttdc_reply_cb		callback;
+	void*			user_data;
+} sttdc_pending_s;
+
+static GList* g_pending_list = NULL;
+
+/** Return private connection of client if it has one, or bus connection */
+DBusConnection* __get_client_conn(int pid)
+{
+	GList *iter = g_list_first(g_peer_list);
+	while (NULL != iter) {
+		sttd_peer_s* peer = iter->data;
+		if (pid == peer->pid)
+			return peer->conn;
+		iter = g_list_next(iter);
+	}
+
+	return g_conn;
+}
+
+int sttd_dbus_bind_peer(int pid, DBusConnection* conn)
+{
+	sttd_peer_s* peer = NULL;
+
+	GList *iter = g_list_first(g_peer_list);
+	while (NULL != iter) {
+		if (pid == ((sttd_peer_s*)iter->data)->pid) {
+			peer = iter->data;
+			break;
+		}
+		iter = g_list_next(iter);
+	}
+
+	if (NULL == peer) {
+		peer = (sttd_peer_s*)calloc(1, sizeof(sttd_peer_s));
+		if (NULL == peer) {
+			SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to allocate memory");
+			return -1;
+		}
+		peer->pid = pid;
+		g_peer_list = g_list_append(g_peer_list, peer);
+	} else {
+		/* client opened new connection */
+		dbus_connection_unref(peer->conn);
+	}
+
+	peer->conn = dbus_connection_ref(conn);
+
+	SLOG(LOG_DEBUG, TAG_STTD, "[Dbus] Bind private connection : pid(%d)", pid);
+
+	return 0;
+}
+
+/** Called when private connection is closed. Client is still reachable on the bus */
+int __peer_disconnected(DBusConnection* conn, DBusMessage* msg)
+{
+	if (g_conn == conn)
+		return 0;
+
+	GList *iter = g_list_first(g_peer_list);
+	while (NULL != iter) {
+		sttd_peer_s* peer = iter->data;
+		if (conn == peer->conn) {
+			SLOG(LOG_DEBUG, TAG_STTD, "[Dbus] Private connection is closed : pid(%d)", peer->pid);
+
+			g_peer_list = g_list_remove(g_peer_list, peer);
+			dbus_connection_unref(peer->conn);
+			free(peer);
+			break;
+		}
+		iter = g_list_next(iter);
+	}
+
+	return 0;
+}
+
+void __complete_pending_call(sttdc_pending_s* call, int result)
+{
+	g_pending_list = g_list_remove(g_pending_list, call);
+
+	if (NULL != call->timer) {
+		ecore_timer_del(call->timer);
+		call->timer = NULL;
+	}
+
+	if (NULL != call->callback) {
+		call->callback(call->uid, result, call->user_data);
+	} else if (0 != result) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Dbus] uid(%d) does not reply : result(%d)", call->uid, result);
+	}
+
+	free(call);
+}
+
+/** Match reply of client with its call by serial. Serial is unique only in a connection */
+void __handle_reply(DBusConnection* conn, DBusMessage* reply)
+{
+	dbus_uint32_t serial = dbus_message_get_reply_serial(reply);
+	sttdc_pending_s* call = NULL;
+
+	GList *iter = g_list_first(g_pending_list);
+	while (NULL != iter) {
+		if (serial == ((sttdc_pending_s*)iter->data)->serial && conn == ((sttdc_pending_s*)iter->data)->conn) {
+			call = iter->data;
+			break;
+		}
+		iter = g_list_next(iter);
+	}
+
+	/* reply after time out */
+	if (NULL == call)
+		return;
+
+	int result = -1;
+
+	DBusError err;
+	dbus_error_init(&err);
+
+	if (DBUS_MESSAGE_TYPE_ERROR == dbus_message_get_type(reply)) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Dbus] Error reply from uid(%d) : %s", call->uid, dbus_message_get_error_name(reply));
+	} else if (!dbus_message_get_args(reply, &err, DBUS_TYPE_INT32, &result, DBUS_TYPE_INVALID)) {
+		/* some methods reply without result */
+		if (dbus_error_is_set(&err)) 
+			dbus_error_free(&err); 
+		result = 0;
+	}
+
+	__complete_pending_call(call, result);
+}
+
+Eina_Bool __pending_call_expired(void* data)
+{
+	sttdc_pending_s* call = (sttdc_pending_s*)data;
+
+	SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] uid(%d) does not reply in %d msec", call->uid, g_waiting_time);
+
+	call->timer = NULL;
+
+	__complete_pending_call(call, -1);
+
+	return EINA_FALSE;
+}
+
+/** Send message to client without waiting. It takes ownership of msg */
+int __send_async(int uid, DBusMessage* msg, sttdc_reply_cb callback, void* user_data)
+{
+	sttdc_pending_s* call = (sttdc_pending_s*)calloc(1, sizeof(sttdc_pending_s));
+	if (NULL == call) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to allocate memory");
+		dbus_message_unref(msg);
+		return -1;
+	}
+
+	call->conn = __get_client_conn(sttd_client_get_pid(uid));
+
+	/* message is written by I/O thread */
+	if (!dbus_connection_send(call->conn, msg, &call->serial)) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to send message : uid(%d)", uid);
+		dbus_message_unref(msg);
+		free(call);
+		return -1;
+	}
+
+	dbus_message_unref(msg);
+
+	call->uid = uid;
+	call->callback = callback;
+	call->user_data = user_data;
+	call->timer = ecore_timer_add((double)g_waiting_time / 1000.0, __pending_call_expired, call);
+
+	g_pending_list = g_list_append(g_pending_list, call);
+
+	return 0;
+}
+
+int sttdc_send_hello(int uid, sttdc_reply_cb callback, void* user_data)
 {
 	int pid = sttd_client_get_pid(uid);
 
@@ -57,34 +267,10 @@ int sttdc_send_hello(int uid)
 
 	dbus_message_append_args(msg, DBUS_TYPE_INT32, &uid, DBUS_TYPE_INVALID);
 
-	DBusError err;
-	dbus_error_init(&err);
-
-	DBusMessage* result_msg;
-	int result = -1;
-
-	result_msg = dbus_connection_send_with_reply_and_block(g_conn, msg, g_waiting_time, &err);
-	dbus_message_unref(msg);
-
-	if (NULL != result_msg) {
-		dbus_message_get_args(result_msg, &err, DBUS_TYPE_INT32, &result, DBUS_TYPE_INVALID);
-
-		if (dbus_error_is_set(&err)) { 
-			SLOG(LOG_ERROR, TAG_STTD, "[Dbus] Get arguments error (%s)\n", err.message);
-			dbus_error_free(&err); 
-			result = -1;
-		}
-
-		dbus_message_unref(result_msg);
-	} else {
-		SLOG(LOG_DEBUG, TAG_STTD, "[Dbus] Result message is NULL. Client is not available");
-		result = 0;
-	}
-
-	return result;
+	return __send_async(uid, msg, callback, user_data);
 }
 
-int sttdc_send_get_state(int uid, int* state)
+int sttdc_send_get_state(int uid, sttdc_reply_cb callback, void* user_data)
 {
 	int pid = sttd_client_get_pid(uid);
 
@@ -117,35 +303,59 @@ int sttdc_send_get_state(int uid, int* state)
 
 	dbus_message_append_args(msg, DBUS_TYPE_INT32, &uid, DBUS_TYPE_INVALID);
 
-	DBusError err;
-	dbus_error_init(&err);
-
-	DBusMessage* result_msg;
-	int tmp = -1;
-	int result = 0;
+	return __send_async(uid, msg, callback, user_data);
+}
 
-	result_msg = dbus_connection_send_with_reply_and_block(g_conn, msg, g_waiting_time, &err);
-	dbus_message_unref(msg);
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC		0x0001U
+#define MFD_ALLOW_SEALING	0x0002U
+#endif
+
+#ifndef F_ADD_SEALS
+#define F_ADD_SEALS		1033
+#define F_SEAL_SEAL		0x0001
+#define F_SEAL_SHRINK		0x0002
+#define F_SEAL_GROW		0x0004
+#define F_SEAL_WRITE		0x0008
+#endif
+
+/** Write results into sealed memfd as NULL-terminated strings. Return fd or -1 */
+int __create_result_memfd(const char** data, int data_count, int size)
+{
+#ifdef __NR_memfd_create
+	int fd = syscall(__NR_memfd_create, "stt-result", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+	if (0 > fd) {
+		SLOG(LOG_WARN, TAG_STTD, "[Dbus WARNING] Fail to create memfd : %d", errno);
+		return -1;
+	}
 
-	if (NULL != result_msg) {
-		dbus_message_get_args(result_msg, &err, DBUS_TYPE_INT32, &tmp, DBUS_TYPE_INVALID);
+	if (0 != ftruncate(fd, size)) {
+		close(fd);
+		return -1;
+	}
 
-		if (dbus_error_is_set(&err)) { 
-			SLOG(LOG_ERROR, TAG_STTD, "[Dbus] Get arguments error (%s)\n", err.message);
-			dbus_error_free(&err); 
-			result = -1;
-		} else {
-			*state = tmp;
-			result = 0;
+	int i;
+	int len;
+	for (i = 0;i < data_count;i++) {
+		len = strlen(data[i]) + 1;
+		if (len != write(fd, data[i], len)) {
+			SLOG(LOG_WARN, TAG_STTD, "[Dbus WARNING] Fail to write memfd");
+			close(fd);
+			return -1;
 		}
+	}
 
-		dbus_message_unref(result_msg);
-	} else {
-		SLOG(LOG_ERROR, TAG_STTD, "[Dbus] Result message is NULL. Client is not available");
-		result = -1;
+	/* client does not map memfd which is not sealed */
+	if (0 != fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL)) {
+		SLOG(LOG_WARN, TAG_STTD, "[Dbus WARNING] Fail to seal memfd : %d", errno);
+		close(fd);
+		return -1;
 	}
-	
-	return result;
+
+	return fd;
+#else
+	return -1;
+#endif
 }
 
 int sttdc_send_result(int uid, const char* type, const char** data, int data_count, const char* result_msg)
@@ -214,16 +424,13 @@ int sttdc_send_result(int uid, const char* type, const char** data, int data_cou
 	}
 
 	int i;
+	int total_size = 0;
 
 	SLOG(LOG_DEBUG, TAG_STTD, "[Dbus] result size (%d)", data_count); 
 	for (i=0 ; i<data_count ; i++) {
 		if (NULL != data[i]) {
 			SLOG(LOG_DEBUG, TAG_STTD, "[Dbus] result (%d, %s)", i, data[i] ); 
-
-			if (!dbus_message_iter_append_basic(&args, DBUS_TYPE_STRING, &data[i])) {
-				SLOG(LOG_ERROR, TAG_STTD, "[Dbus] response message : Fail to append result data");
-				return -1;
-			}
+			total_size += strlen(data[i]) + 1;
 		} else {
 			int reason = (int)STTD_ERROR_OPERATION_FAILED;
 
@@ -234,24 +441,54 @@ int sttdc_send_result(int uid, const char* type, const char** data, int data_cou
 				sttd_client_delete(uid);
 			}
 
-			SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Result from engine is NULL(%d) %s", i); 
+			SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Result from engine is NULL(%d)", i); 
+
+			dbus_message_unref(msg);
+			return -1;
+		}
+	}
+
+	DBusConnection* conn = __get_client_conn(pid);
+	int fd = -1;
 
+	/* large n-best list is passed as memfd instead of being copied through socket */
+	if (g_conn != conn && STTD_DBUS_MEMFD_THRESHOLD < total_size && STT_RESULT_FD_MAX_SIZE >= total_size 
+		&& dbus_connection_can_send_type(conn, DBUS_TYPE_UNIX_FD)) 
+		fd = __create_result_memfd(data, data_count, total_size);
+
+	if (0 <= fd) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Dbus] result is sent as memfd : size(%d)", total_size); 
+
+		/* libdbus keeps its own duplicate of fd */
+		if (!dbus_message_iter_append_basic(&args, DBUS_TYPE_UNIX_FD, &fd) 
+			|| !dbus_message_iter_append_basic(&args, DBUS_TYPE_INT32, &total_size)) {
+			SLOG(LOG_ERROR, TAG_STTD, "[Dbus] response message : Fail to append result fd");
+			close(fd);
+			dbus_message_unref(msg);
 			return -1;
 		}
+		close(fd);
+	} else {
+		for (i=0 ; i<data_count ; i++) {
+			if (!dbus_message_iter_append_basic(&args, DBUS_TYPE_STRING, &data[i])) {
+				SLOG(LOG_ERROR, TAG_STTD, "[Dbus] response message : Fail to append result data");
+				dbus_message_unref(msg);
+				return -1;
+			}
+		}
 	}
 	
-	if (!dbus_connection_send(g_conn, msg, NULL)) {
+	if (!dbus_connection_send(conn, msg, NULL)) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to send message : Out Of Memory !"); 
 		return -1;
 	}
 
-	dbus_connection_flush(g_conn);
 	dbus_message_unref(msg);
 
 	return 0;
 }
 
-int sttdc_send_partial_result(int uid, const char* data)
+int sttdc_send_partial_result(int uid, int keep, const char* suffix)
 {
 	int pid = sttd_client_get_pid(uid);
 
@@ -260,7 +497,7 @@ int sttdc_send_partial_result(int uid, const char* data)
 		return -1;
 	}
 
-	if (NULL == data) {
+	if (NULL == suffix) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Input data is NULL" );
 		return -1;
 	}
@@ -274,7 +511,7 @@ int sttdc_send_partial_result(int uid, const char* data)
 
 	DBusMessage* msg;
 
-	SLOG(LOG_DEBUG, TAG_STTD, "[Dbus] send result signal : uid(%d), result(%s)", uid, data);
+	SLOG(LOG_DEBUG, TAG_STTD, "[Dbus] send partial result : uid(%d), keep(%d), suffix(%s)", uid, keep, suffix);
  
 	msg = dbus_message_new_method_call(
 		service_name, 
@@ -290,22 +527,25 @@ int sttdc_send_partial_result(int uid, const char* data)
 	DBusMessageIter args;
 	dbus_message_iter_init_append(msg, &args);
 
-	/* Append uid & type */
+	/* Append uid & delta */
 	dbus_message_iter_append_basic(&args, DBUS_TYPE_INT32, &uid);
+	dbus_message_iter_append_basic(&args, DBUS_TYPE_INT32, &keep);
 
-	SLOG(LOG_DEBUG, TAG_STTD, "[Dbus] Partial result (%s)", data ); 
-
-	if (!dbus_message_iter_append_basic(&args, DBUS_TYPE_STRING, data)) {
+	if (!dbus_message_iter_append_basic(&args, DBUS_TYPE_STRING, &suffix)) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Dbus] response message : Fail to append result data");
+		dbus_message_unref(msg);
 		return -1;
 	}
+
+	/* partial result is not acknowledged */
+	dbus_message_set_no_reply(msg, TRUE);
 	
-	if (!dbus_connection_send(g_conn, msg, NULL)) {
+	if (!dbus_connection_send(__get_client_conn(pid), msg, NULL)) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to send message : Out Of Memory !"); 
+		dbus_message_unref(msg);
 		return -1;
 	}
 
-	dbus_connection_flush(g_conn);
 	dbus_message_unref(msg);
 
 	return 0;
@@ -352,24 +592,10 @@ int sttdc_send_error_signal(int uid, int reason, char *err_msg)
 		DBUS_TYPE_STRING, &err_msg,
 		DBUS_TYPE_INVALID);
 	
-	DBusError err;
-	dbus_error_init(&err);
-
-	DBusMessage* result_msg;
-
-	result_msg = dbus_connection_send_with_reply_and_block(g_conn, msg, g_waiting_time, &err);
-	dbus_message_unref(msg);
-
-	if (NULL != result_msg) {
-		dbus_message_unref(result_msg);
-	} else {
-		SLOG(LOG_DEBUG, TAG_STTD, "[Dbus] Result message is NULL.");
-	}
-
-	return 0;
+	return __send_async(uid, msg, NULL, NULL);
 }
 
-int sttdc_send_set_state(int uid, int state)
+int sttdc_send_set_state(int uid, int state, sttdc_reply_cb callback, void* user_data)
 {
 	int pid = sttd_client_get_pid(uid);
 
@@ -405,208 +631,1132 @@ int sttdc_send_set_state(int uid, int state)
 		DBUS_TYPE_INT32, &state, 
 		DBUS_TYPE_INVALID);
 
-	DBusError err;
-	dbus_error_init(&err);
-
-	DBusMessage* result_msg;
-	int result = -1;
-
-	result_msg = dbus_connection_send_with_reply_and_block(g_conn, msg, g_waiting_time, &err);
-	dbus_message_unref(msg);
-
-	if (NULL != result_msg) {
-		dbus_message_get_args(result_msg, &err, DBUS_TYPE_INT32, &result, DBUS_TYPE_INVALID);
+	return __send_async(uid, msg, callback, user_data);
+}
 
-		if (dbus_error_is_set(&err)) { 
-			SLOG(LOG_ERROR, TAG_STTD, "[Dbus] Get arguments error (%s)\n", err.message);
-			dbus_error_free(&err); 
-			result = -1;
-		}
+int sttdc_send_queue_position(int uid, int position)
+{
+	int pid = sttd_client_get_pid(uid);
 
-		dbus_message_unref(result_msg);
-	} else {
-		SLOG(LOG_DEBUG, TAG_STTD, "[Dbus] Result message is NULL. Client is not available");
+	if (0 > pid) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] pid is NOT valid");
+		return -1;
 	}
 
-	return result;
-}
+	char service_name[64];
+	memset(service_name, 0, 64);
+	snprintf(service_name, 64, "%s%d", STT_CLIENT_SERVICE_NAME, pid);
 
-static Eina_Bool listener_event_callback(void* data, Ecore_Fd_Handler *fd_handler)
-{
-	DBusConnection* conn = (DBusConnection*)data;
-	DBusMessage* msg = NULL;
+	char target_if_name[128];
+	snprintf(target_if_name, sizeof(target_if_name), "%s%d", STT_CLIENT_SERVICE_INTERFACE, pid);
 
-	if (NULL == conn)
-		return ECORE_CALLBACK_RENEW;
+	DBusMessage* msg;
 
-	dbus_connection_read_write_dispatch(conn, 50);
-	
-	msg = dbus_connection_pop_message(conn);
+	SLOG(LOG_DEBUG, TAG_STTD, "[Dbus] Send queue position message : uid(%d), position(%d)", uid, position);
+
+	msg = dbus_message_new_method_call(
+		service_name, 
+		STT_CLIENT_SERVICE_OBJECT_PATH, 
+		target_if_name, 
+		STTD_METHOD_QUEUE_POSITION);
 
-	/* loop again if we haven't read a message */
 	if (NULL == msg) { 
-		return ECORE_CALLBACK_RENEW;
+		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to create message"); 
+		return -1;
 	}
 
+	dbus_message_append_args(msg, 
+		DBUS_TYPE_INT32, &uid, 
+		DBUS_TYPE_INT32, &position, 
+		DBUS_TYPE_INVALID);
 
-	/* daemon internal event */
-	if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STTD_METHOD_STOP_BY_DAEMON))
-		sttd_dbus_server_stop_by_daemon(msg);
-
-	/* client event */
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_METHOD_HELLO))
-		sttd_dbus_server_hello(conn, msg);
-
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_METHOD_INITIALIZE))
-		sttd_dbus_server_initialize(conn, msg);
-	
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_METHOD_FINALIZE))
-		sttd_dbus_server_finalize(conn, msg);
-	
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_METHOD_GET_SUPPORT_LANGS))
-		sttd_dbus_server_get_support_lang(conn, msg);
+	/* position is only a hint, so client does not reply */
+	dbus_message_set_no_reply(msg, TRUE);
 
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_METHOD_GET_CURRENT_LANG))
-		sttd_dbus_server_get_default_lang(conn, msg);
+	if (!dbus_connection_send(__get_client_conn(pid), msg, NULL)) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to send message : Out Of Memory !"); 
+		dbus_message_unref(msg);
+		return -1;
+	}
 
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_METHOD_IS_PARTIAL_SUPPORTED))
-		sttd_dbus_server_is_partial_result_supported(conn, msg);
+	dbus_message_unref(msg);
 
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_METHOD_GET_AUDIO_VOLUME))
-		sttd_dbus_server_get_audio_volume(conn, msg);
+	return 0;
+}
 
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_METHOD_START)) 
-		sttd_dbus_server_start(conn, msg);
-	
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_METHOD_STOP)) 
-		sttd_dbus_server_stop(conn, msg);
+void __get_watch_rule(int pid, char* rule, int size)
+{
+	snprintf(rule, size, 
+		"type='signal',sender='%s',interface='%s',member='NameOwnerChanged',arg0='%s%d'", 
+		DBUS_SERVICE_DBUS, DBUS_INTERFACE_DBUS, STT_CLIENT_SERVICE_NAME, pid);
+}
 
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_METHOD_CANCEL)) 
-		sttd_dbus_server_cancel(conn, msg);
+int sttd_dbus_watch_client(int pid)
+{
+	if (NULL != g_list_find(g_watch_list, GINT_TO_POINTER(pid)))
+		return 0;
 
+	char rule[256];
+	__get_watch_rule(pid, rule, sizeof(rule));
 
-	/* setting event */
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_HELLO))
-		sttd_dbus_server_hello(conn, msg);
+	/* NULL error does not wait for reply of bus */
+	dbus_bus_add_match(g_conn, rule, NULL);
 
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_INITIALIZE))
-		sttd_dbus_server_setting_initialize(conn, msg);
+	g_watch_list = g_list_append(g_watch_list, GINT_TO_POINTER(pid));
 
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_FINALIZE))
-		sttd_dbus_server_setting_finalize(conn, msg);
+	/* client which has left before match is added is never notified */
+	char service_name[64];
+	memset(service_name, 0, 64);
+	snprintf(service_name, 64, "%s%d", STT_CLIENT_SERVICE_NAME, pid);
 
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_GET_ENGINE_LIST))
-		sttd_dbus_server_setting_get_engine_list(conn, msg);
+	DBusError err;
+	dbus_error_init(&err);
 
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_GET_ENGINE))
-		sttd_dbus_server_setting_get_engine(conn, msg);
+	dbus_bool_t owned = dbus_bus_name_has_owner(g_conn, service_name, &err);
+	if (dbus_error_is_set(&err)) {
+		SLOG(LOG_WARN, TAG_STTD, "[Dbus WARNING] Fail to check owner of client : %s", err.message);
+		dbus_error_free(&err);
+	} else if (!owned) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Client has already left bus : pid(%d)", pid);
+		sttd_dbus_unwatch_client(pid);
+		return -1;
+	}
 
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_SET_ENGINE))
-		sttd_dbus_server_setting_set_engine(conn, msg);
+	SLOG(LOG_DEBUG, TAG_STTD, "[Dbus] Watch client : pid(%d)", pid);
 
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_GET_LANG_LIST))
-		sttd_dbus_server_setting_get_language_list(conn, msg);
+	return 0;
+}
 
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_GET_DEFAULT_LANG))
-		sttd_dbus_server_setting_get_default_language(conn, msg);
+int sttd_dbus_unwatch_client(int pid)
+{
+	if (NULL == g_list_find(g_watch_list, GINT_TO_POINTER(pid)))
+		return 0;
 
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_SET_DEFAULT_LANG))
-		sttd_dbus_server_setting_set_default_language(conn, msg);
+	char rule[256];
+	__get_watch_rule(pid, rule, sizeof(rule));
 
+	dbus_bus_remove_match(g_conn, rule, NULL);
 
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_GET_PROFANITY))
-		sttd_dbus_server_setting_get_profanity_filter(conn, msg);
+	g_watch_list = g_list_remove(g_watch_list, GINT_TO_POINTER(pid));
 
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_SET_PROFANITY))
-		sttd_dbus_server_setting_set_profanity_filter(conn, msg);
+	SLOG(LOG_DEBUG, TAG_STTD, "[Dbus] Unwatch client : pid(%d)", pid);
 
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_GET_PUNCTUATION))
-		sttd_dbus_server_setting_get_punctuation_override(conn, msg);
+	return 0;
+}
 
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_SET_PUNCTUATION))
-		sttd_dbus_server_setting_set_punctuation_override(conn, msg);
+/*
+* Method dispatch table
+*/
 
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_GET_SILENCE))
-		sttd_dbus_server_setting_get_silence_detection(conn, msg);
+typedef int (*sttd_dbus_handler)(DBusConnection* conn, DBusMessage* msg);
 
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_SET_SILENCE))
-		sttd_dbus_server_setting_set_silence_detection(conn, msg);
+#define STTD_STATE_ANY	-1
 
+/** handler metadata and statistics of method */
+typedef struct {
+	const char*		interface;
+	const char*		member;
+	int			type;		/* method call or signal */
+	sttd_dbus_handler	handler;
+	bool			setting;	/* called by setting client */
+	int			state;		/* app state required by handler */
+	bool			startup;	/* handled before daemon is ready */
+	bool			peer;		/* allowed on private connection */
 
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_GET_ENGINE_SETTING))
-		sttd_dbus_server_setting_get_engine_setting(conn, msg);
+	unsigned int		count;
+	unsigned int		state_mismatch;
+	double			total_time;
+	double			max_time;
+} sttd_dbus_method_s;
 
-	else if (dbus_message_is_method_call(msg, STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_SET_ENGINE_SETTING))
-		sttd_dbus_server_setting_set_engine_setting(conn, msg);
+/* interface quark -> (member quark -> method) */
+static GHashTable* g_interface_table = NULL;
+static GList* g_method_list = NULL;
 
+double __dbus_get_time_ms()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
 
-	/* free the message */
-	dbus_message_unref(msg);
+	return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1000000.0;
+}
 
-	return ECORE_CALLBACK_RENEW;
+int __stop_by_daemon(DBusConnection* conn, DBusMessage* msg)
+{
+	return sttd_dbus_server_stop_by_daemon(msg);
 }
 
-int sttd_dbus_open_connection()
+int __name_owner_changed(DBusConnection* conn, DBusMessage* msg)
 {
-	DBusError err;
-	dbus_error_init(&err);
+	return sttd_dbus_server_name_owner_changed(msg);
+}
 
-	int ret;
+void __register_method(const char* interface, const char* member, int type, sttd_dbus_handler handler, bool setting, int state)
+{
+	sttd_dbus_method_s* method = (sttd_dbus_method_s*)calloc(1, sizeof(sttd_dbus_method_s));
+	if (NULL == method) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to allocate memory");
+		return;
+	}
 
-	/* connect to the bus and check for errors */
-	g_conn = dbus_bus_get(DBUS_BUS_SYSTEM, &err);
+	method->interface = interface;
+	method->member = member;
+	method->type = type;
+	method->handler = handler;
+	method->setting = setting;
+	method->state = state;
 
-	if (dbus_error_is_set(&err)) { 
-		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail dbus_bus_get : %s", err.message);
-		dbus_error_free(&err); 
-	}
+	gpointer iface_key = GUINT_TO_POINTER(g_quark_from_static_string(interface));
 
-	if (NULL == g_conn) { 
-		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to get dbus connection" );
-		return -1;
+	GHashTable* member_table = g_hash_table_lookup(g_interface_table, iface_key);
+	if (NULL == member_table) {
+		member_table = g_hash_table_new(g_direct_hash, g_direct_equal);
+		g_hash_table_insert(g_interface_table, iface_key, member_table);
 	}
 
-	/* request our name on the bus and check for errors */
-	ret = dbus_bus_request_name(g_conn, STT_SERVER_SERVICE_NAME, DBUS_NAME_FLAG_REPLACE_EXISTING , &err);
+	g_hash_table_insert(member_table, GUINT_TO_POINTER(g_quark_from_static_string(member)), method);
+	g_method_list = g_list_append(g_method_list, method);
+}
 
-	if (DBUS_REQUEST_NAME_REPLY_PRIMARY_OWNER != ret) {
-		printf("Fail to be primary owner in dbus request.");
-		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to be primary owner");
-		return -1;
+void __set_startup_method(const char* member)
+{
+	GList *iter = g_list_first(g_method_list);
+	while (NULL != iter) {
+		sttd_dbus_method_s* method = iter->data;
+		if (0 == strcmp(method->member, member))
+			method->startup = true;
+		iter = g_list_next(iter);
 	}
+}
 
-	if (dbus_error_is_set(&err)) { 
-		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] dbus_bus_request_name() : %s", err.message);
-		dbus_error_free(&err); 
-		return -1;
+void __set_peer_method(const char* member)
+{
+	GList *iter = g_list_first(g_method_list);
+	while (NULL != iter) {
+		sttd_dbus_method_s* method = iter->data;
+		if (0 == strcmp(method->member, member) && false == method->setting)
+			method->peer = true;
+		iter = g_list_next(iter);
 	}
+}
 
-	/* add a rule for getting signal */
-	char rule[128];
-	snprintf(rule, 128, "type='signal',interface='%s'", STT_SERVER_SERVICE_INTERFACE);
+void __create_method_table()
+{
+	g_interface_table = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, (GDestroyNotify)g_hash_table_destroy);
 
-	/* add a rule for which messages we want to see */
+	/* daemon internal event */
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STTD_METHOD_STOP_BY_DAEMON, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		__stop_by_daemon, false, STTD_STATE_ANY);
+
+	/* bus name of client is changed */
+	__register_method(DBUS_INTERFACE_DBUS, "NameOwnerChanged", DBUS_MESSAGE_TYPE_SIGNAL, 
+		__name_owner_changed, false, STTD_STATE_ANY);
+
+	/* private connection of client is closed */
+	__register_method(DBUS_INTERFACE_LOCAL, "Disconnected", DBUS_MESSAGE_TYPE_SIGNAL, 
+		__peer_disconnected, false, STTD_STATE_ANY);
+
+	/* client event */
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_METHOD_HELLO, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_hello, false, STTD_STATE_ANY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_METHOD_PEER_HELLO, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_peer_hello, false, STTD_STATE_ANY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_METHOD_INITIALIZE, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_initialize, false, STTD_STATE_ANY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_METHOD_FINALIZE, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_finalize, false, STTD_STATE_ANY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_METHOD_GET_SUPPORT_LANGS, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_get_support_lang, false, STTD_STATE_ANY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_METHOD_GET_CURRENT_LANG, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_get_default_lang, false, STTD_STATE_ANY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_METHOD_IS_PARTIAL_SUPPORTED, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_is_partial_result_supported, false, STTD_STATE_ANY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_METHOD_GET_AUDIO_VOLUME, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_get_audio_volume, false, APP_STATE_RECORDING);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_METHOD_START, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_start, false, APP_STATE_READY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_METHOD_STOP, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_stop, false, APP_STATE_RECORDING);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_METHOD_CANCEL, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_cancel, false, STTD_STATE_ANY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_METHOD_PREWARM, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_prewarm, false, APP_STATE_READY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_METHOD_RECOGNIZE_ONCE, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_recognize_once, false, STTD_STATE_ANY);
+
+	/* setting event */
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_HELLO, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_hello, true, STTD_STATE_ANY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_INITIALIZE, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_setting_initialize, true, STTD_STATE_ANY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_FINALIZE, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_setting_finalize, true, STTD_STATE_ANY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_GET_ENGINE_LIST, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_setting_get_engine_list, true, STTD_STATE_ANY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_GET_ENGINE, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_setting_get_engine, true, STTD_STATE_ANY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_SET_ENGINE, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_setting_set_engine, true, STTD_STATE_ANY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_GET_LANG_LIST, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_setting_get_language_list, true, STTD_STATE_ANY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_GET_DEFAULT_LANG, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_setting_get_default_language, true, STTD_STATE_ANY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_SET_DEFAULT_LANG, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_setting_set_default_language, true, STTD_STATE_ANY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_GET_PROFANITY, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_setting_get_profanity_filter, true, STTD_STATE_ANY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_SET_PROFANITY, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_setting_set_profanity_filter, true, STTD_STATE_ANY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_GET_PUNCTUATION, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_setting_get_punctuation_override, true, STTD_STATE_ANY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_SET_PUNCTUATION, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_setting_set_punctuation_override, true, STTD_STATE_ANY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_GET_SILENCE, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_setting_get_silence_detection, true, STTD_STATE_ANY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_SET_SILENCE, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_setting_set_silence_detection, true, STTD_STATE_ANY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_GET_ENGINE_SETTING, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_setting_get_engine_setting, true, STTD_STATE_ANY);
+	__register_method(STT_SERVER_SERVICE_INTERFACE, STT_SETTING_METHOD_SET_ENGINE_SETTING, DBUS_MESSAGE_TYPE_METHOD_CALL, 
+		sttd_dbus_server_setting_set_engine_setting, true, STTD_STATE_ANY);
+
+	/* answered while subsystems are initialized */
+	__set_startup_method(STTD_METHOD_STOP_BY_DAEMON);
+	__set_startup_method("NameOwnerChanged");
+	__set_startup_method("Disconnected");
+	__set_startup_method(STT_METHOD_HELLO);
+	__set_startup_method(STT_METHOD_PEER_HELLO);
+	__set_startup_method(STT_SETTING_METHOD_HELLO);
+
+	/* private connection bypasses bus policy, so it serves client requests only */
+	__set_peer_method("Disconnected");
+	__set_peer_method(STT_METHOD_PEER_HELLO);
+	__set_peer_method(STT_METHOD_INITIALIZE);
+	__set_peer_method(STT_METHOD_FINALIZE);
+	__set_peer_method(STT_METHOD_GET_SUPPORT_LANGS);
+	__set_peer_method(STT_METHOD_GET_CURRENT_LANG);
+	__set_peer_method(STT_METHOD_IS_PARTIAL_SUPPORTED);
+	__set_peer_method(STT_METHOD_GET_AUDIO_VOLUME);
+	__set_peer_method(STT_METHOD_START);
+	__set_peer_method(STT_METHOD_STOP);
+	__set_peer_method(STT_METHOD_CANCEL);
+	__set_peer_method(STT_METHOD_PREWARM);
+	__set_peer_method(STT_METHOD_RECOGNIZE_ONCE);
+}
+
+void __destroy_method_table()
+{
+	if (NULL != g_interface_table) {
+		g_hash_table_destroy(g_interface_table);
+		g_interface_table = NULL;
+	}
+
+	GList *iter = g_list_first(g_method_list);
+	while (NULL != iter) {
+		free(iter->data);
+		iter = g_list_next(iter);
+	}
+
+	g_list_free(g_method_list);
+	g_method_list = NULL;
+}
+
+sttd_dbus_method_s* __find_method(DBusMessage* msg)
+{
+	const char* interface = dbus_message_get_interface(msg);
+	const char* member = dbus_message_get_member(msg);
+
+	if (NULL == interface || NULL == member || NULL == g_interface_table)
+		return NULL;
+
+	/* unknown names have no quark, so they are not interned */
+	GQuark iface_quark = g_quark_try_string(interface);
+	GQuark member_quark = g_quark_try_string(member);
+	if (0 == iface_quark || 0 == member_quark)
+		return NULL;
+
+	GHashTable* member_table = g_hash_table_lookup(g_interface_table, GUINT_TO_POINTER(iface_quark));
+	if (NULL == member_table)
+		return NULL;
+
+	sttd_dbus_method_s* method = g_hash_table_lookup(member_table, GUINT_TO_POINTER(member_quark));
+	if (NULL == method || method->type != dbus_message_get_type(msg))
+		return NULL;
+
+	return method;
+}
+
+bool __check_method_state(sttd_dbus_method_s* method, DBusMessage* msg)
+{
+	if (STTD_STATE_ANY == method->state)
+		return true;
+
+	/* uid is first argument of client methods */
+	DBusMessageIter args;
+	if (!dbus_message_iter_init(msg, &args) || DBUS_TYPE_INT32 != dbus_message_iter_get_arg_type(&args))
+		return false;
+
+	int uid = 0;
+	dbus_message_iter_get_basic(&args, &uid);
+
+	app_state_e state;
+	if (0 != sttd_client_get_state(uid, &state))
+		return false;
+
+	return (method->state == (int)state);
+}
+
+void __reply_access_denied(DBusConnection* conn, DBusMessage* msg)
+{
+	if (DBUS_MESSAGE_TYPE_METHOD_CALL != dbus_message_get_type(msg) || dbus_message_get_no_reply(msg))
+		return;
+
+	DBusMessage* reply = dbus_message_new_error(msg, DBUS_ERROR_ACCESS_DENIED, "Use the bus for this request");
+	if (NULL != reply) {
+		dbus_connection_send(conn, reply, NULL);
+		dbus_message_unref(reply);
+	}
+}
+
+void __dispatch_message(DBusConnection* conn, DBusMessage* msg)
+{
+	sttd_dbus_method_s* method = __find_method(msg);
+	if (NULL == method)
+		return;
+
+	if (conn != g_conn && false == method->peer) {
+		SLOG(LOG_WARN, TAG_STTD, "[Dbus WARNING] %s is not allowed on private connection", method->member);
+		__reply_access_denied(conn, msg);
+		return;
+	}
+
+	method->count++;
+
+	if (false == method->startup)
+		sttd_main_mark_startup(STTD_STARTUP_FIRST_REQUEST);
+
+	/* handler replies error for wrong state, count it for statistics */
+	if (false == __check_method_state(method, msg))
+		method->state_mismatch++;
+
+	double start = __dbus_get_time_ms();
+
+	method->handler(conn, msg);
+
+	double elapsed = __dbus_get_time_ms() - start;
+
+	method->total_time += elapsed;
+	if (method->max_time < elapsed)
+		method->max_time = elapsed;
+}
+
+gint __compare_method_time(gconstpointer a, gconstpointer b)
+{
+	const sttd_dbus_method_s* method_a = a;
+	const sttd_dbus_method_s* method_b = b;
+
+	if (method_a->total_time == method_b->total_time)
+		return 0;
+
+	return (method_a->total_time > method_b->total_time) ? -1 : 1;
+}
+
+int sttd_dbus_dump_method_stats()
+{
+	GList* sorted = g_list_sort(g_list_copy(g_method_list), __compare_method_time);
+
+	SLOG(LOG_DEBUG, TAG_STTD, "----- Dbus method statistics (sorted by total time)");
+
+	GList *iter = g_list_first(sorted);
+	while (NULL != iter) {
+		sttd_dbus_method_s* method = iter->data;
+
+		if (0 < method->count) {
+			SLOG(LOG_DEBUG, TAG_STTD, "%s%s : count(%u), state mismatch(%u), total(%.3f ms), avg(%.3f ms), max(%.3f ms)", 
+				method->setting ? "[setting] " : "", method->member, method->count, method->state_mismatch, 
+				method->total_time, method->total_time / method->count, method->max_time);
+		}
+
+		iter = g_list_next(iter);
+	}
+
+	SLOG(LOG_DEBUG, TAG_STTD, "-----");
+
+	g_list_free(sorted);
+
+	return 0;
+}
+
+/*
+* I/O thread
+*/
+
+/* I/O thread pushes and main loop pops. size should be power of 2 */
+#define STTD_DBUS_QUEUE_SIZE	256
+
+/* private connections serviced at once */
+#define STTD_DBUS_MAX_PEER	16
+
+typedef struct {
+	DBusConnection*		conn;
+	DBusMessage*		msg;
+} sttd_queue_item_s;
+
+static sttd_queue_item_s g_msg_queue[STTD_DBUS_QUEUE_SIZE];
+static unsigned int g_queue_head = 0;	/* written by main loop only */
+static unsigned int g_queue_tail = 0;	/* written by I/O thread only */
+
+/* requests which arrive before daemon is ready, in order */
+static bool g_daemon_ready = false;
+static GList* g_deferred_list = NULL;
+
+/* method calls whose reply waits until server finishes the request */
+typedef struct {
+	int		uid;		/* pid for setting client */
+	bool		setting;
+	DBusConnection*	conn;
+	DBusMessage*	msg;
+} sttd_held_reply_s;
+
+static GList* g_held_reply_list = NULL;
+
+static pthread_t g_io_thread;
+static bool g_io_running = false;
+static int g_wake_pipe[2] = {-1, -1};
+static int g_drain_requested = 0;
+static int g_io_stalled = 0;
+
+/* owned by I/O thread while it runs */
+static DBusWatch* g_server_watch = NULL;
+static DBusConnection* g_io_peer[STTD_DBUS_MAX_PEER];
+static int g_io_peer_count = 0;
+
+bool __queue_push(DBusConnection* conn, DBusMessage* msg)
+{
+	unsigned int tail = __atomic_load_n(&g_queue_tail, __ATOMIC_RELAXED);
+	unsigned int head = __atomic_load_n(&g_queue_head, __ATOMIC_ACQUIRE);
+
+	if (STTD_DBUS_QUEUE_SIZE == tail - head)
+		return false;
+
+	/* connection lives until main loop handles message */
+	g_msg_queue[tail & (STTD_DBUS_QUEUE_SIZE - 1)].conn = dbus_connection_ref(conn);
+	g_msg_queue[tail & (STTD_DBUS_QUEUE_SIZE - 1)].msg = msg;
+	__atomic_store_n(&g_queue_tail, tail + 1, __ATOMIC_RELEASE);
+
+	return true;
+}
+
+DBusMessage* __queue_pop(DBusConnection** conn)
+{
+	unsigned int head = __atomic_load_n(&g_queue_head, __ATOMIC_RELAXED);
+	unsigned int tail = __atomic_load_n(&g_queue_tail, __ATOMIC_ACQUIRE);
+
+	if (head == tail)
+		return NULL;
+
+	*conn = g_msg_queue[head & (STTD_DBUS_QUEUE_SIZE - 1)].conn;
+	DBusMessage* msg = g_msg_queue[head & (STTD_DBUS_QUEUE_SIZE - 1)].msg;
+	__atomic_store_n(&g_queue_head, head + 1, __ATOMIC_RELEASE);
+
+	return msg;
+}
+
+void __wake_io_thread()
+{
+	char c = 0;
+	if (0 > write(g_wake_pipe[1], &c, 1) && EAGAIN != errno) 
+		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to wake I/O thread");
+}
+
+/* libdbus calls this when message is queued to send from main loop */
+void __wakeup_main(void* data)
+{
+	__wake_io_thread();
+}
+
+/* group of users which bus policy allows, resolved when peer server is opened */
+static gid_t g_peer_gid = 0;
+
+/* called in I/O thread while connection is authenticated */
+dbus_bool_t __allow_unix_user(DBusConnection* conn, unsigned long uid, void* data)
+{
+	if (0 == uid)
+		return TRUE;
+
+	struct passwd pwd;
+	struct passwd* result = NULL;
+	char buf[1024];
+
+	if (0 != getpwuid_r((uid_t)uid, &pwd, buf, sizeof(buf), &result) || NULL == result) {
+		SLOG(LOG_WARN, TAG_STTD, "[Dbus WARNING] Unknown user(%lu) of private connection", uid);
+		return FALSE;
+	}
+
+	if (g_peer_gid == pwd.pw_gid)
+		return TRUE;
+
+	gid_t groups[64];
+	int count = 64;
+	int i;
+
+	if (-1 != getgrouplist(pwd.pw_name, pwd.pw_gid, groups, &count)) {
+		for (i = 0;i < count;i++) {
+			if (g_peer_gid == groups[i])
+				return TRUE;
+		}
+	}
+
+	SLOG(LOG_WARN, TAG_STTD, "[Dbus WARNING] User(%lu) is not allowed on private connection", uid);
+
+	return FALSE;
+}
+
+/* called in I/O thread when client connects to peer server */
+void __peer_accepted(DBusServer* server, DBusConnection* conn, void* data)
+{
+	if (STTD_DBUS_MAX_PEER <= g_io_peer_count) {
+		/* not referenced connection is closed by libdbus. client uses the bus */
+		SLOG(LOG_WARN, TAG_STTD, "[Dbus WARNING] Too many private connections");
+		return;
+	}
+
+	dbus_connection_ref(conn);
+	dbus_connection_set_unix_user_function(conn, __allow_unix_user, NULL, NULL);
+	dbus_connection_set_wakeup_main_function(conn, __wakeup_main, NULL, NULL);
+
+	g_io_peer[g_io_peer_count++] = conn;
+}
+
+dbus_bool_t __add_server_watch(DBusWatch* watch, void* data)
+{
+	g_server_watch = watch;
+	return TRUE;
+}
+
+void __remove_server_watch(DBusWatch* watch, void* data)
+{
+	if (watch == g_server_watch)
+		g_server_watch = NULL;
+}
+
+int __open_peer_server()
+{
+	DBusError err;
+	dbus_error_init(&err);
+
+	struct group* grp = getgrnam(STT_PEER_SOCKET_GROUP);
+	if (NULL == grp) {
+		SLOG(LOG_WARN, TAG_STTD, "[Dbus WARNING] Group(%s) is not found. Use the bus only", STT_PEER_SOCKET_GROUP);
+		return -1;
+	}
+	g_peer_gid = grp->gr_gid;
+
+	/* directory which other users can not replace */
+	if (0 != mkdir(STT_PEER_SOCKET_DIR, 0750) && EEXIST != errno) {
+		SLOG(LOG_WARN, TAG_STTD, "[Dbus WARNING] Fail to make %s : %d", STT_PEER_SOCKET_DIR, errno);
+		return -1;
+	}
+
+	struct stat st;
+	if (0 != lstat(STT_PEER_SOCKET_DIR, &st) || !S_ISDIR(st.st_mode) || 0 != st.st_uid) {
+		SLOG(LOG_WARN, TAG_STTD, "[Dbus WARNING] %s is not directory of root. Use the bus only", STT_PEER_SOCKET_DIR);
+		return -1;
+	}
+
+	if (0 != chown(STT_PEER_SOCKET_DIR, 0, g_peer_gid) || 0 != chmod(STT_PEER_SOCKET_DIR, 0750)) {
+		SLOG(LOG_WARN, TAG_STTD, "[Dbus WARNING] Fail to set owner of %s", STT_PEER_SOCKET_DIR);
+		return -1;
+	}
+
+	/* socket of previous daemon */
+	unlink(STT_PEER_SOCKET_PATH);
+
+	g_peer_server = dbus_server_listen(STT_PEER_ADDRESS, &err);
+
+	if (NULL == g_peer_server) {
+		SLOG(LOG_WARN, TAG_STTD, "[Dbus WARNING] Fail to listen private connection : %s", err.message);
+		dbus_error_free(&err);
+		return -1;
+	}
+
+	dbus_server_set_new_connection_function(g_peer_server, __peer_accepted, NULL, NULL);
+	dbus_server_set_watch_functions(g_peer_server, __add_server_watch, __remove_server_watch, NULL, NULL, NULL);
+
+	if (0 != chown(STT_PEER_SOCKET_PATH, 0, g_peer_gid) || 0 != chmod(STT_PEER_SOCKET_PATH, 0660)) {
+		SLOG(LOG_WARN, TAG_STTD, "[Dbus WARNING] Fail to set permission of %s", STT_PEER_SOCKET_PATH);
+		dbus_server_disconnect(g_peer_server);
+		dbus_server_unref(g_peer_server);
+		g_peer_server = NULL;
+		unlink(STT_PEER_SOCKET_PATH);
+		return -1;
+	}
+
+	SLOG(LOG_DEBUG, TAG_STTD, "[Dbus] Listen private connection : %s", STT_PEER_ADDRESS);
+
+	return 0;
+}
+
+void __close_peer_server()
+{
+	int i;
+	for (i = 0;i < g_io_peer_count;i++) {
+		dbus_connection_close(g_io_peer[i]);
+		dbus_connection_unref(g_io_peer[i]);
+	}
+	g_io_peer_count = 0;
+
+	while (NULL != g_peer_list) {
+		sttd_peer_s* peer = g_peer_list->data;
+		g_peer_list = g_list_remove(g_peer_list, peer);
+		dbus_connection_unref(peer->conn);
+		free(peer);
+	}
+
+	if (NULL != g_peer_server) {
+		dbus_server_disconnect(g_peer_server);
+		dbus_server_unref(g_peer_server);
+		g_peer_server = NULL;
+		unlink(STT_PEER_SOCKET_PATH);
+	}
+}
+
+/** Move incoming messages of connection into queue. Return true if any is moved */
+bool __pump_messages(DBusConnection* conn)
+{
+	bool pushed = false;
+	DBusMessage* msg;
+
+	while (DBUS_DISPATCH_DATA_REMAINS == dbus_connection_get_dispatch_status(conn)) {
+		msg = dbus_connection_borrow_message(conn);
+		if (NULL == msg)
+			break;
+
+		if (false == __queue_push(conn, msg)) {
+			/* main loop wakes this thread after it makes room */
+			dbus_connection_return_message(conn, msg);
+			__atomic_store_n(&g_io_stalled, 1, __ATOMIC_RELEASE);
+			break;
+		}
+
+		dbus_connection_steal_borrowed_message(conn, msg);
+		pushed = true;
+	}
+
+	return pushed;
+}
+
+void __request_drain(void* data);
+
+void* __io_thread_func(void* data)
+{
+	DBusConnection* conn = (DBusConnection*)data;
+
+	int fd = 0;
+	dbus_connection_get_unix_fd(conn, &fd);
+
+	/* wake pipe, bus, peer server and private connections */
+	struct pollfd fds[3 + STTD_DBUS_MAX_PEER];
+	int server_index;
+	int nfds;
+	int i;
+	short events;
+
+	while (true == __atomic_load_n(&g_io_running, __ATOMIC_ACQUIRE)) {
+		/* stop reading while main loop is behind */
+		events = (1 == __atomic_load_n(&g_io_stalled, __ATOMIC_ACQUIRE)) ? 0 : POLLIN;
+
+		fds[0].fd = g_wake_pipe[0];
+		fds[0].events = POLLIN;
+		fds[1].fd = fd;
+		fds[1].events = events;
+		if (dbus_connection_has_messages_to_send(conn))
+			fds[1].events |= POLLOUT;
+		nfds = 2;
+
+		server_index = -1;
+		if (NULL != g_server_watch && dbus_watch_get_enabled(g_server_watch)) {
+			server_index = nfds;
+			fds[nfds].fd = dbus_watch_get_unix_fd(g_server_watch);
+			fds[nfds].events = events;
+			nfds++;
+		}
+
+		for (i = 0;i < g_io_peer_count;i++) {
+			fds[nfds].fd = -1;
+			dbus_connection_get_unix_fd(g_io_peer[i], &fds[nfds].fd);
+			fds[nfds].events = events;
+			if (dbus_connection_has_messages_to_send(g_io_peer[i]))
+				fds[nfds].events |= POLLOUT;
+			nfds++;
+		}
+
+		if (0 > poll(fds, nfds, -1)) {
+			if (EINTR == errno)
+				continue;
+			SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to poll : %d", errno);
+			break;
+		}
+
+		if (fds[0].revents & POLLIN) {
+			char buf[64];
+			while (0 < read(g_wake_pipe[0], buf, sizeof(buf)));
+		}
+
+		/* accept new private connection */
+		if (0 <= server_index && 0 != fds[server_index].revents) 
+			dbus_watch_handle(g_server_watch, DBUS_WATCH_READABLE);
+
+		/* read, parse and write what is available without blocking */
+		if (!dbus_connection_read_write(conn, 0)) {
+			SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Connection is closed");
+			break;
+		}
+
+		bool pushed = __pump_messages(conn);
+
+		for (i = g_io_peer_count - 1;i >= 0;i--) {
+			dbus_connection_read_write(g_io_peer[i], 0);
+
+			if (true == __pump_messages(g_io_peer[i]))
+				pushed = true;
+
+			/* Disconnected message is passed to main loop before connection is dropped */
+			if (!dbus_connection_get_is_connected(g_io_peer[i]) 
+				&& DBUS_DISPATCH_COMPLETE == dbus_connection_get_dispatch_status(g_io_peer[i])) {
+				dbus_connection_unref(g_io_peer[i]);
+				g_io_peer[i] = g_io_peer[--g_io_peer_count];
+			}
+		}
+
+		if (true == pushed && 0 == __atomic_exchange_n(&g_drain_requested, 1, __ATOMIC_ACQ_REL))
+			ecore_main_loop_thread_safe_call_async(__request_drain, conn);
+	}
+
+	return NULL;
+}
+
+bool __is_startup_message(DBusMessage* msg)
+{
+	sttd_dbus_method_s* method = __find_method(msg);
+
+	/* unknown message is dropped by dispatch anyway */
+	return (NULL == method || true == method->startup);
+}
+
+void __defer_message(DBusConnection* conn, DBusMessage* msg)
+{
+	sttd_queue_item_s* item = (sttd_queue_item_s*)malloc(sizeof(sttd_queue_item_s));
+	if (NULL == item) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to allocate memory, drop request");
+		return;
+	}
+
+	item->conn = dbus_connection_ref(conn);
+	item->msg = dbus_message_ref(msg);
+
+	g_deferred_list = g_list_append(g_deferred_list, item);
+}
+
+void __free_deferred_message(sttd_queue_item_s* item)
+{
+	dbus_message_unref(item->msg);
+	dbus_connection_unref(item->conn);
+	free(item);
+}
+
+int sttd_dbus_set_ready()
+{
+	if (true == g_daemon_ready)
+		return 0;
+
+	g_daemon_ready = true;
+
+	SLOG(LOG_DEBUG, TAG_STTD, "[Dbus] Daemon is ready : deferred request(%d)", g_list_length(g_deferred_list));
+
+	while (NULL != g_deferred_list) {
+		sttd_queue_item_s* item = g_deferred_list->data;
+		g_deferred_list = g_list_delete_link(g_deferred_list, g_deferred_list);
+
+		__dispatch_message(item->conn, item->msg);
+		__free_deferred_message(item);
+	}
+
+	return 0;
+}
+
+int __hold_reply(int id, bool setting, DBusConnection* conn, DBusMessage* msg)
+{
+	sttd_held_reply_s* held = (sttd_held_reply_s*)malloc(sizeof(sttd_held_reply_s));
+	if (NULL == held) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to allocate memory");
+		return -1;
+	}
+
+	held->uid = id;
+	held->setting = setting;
+	held->conn = dbus_connection_ref(conn);
+	held->msg = dbus_message_ref(msg);
+
+	g_held_reply_list = g_list_append(g_held_reply_list, held);
+
+	return 0;
+}
+
+int sttd_dbus_hold_reply(int uid, DBusConnection* conn, DBusMessage* msg)
+{
+	return __hold_reply(uid, false, conn, msg);
+}
+
+int sttd_dbus_hold_setting_reply(int pid, DBusConnection* conn, DBusMessage* msg)
+{
+	return __hold_reply(pid, true, conn, msg);
+}
+
+void __free_held_reply(sttd_held_reply_s* held)
+{
+	g_held_reply_list = g_list_remove(g_held_reply_list, held);
+
+	dbus_message_unref(held->msg);
+	dbus_connection_unref(held->conn);
+	free(held);
+}
+
+sttd_held_reply_s* __find_held_reply(int id, bool setting)
+{
+	GList *iter = g_list_first(g_held_reply_list);
+
+	while (NULL != iter) {
+		sttd_held_reply_s* held = iter->data;
+		if (id == held->uid && setting == held->setting)
+			return held;
+		iter = g_list_next(iter);
+	}
+
+	return NULL;
+}
+
+void __send_held_reply(sttd_held_reply_s* held, int result)
+{
+	DBusMessage* reply = dbus_message_new_method_return(held->msg);
+	if (NULL == reply) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to create reply message");
+		__free_held_reply(held);
+		return;
+	}
+
+	dbus_message_append_args(reply, DBUS_TYPE_INT32, &result, DBUS_TYPE_INVALID);
+
+	if (!dbus_connection_send(held->conn, reply, NULL)) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to send reply : id(%d)", held->uid);
+	} else {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Dbus] Send held reply : id(%d), result(%d)", held->uid, result);
+	}
+
+	dbus_message_unref(reply);
+	__free_held_reply(held);
+}
+
+int sttd_dbus_send_held_reply(int uid, int result)
+{
+	sttd_held_reply_s* held = __find_held_reply(uid, false);
+
+	if (NULL == held) {
+		SLOG(LOG_WARN, TAG_STTD, "[Dbus WARNING] No reply is held : uid(%d)", uid);
+		return -1;
+	}
+
+	__send_held_reply(held, result);
+
+	return 0;
+}
+
+int sttd_dbus_send_held_setting_reply(int pid, int result)
+{
+	sttd_held_reply_s* held = __find_held_reply(pid, true);
+
+	if (NULL == held) {
+		SLOG(LOG_WARN, TAG_STTD, "[Dbus WARNING] No reply is held : setting pid(%d)", pid);
+		return -1;
+	}
+
+	/* client may call again after its call is timed out */
+	while (NULL != held) {
+		__send_held_reply(held, result);
+		held = __find_held_reply(pid, true);
+	}
+
+	return 0;
+}
+
+/** Handle queued messages up to budget. Return true if messages remain */
+bool __drain_messages()
+{
+	DBusConnection* conn = NULL;
+	DBusMessage* msg = NULL;
+	int count = 0;
+
+	while (STTD_DBUS_DISPATCH_BUDGET > count) {
+		msg = __queue_pop(&conn);
+		if (NULL == msg)
+			break;
+
+		count++;
+
+		/* reply of client completes its pending call */
+		if (DBUS_MESSAGE_TYPE_METHOD_RETURN == dbus_message_get_type(msg) || DBUS_MESSAGE_TYPE_ERROR == dbus_message_get_type(msg)) 
+			__handle_reply(conn, msg);
+		else if (false == g_daemon_ready && false == __is_startup_message(msg))
+			__defer_message(conn, msg);
+		else 
+			__dispatch_message(conn, msg);
+
+		/* free the message */
+		dbus_message_unref(msg);
+		dbus_connection_unref(conn);
+	}
+
+	/* resume reading of I/O thread */
+	if (1 == __atomic_exchange_n(&g_io_stalled, 0, __ATOMIC_ACQ_REL))
+		__wake_io_thread();
+
+	return (__atomic_load_n(&g_queue_head, __ATOMIC_RELAXED) != __atomic_load_n(&g_queue_tail, __ATOMIC_ACQUIRE));
+}
+
+Eina_Bool __drain_by_timer(void* data)
+{
+	/* other timers and fd handlers run between batches */
+	if (true == __drain_messages())
+		return EINA_TRUE;
+
+	g_drain_timer = NULL;
+	return EINA_FALSE;
+}
+
+/* called in main loop by I/O thread */
+void __request_drain(void* data)
+{
+	__atomic_store_n(&g_drain_requested, 0, __ATOMIC_RELEASE);
+
+	if (NULL != g_drain_timer)
+		return;
+
+	if (true == __drain_messages())
+		g_drain_timer = ecore_timer_add(0, __drain_by_timer, NULL);
+}
+
+int __start_io_thread()
+{
+	if (0 != pipe(g_wake_pipe)) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to create pipe");
+		return -1;
+	}
+
+	fcntl(g_wake_pipe[0], F_SETFL, O_NONBLOCK);
+	fcntl(g_wake_pipe[1], F_SETFL, O_NONBLOCK);
+
+	dbus_connection_set_wakeup_main_function(g_conn, __wakeup_main, NULL, NULL);
+
+	/* daemon works on the bus only without peer server */
+	__open_peer_server();
+
+	g_io_running = true;
+
+	if (0 != pthread_create(&g_io_thread, NULL, __io_thread_func, g_conn)) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to create I/O thread");
+		g_io_running = false;
+		return -1;
+	}
+
+	return 0;
+}
+
+void __stop_io_thread()
+{
+	if (false == g_io_running)
+		return;
+
+	__atomic_store_n(&g_io_running, false, __ATOMIC_RELEASE);
+	__wake_io_thread();
+
+	pthread_join(g_io_thread, NULL);
+
+	dbus_connection_set_wakeup_main_function(g_conn, NULL, NULL, NULL);
+
+	/* drop requests which are not handled */
+	DBusConnection* conn;
+	DBusMessage* msg;
+	while (NULL != (msg = __queue_pop(&conn))) {
+		dbus_message_unref(msg);
+		dbus_connection_unref(conn);
+	}
+
+	__close_peer_server();
+
+	close(g_wake_pipe[0]);
+	close(g_wake_pipe[1]);
+	g_wake_pipe[0] = g_wake_pipe[1] = -1;
+}
+
+int sttd_dbus_open_connection()
+{
+	DBusError err;
+	dbus_error_init(&err);
+
+	int ret;
+
+	/* connection is shared with I/O thread */
+	dbus_threads_init_default();
+
+	/* connect to the bus and check for errors */
+	g_conn = dbus_bus_get(DBUS_BUS_SYSTEM, &err);
+
+	if (dbus_error_is_set(&err)) { 
+		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail dbus_bus_get : %s", err.message);
+		dbus_error_free(&err); 
+	}
+
+	if (NULL == g_conn) { 
+		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to get dbus connection" );
+		return -1;
+	}
+
+	/* request our name on the bus and check for errors */
+	ret = dbus_bus_request_name(g_conn, STT_SERVER_SERVICE_NAME, DBUS_NAME_FLAG_REPLACE_EXISTING , &err);
+
+	if (DBUS_REQUEST_NAME_REPLY_PRIMARY_OWNER != ret) {
+		printf("Fail to be primary owner in dbus request.");
+		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to be primary owner");
+		return -1;
+	}
+
+	if (dbus_error_is_set(&err)) { 
+		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] dbus_bus_request_name() : %s", err.message);
+		dbus_error_free(&err); 
+		return -1;
+	}
+
+	/* add a rule for getting signal */
+	char rule[128];
+	snprintf(rule, 128, "type='signal',interface='%s'", STT_SERVER_SERVICE_INTERFACE);
+
+	/* add a rule for which messages we want to see */
 	dbus_bus_add_match(g_conn, rule, &err); /* see signals from the given interface */
-	dbus_connection_flush(g_conn);
 
 	if (dbus_error_is_set(&err)) { 
 		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] dbus_bus_add_match() : %s", err.message);
 		return -1; 
 	}
 
-	int fd = 0;
-	dbus_connection_get_unix_fd(g_conn, &fd);
-
 	if (!ecore_init()) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] ecore_init()");
 		return -1;
 	}
 
-	Ecore_Fd_Handler* fd_handler;
-	fd_handler = ecore_main_fd_handler_add(fd, ECORE_FD_READ , (Ecore_Fd_Cb)listener_event_callback, g_conn, NULL, NULL);
+	__create_method_table();
 
-	if (NULL == fd_handler) {
-		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to get fd handler");
+	/* connection is serviced by I/O thread from now on */
+	if (0 != __start_io_thread()) {
 		return -1;
 	}
 
@@ -618,6 +1768,31 @@ int sttd_dbus_close_connection()
 	DBusError err;
 	dbus_error_init(&err);
 
+	/* blocking call below needs the connection for itself */
+	__stop_io_thread();
+
+	/* drop calls waiting for reply */
+	while (NULL != g_pending_list) {
+		sttdc_pending_s* call = g_pending_list->data;
+		call->callback = NULL;
+		__complete_pending_call(call, -1);
+	}
+
+	if (NULL != g_drain_timer) {
+		ecore_timer_del(g_drain_timer);
+		g_drain_timer = NULL;
+	}
+
+	while (NULL != g_deferred_list) {
+		__free_deferred_message(g_deferred_list->data);
+		g_deferred_list = g_list_delete_link(g_deferred_list, g_deferred_list);
+	}
+
+	while (NULL != g_held_reply_list)
+		__free_held_reply(g_held_reply_list->data);
+
+	__destroy_method_table();
+
 	dbus_bus_release_name (g_conn, STT_SERVER_SERVICE_NAME, &err);
 
 	if (dbus_error_is_set(&err)) {
@@ -629,6 +1804,154 @@ int sttd_dbus_close_connection()
 	return 0;
 }
 
+int sttd_dbus_append_capability(DBusMessage* msg, const sttd_capability_s* capability)
+{
+	DBusMessageIter args;
+	dbus_message_iter_init_append(msg, &args);
+
+	int partial = (int)capability->partial_result;
+	const char* default_lang = (NULL != capability->default_lang) ? capability->default_lang : "";
+	int size = g_list_length(capability->lang_list);
+
+	if (!dbus_message_iter_append_basic(&args, DBUS_TYPE_INT32, &partial) ||
+	    !dbus_message_iter_append_basic(&args, DBUS_TYPE_STRING, &default_lang) ||
+	    !dbus_message_iter_append_basic(&args, DBUS_TYPE_INT32, &size)) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to append capability"); 
+		return -1;
+	}
+
+	GList* iter = g_list_first(capability->lang_list);
+	while (NULL != iter) {
+		const char* lang = (NULL != iter->data) ? iter->data : "";
+
+		if (!dbus_message_iter_append_basic(&args, DBUS_TYPE_STRING, &lang)) {
+			SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to append language"); 
+			return -1;
+		}
+
+		iter = g_list_next(iter);
+	}
+
+	return 0;
+}
+
+int sttdc_send_engine_ready(int uid, int result, const sttd_capability_s* capability, sttdc_reply_cb callback, void* user_data)
+{
+	int pid = sttd_client_get_pid(uid);
+
+	if (0 > pid) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] pid is NOT valid");
+		return -1;
+	}
+
+	char service_name[64];
+	memset(service_name, 0, 64);
+	snprintf(service_name, 64, "%s%d", STT_CLIENT_SERVICE_NAME, pid);
+
+	char target_if_name[128];
+	snprintf(target_if_name, sizeof(target_if_name), "%s%d", STT_CLIENT_SERVICE_INTERFACE, pid);
+
+	DBusMessage* msg;
+
+	SLOG(LOG_DEBUG, TAG_STTD, "[Dbus] Send engine ready message : uid(%d), result(%d)", uid, result);
+
+	msg = dbus_message_new_method_call(
+		service_name, 
+		STT_CLIENT_SERVICE_OBJECT_PATH, 
+		target_if_name, 
+		STTD_METHOD_ENGINE_READY);
+
+	if (NULL == msg) { 
+		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to create message"); 
+		return -1;
+	}
+
+	int silence = 0;
+	int profanity = 0;
+	int punctuation = 0;
+
+	if (NULL != capability) {
+		silence = (int)capability->silence;
+		profanity = (int)capability->profanity;
+		punctuation = (int)capability->punctuation;
+	}
+
+	dbus_message_append_args(msg, 
+		DBUS_TYPE_INT32, &uid, 
+		DBUS_TYPE_INT32, &result, 
+		DBUS_TYPE_INT32, &silence, 
+		DBUS_TYPE_INT32, &profanity, 
+		DBUS_TYPE_INT32, &punctuation, 
+		DBUS_TYPE_INVALID);
+
+	/* client asks daemon again if capability is missing */
+	if (0 == result && NULL != capability) 
+		sttd_dbus_append_capability(msg, capability);
+
+	return __send_async(uid, msg, callback, user_data);
+}
+
+int sttdc_send_engine_changed(int uid, const sttd_capability_s* capability)
+{
+	int pid = sttd_client_get_pid(uid);
+
+	if (0 > pid) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] pid is NOT valid");
+		return -1;
+	}
+
+	char service_name[64];
+	memset(service_name, 0, 64);
+	snprintf(service_name, 64, "%s%d", STT_CLIENT_SERVICE_NAME, pid);
+
+	char target_if_name[128];
+	snprintf(target_if_name, sizeof(target_if_name), "%s%d", STT_CLIENT_SERVICE_INTERFACE, pid);
+
+	DBusMessage* msg;
+
+	SLOG(LOG_DEBUG, TAG_STTD, "[Dbus] Send engine changed message : uid(%d)", uid);
+
+	msg = dbus_message_new_method_call(
+		service_name, 
+		STT_CLIENT_SERVICE_OBJECT_PATH, 
+		target_if_name, 
+		STTD_METHOD_ENGINE_CHANGED);
+
+	if (NULL == msg) { 
+		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to create message"); 
+		return -1;
+	}
+
+	dbus_message_append_args(msg, DBUS_TYPE_INT32, &uid, DBUS_TYPE_INVALID);
+
+	/* without capability, client only drops its cache */
+	if (NULL != capability) {
+		int silence = (int)capability->silence;
+		int profanity = (int)capability->profanity;
+		int punctuation = (int)capability->punctuation;
+
+		dbus_message_append_args(msg, 
+			DBUS_TYPE_INT32, &silence, 
+			DBUS_TYPE_INT32, &profanity, 
+			DBUS_TYPE_INT32, &punctuation, 
+			DBUS_TYPE_INVALID);
+
+		sttd_dbus_append_capability(msg, capability);
+	}
+
+	dbus_message_set_no_reply(msg, TRUE);
+
+	if (!dbus_connection_send(__get_client_conn(pid), msg, NULL)) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to send message : Out Of Memory !"); 
+		dbus_message_unref(msg);
+		return -1;
+	}
+
+	dbus_message_unref(msg);
+
+	return 0;
+}
+
 int sttd_send_stop_recognition_by_daemon(int uid)
 {
 	DBusMessage* msg;
@@ -650,7 +1973,6 @@ int sttd_send_stop_recognition_by_daemon(int uid)
 		SLOG(LOG_ERROR, TAG_STTD, "[Dbus ERROR] Fail to send message for 'stop by daemon'"); 
 	}
 
-	dbus_connection_flush(g_conn);
 	dbus_message_unref(msg);
 
 	return 0;
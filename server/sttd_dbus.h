@@ -19,22 +19,68 @@
 extern "C" {
 #endif
 
+#include <dbus/dbus.h>
+
 int sttd_dbus_open_connection();
 
 int sttd_dbus_close_connection();
 
+/** Requests except hello wait until daemon is ready. Waiting requests are handled in order */
+int sttd_dbus_set_ready();
+
+/** Keep method call of uid to reply later with sttd_dbus_send_held_reply() */
+int sttd_dbus_hold_reply(int uid, DBusConnection* conn, DBusMessage* msg);
+
+/** Reply result to method call held for uid */
+int sttd_dbus_send_held_reply(int uid, int result);
+
+/** Keep method call of setting client to reply later with sttd_dbus_send_held_setting_reply() */
+int sttd_dbus_hold_setting_reply(int pid, DBusConnection* conn, DBusMessage* msg);
+
+/** Reply result to all method calls held for setting client */
+int sttd_dbus_send_held_setting_reply(int pid, int result);
+
+/** Watch bus name of client to detect that client is gone. Fail if client has already left bus */
+int sttd_dbus_watch_client(int pid);
+
+int sttd_dbus_unwatch_client(int pid);
+
+/** Use private connection of client process instead of the bus */
+int sttd_dbus_bind_peer(int pid, DBusConnection* conn);
 
-int sttdc_send_hello(int uid);
+/** Write call count and handling time of each method into log */
+int sttd_dbus_dump_method_stats();
 
-int sttdc_send_get_state(int uid, int* state);
+/** Append partial result support, default language and language list for capability cache of client */
+int sttd_dbus_append_capability(DBusMessage* msg, const sttd_capability_s* capability);
+
+
+/** Called in main loop with reply of client. result is -1 if client does not reply in time */
+typedef void (*sttdc_reply_cb)(int uid, int result, void* user_data);
+
+/* Daemon never waits for client. Return value means only that message is sent. */
+
+int sttdc_send_hello(int uid, sttdc_reply_cb callback, void* user_data);
+
+/** result of callback is state of client */
+int sttdc_send_get_state(int uid, sttdc_reply_cb callback, void* user_data);
 
 int sttdc_send_result(int uid, const char* type, const char** data, int data_count, const char* result_msg);
 
-int sttdc_send_partial_result(int uid, const char* data);
+/** Client keeps first keep bytes of previous partial result and appends suffix */
+int sttdc_send_partial_result(int uid, int keep, const char* suffix);
 
 int sttdc_send_error_signal(int uid, int reason, char *err_msg);
 
-int sttdc_send_set_state(int uid, int state);
+int sttdc_send_set_state(int uid, int state, sttdc_reply_cb callback, void* user_data);
+
+/** Capability is appended only when result is 0 */
+int sttdc_send_engine_ready(int uid, int result, const sttd_capability_s* capability, sttdc_reply_cb callback, void* user_data);
+
+/** Client drops its capability cache if capability is NULL */
+int sttdc_send_engine_changed(int uid, const sttd_capability_s* capability);
+
+int sttdc_send_queue_position(int uid, int position);
 
 int sttd_send_stop_recognition_by_daemon(int uid);
 
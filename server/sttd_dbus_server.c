@@ -35,7 +35,64 @@ int sttd_dbus_server_hello(DBusConnection* conn, DBusMessage* msg)
 			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Out Of Memory!");
 		}
 
-		dbus_connection_flush(conn);
+		dbus_message_unref(reply);
+	} else {
+		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
+	}
+
+	SLOG(LOG_DEBUG, TAG_STTD, "<<<<<");
+	SLOG(LOG_DEBUG, TAG_STTD, "  ");
+
+	return 0;
+}
+
+int sttd_dbus_server_peer_hello(DBusConnection* conn, DBusMessage* msg)
+{
+	DBusError err;
+	dbus_error_init(&err);
+
+	int pid;
+	int ret = STTD_ERROR_OPERATION_FAILED;
+
+	dbus_message_get_args(msg, &err, DBUS_TYPE_INT32, &pid, DBUS_TYPE_INVALID);
+
+	SLOG(LOG_DEBUG, TAG_STTD, ">>>>> STT Peer Hello");
+
+	if (dbus_error_is_set(&err)) { 
+		SLOG(LOG_ERROR, TAG_STTD, "[IN ERROR] stt peer hello : get arguments error (%s)", err.message);
+		dbus_error_free(&err); 
+		ret = STTD_ERROR_OPERATION_FAILED;
+	} else {
+		/* credential of socket is more reliable than argument */
+		unsigned long peer_pid = 0;
+		if (!dbus_connection_get_unix_process_id(conn, &peer_pid)) {
+			SLOG(LOG_ERROR, TAG_STTD, "[IN ERROR] stt peer hello : credential of connection is not available");
+			ret = STTD_ERROR_INVALID_PARAMETER;
+		} else if ((int)peer_pid != pid) {
+			SLOG(LOG_ERROR, TAG_STTD, "[IN ERROR] stt peer hello : pid(%d) is not process of connection(%lu)", pid, peer_pid);
+			ret = STTD_ERROR_INVALID_PARAMETER;
+		} else {
+			SLOG(LOG_DEBUG, TAG_STTD, "[IN] stt peer hello : pid(%d)", pid);
+			ret = sttd_dbus_bind_peer(pid, conn);
+		}
+	}
+
+	DBusMessage* reply;
+	reply = dbus_message_new_method_return(msg);
+
+	if (NULL != reply) {
+		dbus_message_append_args(reply, DBUS_TYPE_INT32, &ret, DBUS_TYPE_INVALID);
+
+		if (0 == ret) {
+			SLOG(LOG_DEBUG, TAG_STTD, "[OUT SUCCESS] Result(%d)", ret); 
+		} else {
+			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Result(%d)", ret); 
+		}
+
+		if (!dbus_connection_send(conn, reply, NULL)) {
+			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Out Of Memory!");
+		}
+
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
@@ -54,9 +111,11 @@ int sttd_dbus_server_initialize(DBusConnection* conn, DBusMessage* msg)
 
 	int pid;
 	int uid;
-	bool silence_supported = false;
-	bool profanity_supported = false;
-	bool punctuation_supported = false;
+	sttd_capability_s capability;
+	bool loading = false;
+	int engine_loading = 0;
+
+	memset(&capability, 0, sizeof(sttd_capability_s));
 
 	int ret = STTD_ERROR_OPERATION_FAILED;
 
@@ -73,9 +132,14 @@ int sttd_dbus_server_initialize(DBusConnection* conn, DBusMessage* msg)
 		ret = STTD_ERROR_OPERATION_FAILED;
 	} else {
 		SLOG(LOG_DEBUG, TAG_STTD, "[IN] stt initialize : pid(%d), uid(%d)", pid , uid); 
-		ret =  sttd_server_initialize(pid, uid, &silence_supported, &profanity_supported, &punctuation_supported);
+		ret =  sttd_server_initialize(pid, uid, &capability, &loading);
+		engine_loading = (int)loading;
 	}
 
+	int silence_supported = (int)capability.silence;
+	int profanity_supported = (int)capability.profanity;
+	int punctuation_supported = (int)capability.punctuation;
+
 	DBusMessage* reply;
 	reply = dbus_message_new_method_return(msg);
 
@@ -85,11 +149,17 @@ int sttd_dbus_server_initialize(DBusConnection* conn, DBusMessage* msg)
 			DBUS_TYPE_INT32, &silence_supported,
 			DBUS_TYPE_INT32, &profanity_supported,
 			DBUS_TYPE_INT32, &punctuation_supported,
+			DBUS_TYPE_INT32, &engine_loading,
 			DBUS_TYPE_INVALID);
 
+		/* capability follows engine ready, if engine is loading */
+		if (0 == ret && 0 == engine_loading && true == capability.valid) 
+			sttd_dbus_append_capability(reply, &capability);
+
 		if (0 == ret) {
-			SLOG(LOG_DEBUG, TAG_STTD, "[OUT SUCCESS] Result(%d), silence(%d), profanity(%d), punctuation(%d)", 
-				ret, silence_supported, profanity_supported, punctuation_supported); 
+			SLOG(LOG_DEBUG, TAG_STTD, "[OUT SUCCESS] Result(%d), silence(%d), profanity(%d), punctuation(%d), loading(%d), languages(%d)", 
+				ret, silence_supported, profanity_supported, punctuation_supported, engine_loading, 
+				g_list_length(capability.lang_list)); 
 		} else {
 			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Result(%d)", ret); 
 		}
@@ -98,12 +168,13 @@ int sttd_dbus_server_initialize(DBusConnection* conn, DBusMessage* msg)
 			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Out Of Memory!");
 		}
 
-		dbus_connection_flush(conn);
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
 	}
 
+	sttd_server_release_capability(&capability);
+
 	SLOG(LOG_DEBUG, TAG_STTD, "<<<<<");
 	SLOG(LOG_DEBUG, TAG_STTD, "  ");
 
@@ -147,7 +218,6 @@ int sttd_dbus_server_finalize(DBusConnection* conn, DBusMessage* msg)
 			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Out Of Memory!");
 		}
 
-		dbus_connection_flush(conn);
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
@@ -226,7 +296,6 @@ int sttd_dbus_server_get_support_lang(DBusConnection* conn, DBusMessage* msg)
 			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Out Of Memory!");
 		}
 
-		dbus_connection_flush(conn);
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
@@ -286,7 +355,6 @@ int sttd_dbus_server_get_default_lang(DBusConnection* conn, DBusMessage* msg)
 			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Out Of Memory!");
 		}
 
-		dbus_connection_flush(conn);
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
@@ -340,7 +408,6 @@ int sttd_dbus_server_is_partial_result_supported(DBusConnection* conn, DBusMessa
 			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Out Of Memory!");
 		}
 
-		dbus_connection_flush(conn);
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
@@ -395,7 +462,6 @@ int sttd_dbus_server_get_audio_volume(DBusConnection* conn, DBusMessage* msg)
 			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Out Of Memory!");
 		}
 
-		dbus_connection_flush(conn);
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
@@ -407,6 +473,27 @@ int sttd_dbus_server_get_audio_volume(DBusConnection* conn, DBusMessage* msg)
 	return 0;
 }
 
+/** Read INT32 argument at index which newer client appends */
+int __get_optional_int(DBusMessage* msg, int index, int default_value)
+{
+	DBusMessageIter args;
+	int value = default_value;
+	int i;
+
+	if (!dbus_message_iter_init(msg, &args))
+		return value;
+
+	for (i = 0;i < index;i++) {
+		if (!dbus_message_iter_next(&args))
+			return value;
+	}
+
+	if (DBUS_TYPE_INT32 == dbus_message_iter_get_arg_type(&args))
+		dbus_message_iter_get_basic(&args, &value);
+
+	return value;
+}
+
 int sttd_dbus_server_start(DBusConnection* conn, DBusMessage* msg)
 {
 	DBusError err;
@@ -418,6 +505,7 @@ int sttd_dbus_server_start(DBusConnection* conn, DBusMessage* msg)
 	int profanity;
 	int punctuation;
 	int silence;
+	int queue_position = 0;
 	int ret = STTD_ERROR_OPERATION_FAILED;
 
 	dbus_message_get_args(msg, &err, 
@@ -429,6 +517,11 @@ int sttd_dbus_server_start(DBusConnection* conn, DBusMessage* msg)
 		DBUS_TYPE_INT32, &silence,
 		DBUS_TYPE_INVALID);
 
+	/* old client does not send queue and partial result options */
+	int priority = __get_optional_int(msg, 6, 0);
+	int wait_timeout = __get_optional_int(msg, 7, 0);
+	int partial_interval = __get_optional_int(msg, 8, 0);
+
 	SLOG(LOG_DEBUG, TAG_STTD, ">>>>> STT Start");
 
 	if (dbus_error_is_set(&err)) { 
@@ -436,19 +529,23 @@ int sttd_dbus_server_start(DBusConnection* conn, DBusMessage* msg)
 		dbus_error_free(&err); 
 		ret = STTD_ERROR_OPERATION_FAILED;
 	} else {
-		SLOG(LOG_DEBUG, TAG_STTD, "[IN] stt start : uid(%d), lang(%s), type(%s), profanity(%d), punctuation(%d), silence(%d)"
-					, uid, lang, type, profanity, punctuation, silence); 
-		ret = sttd_server_start(uid, lang, type, profanity, punctuation, silence);
+		SLOG(LOG_DEBUG, TAG_STTD, "[IN] stt start : uid(%d), lang(%s), type(%s), profanity(%d), punctuation(%d), silence(%d), priority(%d), wait(%d), partial interval(%d)"
+					, uid, lang, type, profanity, punctuation, silence, priority, wait_timeout, partial_interval); 
+		ret = sttd_server_start(uid, lang, type, profanity, punctuation, silence, priority, wait_timeout, 
+					partial_interval, &queue_position);
 	}
 
 	DBusMessage* reply;
 	reply = dbus_message_new_method_return(msg);
 
 	if (NULL != reply) {
-		dbus_message_append_args(reply, DBUS_TYPE_INT32, &ret, DBUS_TYPE_INVALID);
+		dbus_message_append_args(reply, 
+			DBUS_TYPE_INT32, &ret, 
+			DBUS_TYPE_INT32, &queue_position, 
+			DBUS_TYPE_INVALID);
 
 		if (0 == ret) {
-			SLOG(LOG_DEBUG, TAG_STTD, "[OUT SUCCESS] Result(%d)", ret); 
+			SLOG(LOG_DEBUG, TAG_STTD, "[OUT SUCCESS] Result(%d), queue position(%d)", ret, queue_position); 
 		} else {
 			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Result(%d)", ret); 
 		}
@@ -457,7 +554,6 @@ int sttd_dbus_server_start(DBusConnection* conn, DBusMessage* msg)
 			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Out Of Memory!");
 		}
 
-		dbus_connection_flush(conn);
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
@@ -505,7 +601,6 @@ int sttd_dbus_server_stop(DBusConnection* conn, DBusMessage* msg)
 			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Out Of Memory!");
 		}
 
-		dbus_connection_flush(conn);
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
@@ -553,7 +648,134 @@ int sttd_dbus_server_cancel(DBusConnection* conn, DBusMessage* msg)
 			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Out Of Memory!");
 		}
 
-		dbus_connection_flush(conn);
+		dbus_message_unref(reply);
+	} else {
+		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
+	}
+
+	SLOG(LOG_DEBUG, TAG_STTD, "<<<<<");
+	SLOG(LOG_DEBUG, TAG_STTD, "  ");
+
+	return 0;
+}
+
+
+int sttd_dbus_server_prewarm(DBusConnection* conn, DBusMessage* msg)
+{
+	DBusError err;
+	dbus_error_init(&err);
+
+	int uid;
+	char* lang;
+	char* type;
+	int profanity;
+	int punctuation;
+	int silence;
+	int hold;
+	int ret = STTD_ERROR_OPERATION_FAILED;
+
+	dbus_message_get_args(msg, &err, 
+		DBUS_TYPE_INT32, &uid, 
+		DBUS_TYPE_STRING, &lang,   
+		DBUS_TYPE_STRING, &type,
+		DBUS_TYPE_INT32, &profanity,
+		DBUS_TYPE_INT32, &punctuation,
+		DBUS_TYPE_INT32, &silence,
+		DBUS_TYPE_INT32, &hold,
+		DBUS_TYPE_INVALID);
+
+	SLOG(LOG_DEBUG, TAG_STTD, ">>>>> STT Prewarm");
+
+	if (dbus_error_is_set(&err)) { 
+		SLOG(LOG_ERROR, TAG_STTD, "[IN ERROR] stt prewarm : get arguments error (%s)", err.message);
+		dbus_error_free(&err); 
+		ret = STTD_ERROR_OPERATION_FAILED;
+	} else {
+		SLOG(LOG_DEBUG, TAG_STTD, "[IN] stt prewarm : uid(%d), lang(%s), type(%s), profanity(%d), punctuation(%d), silence(%d), hold(%d)"
+					, uid, lang, type, profanity, punctuation, silence, hold); 
+		ret = sttd_server_prewarm(uid, lang, type, profanity, punctuation, silence, hold);
+	}
+
+	/* client does not wait for prewarm */
+	if (0 == ret) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[OUT SUCCESS] Result(%d)", ret); 
+	} else {
+		SLOG(LOG_WARN, TAG_STTD, "[OUT WARNING] Result(%d)", ret); 
+	}
+
+	SLOG(LOG_DEBUG, TAG_STTD, "<<<<<");
+	SLOG(LOG_DEBUG, TAG_STTD, "  ");
+
+	return 0;
+}
+
+
+int sttd_dbus_server_recognize_once(DBusConnection* conn, DBusMessage* msg)
+{
+	DBusError err;
+	dbus_error_init(&err);
+
+	int pid;
+	int uid;
+	char* lang;
+	char* type;
+	int profanity;
+	int punctuation;
+	int silence;
+	int ret = STTD_ERROR_OPERATION_FAILED;
+
+	dbus_message_get_args(msg, &err, 
+		DBUS_TYPE_INT32, &pid, 
+		DBUS_TYPE_INT32, &uid, 
+		DBUS_TYPE_STRING, &lang,   
+		DBUS_TYPE_STRING, &type,
+		DBUS_TYPE_INT32, &profanity,
+		DBUS_TYPE_INT32, &punctuation,
+		DBUS_TYPE_INT32, &silence,
+		DBUS_TYPE_INVALID);
+
+	SLOG(LOG_DEBUG, TAG_STTD, ">>>>> STT Recognize Once");
+
+	if (dbus_error_is_set(&err)) { 
+		SLOG(LOG_ERROR, TAG_STTD, "[IN ERROR] stt recognize once : get arguments error (%s)", err.message);
+		dbus_error_free(&err); 
+		ret = STTD_ERROR_OPERATION_FAILED;
+	} else {
+		SLOG(LOG_DEBUG, TAG_STTD, "[IN] stt recognize once : pid(%d), uid(%d), lang(%s), type(%s), profanity(%d), punctuation(%d), silence(%d)"
+					, pid, uid, lang, type, profanity, punctuation, silence); 
+		bool deferred = false;
+		ret = sttd_server_recognize_once(pid, uid, lang, type, profanity, punctuation, silence, &deferred);
+
+		/* engine is loading. Result is replied when one-shot starts */
+		if (0 == ret && true == deferred) {
+			if (0 == sttd_dbus_hold_reply(uid, conn, msg)) {
+				SLOG(LOG_DEBUG, TAG_STTD, "[OUT] Reply after engine is loaded"); 
+				SLOG(LOG_DEBUG, TAG_STTD, "<<<<<");
+				SLOG(LOG_DEBUG, TAG_STTD, "  ");
+				return 0;
+			}
+
+			sttd_server_finalize(uid);
+			ret = STTD_ERROR_OUT_OF_MEMORY;
+		}
+	}
+
+	DBusMessage* reply;
+	reply = dbus_message_new_method_return(msg);
+
+	if (NULL != reply) {
+		dbus_message_append_args(reply, DBUS_TYPE_INT32, &ret, DBUS_TYPE_INVALID);
+
+		if (0 == ret) {
+			SLOG(LOG_DEBUG, TAG_STTD, "[OUT SUCCESS] Result(%d)", ret); 
+		} else {
+			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Result(%d)", ret); 
+		}
+
+		if (!dbus_connection_send(conn, reply, NULL)) {
+			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Out Of Memory!");
+		}
+
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
@@ -590,7 +812,21 @@ int sttd_dbus_server_setting_initialize(DBusConnection* conn, DBusMessage* msg)
 		ret = STTD_ERROR_OPERATION_FAILED;
 	} else {
 		SLOG(LOG_DEBUG, TAG_STTD, "[IN] setting initializie : uid(%d)", pid); 
-		ret =  sttd_server_setting_initialize(pid);
+		bool deferred = false;
+		ret =  sttd_server_setting_initialize(pid, &deferred);
+
+		/* engine is loading. Result is replied when engine is ready */
+		if (0 == ret && true == deferred) {
+			if (0 == sttd_dbus_hold_setting_reply(pid, conn, msg)) {
+				SLOG(LOG_DEBUG, TAG_STTD, "[OUT] Reply after engine is loaded"); 
+				SLOG(LOG_DEBUG, TAG_STTD, "<<<<<");
+				SLOG(LOG_DEBUG, TAG_STTD, "  ");
+				return 0;
+			}
+
+			sttd_server_setting_finalize(pid);
+			ret = STTD_ERROR_OUT_OF_MEMORY;
+		}
 	}
 
 	DBusMessage* reply;
@@ -608,7 +844,6 @@ int sttd_dbus_server_setting_initialize(DBusConnection* conn, DBusMessage* msg)
 		if (!dbus_connection_send(conn, reply, NULL)) {
 			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Out Of Memory!");
 		}
-		dbus_connection_flush(conn);
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
@@ -659,7 +894,6 @@ int sttd_dbus_server_setting_finalize(DBusConnection* conn, DBusMessage* msg)
 			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Out Of Memory!");
 		}
 
-		dbus_connection_flush(conn);
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
@@ -749,7 +983,6 @@ int sttd_dbus_server_setting_get_engine_list(DBusConnection* conn, DBusMessage*
 			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Out Of Memory!");
 		}
 
-		dbus_connection_flush(conn);
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
@@ -803,7 +1036,6 @@ int sttd_dbus_server_setting_get_engine(DBusConnection* conn, DBusMessage* msg)
 			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Out Of Memory!");
 		}
 
-		dbus_connection_flush(conn);
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
@@ -856,7 +1088,6 @@ int sttd_dbus_server_setting_set_engine(DBusConnection* conn, DBusMessage* msg)
 			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Out Of Memory!");
 		}
 
-		dbus_connection_flush(conn);
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
@@ -941,7 +1172,6 @@ int sttd_dbus_server_setting_get_language_list(DBusConnection* conn, DBusMessage
 			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Out Of Memory!");
 		}
 
-		dbus_connection_flush(conn);
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
@@ -994,7 +1224,6 @@ int sttd_dbus_server_setting_get_default_language(DBusConnection* conn, DBusMess
 			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Out Of Memory!");
 		}
 
-		dbus_connection_flush(conn);
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
@@ -1047,7 +1276,6 @@ int sttd_dbus_server_setting_set_default_language(DBusConnection* conn, DBusMess
 			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Out Of Memory!");
 		}
 
-		dbus_connection_flush(conn);
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
@@ -1099,7 +1327,6 @@ int sttd_dbus_server_setting_get_profanity_filter(DBusConnection* conn, DBusMess
 			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Out Of Memory!");
 		}
 
-		dbus_connection_flush(conn);
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
@@ -1152,7 +1379,6 @@ int sttd_dbus_server_setting_set_profanity_filter(DBusConnection* conn, DBusMess
 			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Out Of Memory!");
 		}
 
-		dbus_connection_flush(conn);
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
@@ -1205,7 +1431,6 @@ int sttd_dbus_server_setting_get_punctuation_override(DBusConnection* conn, DBus
 			return -1;
 		}
 
-		dbus_connection_flush(conn);
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
@@ -1259,7 +1484,6 @@ int sttd_dbus_server_setting_set_punctuation_override(DBusConnection* conn, DBus
 			return -1;
 		}
 
-		dbus_connection_flush(conn);
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
@@ -1312,7 +1536,6 @@ int sttd_dbus_server_setting_get_silence_detection(DBusConnection* conn, DBusMes
 			return -1;
 		}
 
-		dbus_connection_flush(conn);
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
@@ -1364,7 +1587,6 @@ int sttd_dbus_server_setting_set_silence_detection(DBusConnection* conn, DBusMes
 			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Out Of Memory!");
 		}
 
-		dbus_connection_flush(conn);
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
@@ -1458,7 +1680,6 @@ int sttd_dbus_server_setting_get_engine_setting(DBusConnection* conn, DBusMessag
 			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Out Of Memory!");
 		}
 
-		dbus_connection_flush(conn);
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
@@ -1513,7 +1734,6 @@ int sttd_dbus_server_setting_set_engine_setting(DBusConnection* conn, DBusMessag
 			SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Out Of Memory!");
 		}
 
-		dbus_connection_flush(conn);
 		dbus_message_unref(reply);
 	} else {
 		SLOG(LOG_ERROR, TAG_STTD, "[OUT ERROR] Fail to create reply message!!"); 
@@ -1546,7 +1766,7 @@ int sttd_dbus_server_stop_by_daemon(DBusMessage* msg)
 		sttd_server_stop(uid);
 
 		/* check silence detection option from config */
-		int ret = sttdc_send_set_state(uid, (int)APP_STATE_PROCESSING);
+		int ret = sttdc_send_set_state(uid, (int)APP_STATE_PROCESSING, sttd_server_client_reply_callback, NULL);
 		if (0 == ret) {
 			SLOG(LOG_DEBUG, TAG_STTD, "[OUT SUCCESS] Result(%d)", ret); 
 		} else {
@@ -1561,3 +1781,44 @@ int sttd_dbus_server_stop_by_daemon(DBusMessage* msg)
 
 	return 0;
 }
+
+int sttd_dbus_server_name_owner_changed(DBusMessage* msg)
+{
+	DBusError err;
+	dbus_error_init(&err);
+
+	char* name = NULL;
+	char* old_owner = NULL;
+	char* new_owner = NULL;
+
+	dbus_message_get_args(msg, &err,
+		DBUS_TYPE_STRING, &name,
+		DBUS_TYPE_STRING, &old_owner,
+		DBUS_TYPE_STRING, &new_owner,
+		DBUS_TYPE_INVALID);
+
+	if (dbus_error_is_set(&err)) { 
+		SLOG(LOG_ERROR, TAG_STTD, "[IN ERROR] name owner changed : Get arguments error (%s)", err.message);
+		dbus_error_free(&err); 
+		return -1;
+	}
+
+	/* only lost name of client is interesting */
+	int prefix_len = strlen(STT_CLIENT_SERVICE_NAME);
+	if (NULL == name || 0 != strncmp(name, STT_CLIENT_SERVICE_NAME, prefix_len) || NULL == new_owner || '\0' != new_owner[0]) 
+		return 0;
+
+	int pid = atoi(name + prefix_len);
+	if (0 >= pid)
+		return 0;
+
+	SLOG(LOG_DEBUG, TAG_STTD, ">>>>> Client is gone");
+	SLOG(LOG_DEBUG, TAG_STTD, "[IN] client name lost : pid(%d)", pid);
+
+	sttd_server_disconnect_client(pid);
+
+	SLOG(LOG_DEBUG, TAG_STTD, "<<<<<");
+	SLOG(LOG_DEBUG, TAG_STTD, "  ");
+
+	return 0;
+}
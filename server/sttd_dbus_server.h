@@ -26,6 +26,9 @@ extern "C" {
 
 int sttd_dbus_server_hello(DBusConnection* conn, DBusMessage* msg);
 
+/** Client opened private connection to daemon */
+int sttd_dbus_server_peer_hello(DBusConnection* conn, DBusMessage* msg);
+
 /*
 * Dbus Server functions for APIs
 */ 
@@ -48,6 +51,11 @@ int sttd_dbus_server_stop(DBusConnection* conn, DBusMessage* msg);
 
 int sttd_dbus_server_cancel(DBusConnection* conn, DBusMessage* msg);
 
+/** Prewarm is sent without reply */
+int sttd_dbus_server_prewarm(DBusConnection* conn, DBusMessage* msg);
+
+int sttd_dbus_server_recognize_once(DBusConnection* conn, DBusMessage* msg);
+
 
 /*
 * Dbus Server functions for Setting
@@ -91,6 +99,8 @@ int sttd_dbus_server_setting_set_engine_setting(DBusConnection* conn, DBusMessag
 
 int sttd_dbus_server_stop_by_daemon(DBusMessage* msg);
 
+int sttd_dbus_server_name_owner_changed(DBusMessage* msg);
+
 
 #ifdef __cplusplus
 }
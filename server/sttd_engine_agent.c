@@ -14,17 +14,27 @@
 
 #include <dlfcn.h>
 #include <dirent.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <time.h>
 
 #include "sttd_main.h"
 #include "sttd_client_data.h"
 #include "sttd_config.h"
 #include "sttd_engine_agent.h"
+#include "sttd_engine_monitor.h"
 
 
 /*
 * Internal data structure
 */
 
+/** size of engine functions without optional functions */
+#define STTPE_FUNCS_BASE_SIZE	offsetof(sttpe_funcs_s, shrink_memory)
+
+/** size of engine functions which includes the member */
+#define STTPE_FUNCS_END_OF(member)	(offsetof(sttpe_funcs_s, member) + sizeof(((sttpe_funcs_s*)0)->member))
+
 typedef struct {
 	/* engine info */
 	char*	engine_uuid;
@@ -40,12 +50,21 @@ typedef struct {
 	bool	support_punctuation_override;
 	void	*handle;
 
-	/* engine base setting */
+	/* engine base setting : option values applied to engine */
 	char*	default_lang;
 	bool	profanity_filter;
 	bool	punctuation_override;
 	bool	silence_detection;
 
+	/* concurrent recognition sessions, 1 for single session engine */
+	int	max_sessions;
+
+	/* option statistics */
+	int	option_request_count;
+	int	profanity_change_count;
+	int	punctuation_change_count;
+	int	silence_change_count;
+
 	sttpe_funcs_s*	pefuncs;
 	sttpd_funcs_s*	pdfuncs;
 
@@ -53,6 +72,15 @@ typedef struct {
 	int (*sttp_unload_engine)();
 } sttengine_s;
 
+typedef struct {
+	int	uid;
+	void*	user_data;	/* passed to engine and given back by result callback */
+	void*	handle;		/* engine session */
+
+	int	ref;		/* users out of lock. Session is freed by the last one */
+	bool	removed;	/* not in session list anymore */
+} sttengine_session_s;
+
 typedef struct _sttengine_info {
 	char*	engine_uuid;
 	char*	engine_path;
@@ -76,6 +104,21 @@ static GList *g_engine_list;
 /** current engine infomation */
 static sttengine_s g_cur_engine;
 
+/** sessions of multi session engine */
+static GList *g_session_list;
+static sttengine_session_s* g_recording_session;
+
+/* uid of recording in single session engine */
+static int g_recording_uid = -1;
+
+/* sessions are removed by result of engine thread while recorder thread feeds audio */
+static pthread_mutex_t g_session_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** engine load statistics */
+static int g_load_count;
+static double g_last_load_time;
+static double g_total_load_time;
+
 /** default option value */
 static bool g_default_profanity_filter;
 static bool g_default_punctuation_override;
@@ -124,6 +167,28 @@ int __internal_get_engine_info(const char* filepath, sttengine_info_s** info);
 
 int __log_enginelist();
 
+/** load current engine without statistics */
+int __internal_load_current_engine();
+
+/** sessions of multi session engine */
+bool __is_multi_session();
+
+/** Find session and take reference. It should be released by __release_session() */
+sttengine_session_s* __get_session(int uid);
+
+sttengine_session_s* __get_recording_session();
+
+void __release_session(sttengine_session_s* session);
+
+bool __unlink_session(sttengine_session_s* session);
+
+/** Remove session from list. It is freed when its last reference is released */
+void __remove_session(sttengine_session_s* session);
+
+void __clear_session();
+
+void __detach_recording(int uid);
+
 /*
 * STT Engine Agent Interfaces
 */
@@ -588,6 +653,11 @@ int __internal_set_current_engine(const char* engine_uuid)
 		}
 	}
 
+	/* latency histograms are per engine */
+	if (NULL != g_cur_engine.engine_uuid)
+		sttd_engine_monitor_dump(g_cur_engine.engine_uuid);
+	sttd_engine_monitor_reset();
+
 	/* set data from g_engine_list */
 	if (g_cur_engine.engine_uuid != NULL)	free(g_cur_engine.engine_uuid);
 	if (g_cur_engine.engine_name != NULL)	free(g_cur_engine.engine_name);
@@ -606,6 +676,11 @@ int __internal_set_current_engine(const char* engine_uuid)
 	g_cur_engine.punctuation_override = g_default_punctuation_override;
 	g_cur_engine.silence_detection = g_default_silence_detected;
 
+	g_cur_engine.option_request_count = 0;
+	g_cur_engine.profanity_change_count = 0;
+	g_cur_engine.punctuation_change_count = 0;
+	g_cur_engine.silence_change_count = 0;
+
 	SLOG(LOG_DEBUG, TAG_STTD, "-----");
 	SLOG(LOG_DEBUG, TAG_STTD, " Current engine uuid : %s", g_cur_engine.engine_uuid);
 	SLOG(LOG_DEBUG, TAG_STTD, " Current engine name : %s", g_cur_engine.engine_name);
@@ -615,7 +690,57 @@ int __internal_set_current_engine(const char* engine_uuid)
 	return 0;
 }
 
+double __get_time_ms()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1000000.0;
+}
+
 int sttd_engine_agent_load_current_engine()
+{
+	if (true == g_cur_engine.is_loaded) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Engine Agent] sttd_engine_agent_load_current_engine : Engine has already been loaded ");
+		return 0;
+	}
+
+	double start = __get_time_ms();
+
+	int ret = __internal_load_current_engine();
+	if (0 != ret)
+		return ret;
+
+	g_last_load_time = __get_time_ms() - start;
+	g_total_load_time += g_last_load_time;
+	g_load_count++;
+
+	SLOG(LOG_DEBUG, TAG_STTD, "[Engine Agent] load count(%d), load time(%.1f ms), average(%.1f ms)", 
+		g_load_count, g_last_load_time, g_total_load_time / g_load_count);
+
+	return 0;
+}
+
+bool sttd_engine_agent_is_loaded()
+{
+	return g_cur_engine.is_loaded;
+}
+
+int sttd_engine_agent_get_load_info(int* load_count, double* last_load_time, double* total_load_time)
+{
+	if (NULL == load_count || NULL == last_load_time || NULL == total_load_time) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Invalid Parameter"); 
+		return STTD_ERROR_INVALID_PARAMETER;
+	}
+
+	*load_count = g_load_count;
+	*last_load_time = g_last_load_time;
+	*total_load_time = g_total_load_time;
+
+	return 0;
+}
+
+int __internal_load_current_engine()
 {
 	if (false == g_agent_init) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Not Initialized"); 
@@ -657,6 +782,8 @@ int sttd_engine_agent_load_current_engine()
 	}
 
 	/* load engine */
+	memset(g_cur_engine.pefuncs, 0, sizeof(sttpe_funcs_s));
+
 	g_cur_engine.pdfuncs->version = 1;
 	g_cur_engine.pdfuncs->size = sizeof(sttpd_funcs_s);
 
@@ -667,28 +794,67 @@ int sttd_engine_agent_load_current_engine()
 
 	SLOG(LOG_DEBUG, TAG_STTD, "[Engine Agent] engine info : version(%d), size(%d)",g_cur_engine.pefuncs->version, g_cur_engine.pefuncs->size); 
 
-	/* engine error check */
-	if (g_cur_engine.pefuncs->size != sizeof(sttpe_funcs_s)) {
+	/* engine error check : old engines do not have optional functions */
+	if (g_cur_engine.pefuncs->size < (int)STTPE_FUNCS_BASE_SIZE || g_cur_engine.pefuncs->size > (int)sizeof(sttpe_funcs_s)) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] sttd_engine_agent_load_current_engine : engine is not valid"); 
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 
+	if (g_cur_engine.pefuncs->size < (int)STTPE_FUNCS_END_OF(shrink_memory)) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Engine Agent] Engine does not have shrink memory"); 
+		g_cur_engine.pefuncs->shrink_memory = NULL;
+	}
+
+	if (g_cur_engine.pefuncs->size < (int)STTPE_FUNCS_END_OF(session_cancel)) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Engine Agent] Engine does not have session functions"); 
+		g_cur_engine.pefuncs->get_max_sessions = NULL;
+		g_cur_engine.pefuncs->session_start = NULL;
+		g_cur_engine.pefuncs->session_set_recording = NULL;
+		g_cur_engine.pefuncs->session_stop = NULL;
+		g_cur_engine.pefuncs->session_cancel = NULL;
+	}
+
 	/* initalize engine */
-	if (0 != g_cur_engine.pefuncs->initialize(__result_cb, __partial_result_cb, __detect_silence_cb)) {
+	int ret = 0;
+
+	sttd_engine_monitor_begin(STTD_ENGINE_CALL_INITIALIZE);
+	ret = g_cur_engine.pefuncs->initialize(__result_cb, __partial_result_cb, __detect_silence_cb);
+	sttd_engine_monitor_end(STTD_ENGINE_CALL_INITIALIZE);
+
+	if (0 != ret) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Fail to initialize stt-engine"); 
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 
-	/* set default setting */
-	int ret = 0;
+	/* check concurrent sessions */
+	g_cur_engine.max_sessions = 1;
+
+	if (NULL != g_cur_engine.pefuncs->get_max_sessions && NULL != g_cur_engine.pefuncs->session_start && 
+		NULL != g_cur_engine.pefuncs->session_set_recording && NULL != g_cur_engine.pefuncs->session_stop && 
+		NULL != g_cur_engine.pefuncs->session_cancel) {
+		int count = 1;
+
+		sttd_engine_monitor_begin(STTD_ENGINE_CALL_QUERY);
+		ret = g_cur_engine.pefuncs->get_max_sessions(&count);
+		sttd_engine_monitor_end(STTD_ENGINE_CALL_QUERY);
 
+		if (0 == ret && 1 < count) {
+			g_cur_engine.max_sessions = count;
+		}
+	}
+
+	SLOG(LOG_DEBUG, TAG_STTD, "[Engine Agent] Max sessions : %d", g_cur_engine.max_sessions);
+
+	/* set default setting */
 	if (NULL == g_cur_engine.pefuncs->set_profanity_filter) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] set_profanity_filter of engine is NULL!!");
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 	
 	/* check and set profanity filter */
+	sttd_engine_monitor_begin(STTD_ENGINE_CALL_SET_OPTION);
 	ret = g_cur_engine.pefuncs->set_profanity_filter(g_cur_engine.profanity_filter);
+	sttd_engine_monitor_end(STTD_ENGINE_CALL_SET_OPTION);
 	if (0 != ret) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent] Not support profanity filter");
 		g_cur_engine.support_profanity_filter = false;
@@ -702,7 +868,9 @@ int sttd_engine_agent_load_current_engine()
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 
+	sttd_engine_monitor_begin(STTD_ENGINE_CALL_SET_OPTION);
 	ret = g_cur_engine.pefuncs->set_punctuation(g_cur_engine.punctuation_override);
+	sttd_engine_monitor_end(STTD_ENGINE_CALL_SET_OPTION);
 	if (0 != ret) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Engine ERROR] Not support punctuation override");
 		g_cur_engine.support_punctuation_override = false;
@@ -716,7 +884,9 @@ int sttd_engine_agent_load_current_engine()
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 
+	sttd_engine_monitor_begin(STTD_ENGINE_CALL_SET_OPTION);
 	ret = g_cur_engine.pefuncs->set_silence_detection(g_cur_engine.silence_detection);
+	sttd_engine_monitor_end(STTD_ENGINE_CALL_SET_OPTION);
 	if (0 != ret) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Engine ERROR] Not support silence detection");
 		g_cur_engine.support_silence_detection = false;
@@ -732,7 +902,11 @@ int sttd_engine_agent_load_current_engine()
 			return STTD_ERROR_OPERATION_FAILED;
 		}
 
-		if (true == g_cur_engine.pefuncs->is_valid_lang(g_cur_engine.default_lang)) {
+		sttd_engine_monitor_begin(STTD_ENGINE_CALL_QUERY);
+		bool is_valid = g_cur_engine.pefuncs->is_valid_lang(g_cur_engine.default_lang);
+		sttd_engine_monitor_end(STTD_ENGINE_CALL_QUERY);
+
+		if (true == is_valid) {
 			set_voice = true;
 			SLOG(LOG_DEBUG, TAG_STTD, "[Engine Agent SUCCESS] Set origin default voice to current engine : lang(%s)", g_cur_engine.default_lang);
 		} else {
@@ -747,10 +921,11 @@ int sttd_engine_agent_load_current_engine()
 		}
 
 		/* get language list */
-		int ret;
 		GList* lang_list = NULL;
 
+		sttd_engine_monitor_begin(STTD_ENGINE_CALL_QUERY);
 		ret = g_cur_engine.pefuncs->foreach_langs(__supported_language_cb, &lang_list);
+		sttd_engine_monitor_end(STTD_ENGINE_CALL_QUERY);
 
 		if (0 == ret && 0 < g_list_length(lang_list)) {
 			GList *iter = NULL;
@@ -759,7 +934,11 @@ int sttd_engine_agent_load_current_engine()
 			if (NULL != iter) {
 				char* temp_lang = iter->data;
 
-				if (true != g_cur_engine.pefuncs->is_valid_lang(temp_lang)) {
+				sttd_engine_monitor_begin(STTD_ENGINE_CALL_QUERY);
+				bool is_valid = g_cur_engine.pefuncs->is_valid_lang(temp_lang);
+				sttd_engine_monitor_end(STTD_ENGINE_CALL_QUERY);
+
+				if (true != is_valid) {
 					SLOG(LOG_ERROR, TAG_STTD, "[Engine ERROR] Fail voice is NOT valid");
 					return STTD_ERROR_OPERATION_FAILED;
 				}
@@ -796,6 +975,11 @@ int sttd_engine_agent_unload_current_engine()
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 
+	if (true == sttd_engine_monitor_is_hung()) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Engine is not responding"); 
+		return STTD_ERROR_OPERATION_FAILED;
+	}
+
 	if (false == g_cur_engine.is_set) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] sttd_engine_agent_unload_current_engine : No Current Engine "); 
 		return -1;
@@ -810,7 +994,9 @@ int sttd_engine_agent_unload_current_engine()
 	if (NULL == g_cur_engine.pefuncs->deinitialize) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] shutdown of engine is NULL!!");
 	} else {
+		sttd_engine_monitor_begin(STTD_ENGINE_CALL_DEINITIALIZE);
 		g_cur_engine.pefuncs->deinitialize();
+		sttd_engine_monitor_end(STTD_ENGINE_CALL_DEINITIALIZE);
 	}
 
 	/* unload engine */
@@ -824,6 +1010,42 @@ int sttd_engine_agent_unload_current_engine()
 	g_cur_engine.handle = NULL;
 	g_cur_engine.is_loaded = false;
 
+	__clear_session();
+	g_cur_engine.max_sessions = 1;
+
+	return 0;
+}
+
+int sttd_engine_agent_shrink_memory()
+{
+	if (false == g_agent_init) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Not Initialized" );
+		return STTD_ERROR_OPERATION_FAILED;
+	}
+
+	if (false == g_cur_engine.is_loaded) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Engine Agent] Engine is not loaded");
+		return 0;
+	}
+
+	if (true == sttd_engine_monitor_is_hung()) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Engine is not responding"); 
+		return STTD_ERROR_OPERATION_FAILED;
+	}
+
+	if (NULL == g_cur_engine.pefuncs->shrink_memory) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Engine Agent] Engine does not support to shrink memory");
+		return STTD_ERROR_NOT_SUPPORTED_FEATURE;
+	}
+
+	sttd_engine_monitor_begin(STTD_ENGINE_CALL_SHRINK_MEMORY);
+	int ret = g_cur_engine.pefuncs->shrink_memory();
+	sttd_engine_monitor_end(STTD_ENGINE_CALL_SHRINK_MEMORY);
+	if (0 != ret) {
+		SLOG(LOG_WARN, TAG_STTD, "[Engine Agent WARNING] Fail to shrink memory of engine : result(%d)", ret);
+		return STTD_ERROR_OPERATION_FAILED;
+	}
+
 	return 0;
 }
 
@@ -870,111 +1092,223 @@ int sttd_engine_get_option_supported(bool* silence, bool* profanity, bool* punct
 * STT Engine Interfaces for client
 */
 
-int __set_option(int profanity, int punctuation, int silence)
+int __apply_option(const char* name, int (*setter)(bool), bool support, bool value, bool* applied, int* change_count)
 {
-	if (2 == profanity) {
-		/* Default selection */
-		if (g_default_profanity_filter != g_cur_engine.profanity_filter) {
-			if (NULL != g_cur_engine.pefuncs->set_profanity_filter) {
-				if (0 != g_cur_engine.pefuncs->set_profanity_filter(g_default_profanity_filter)) {
-					SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Fail to set profanity filter");
-					return STTD_ERROR_OPERATION_FAILED;
-				}
-				g_cur_engine.profanity_filter = g_default_profanity_filter;
-				SLOG(LOG_DEBUG, TAG_STTD, "[Engine Agent] Set profanity filter : %s", g_cur_engine.profanity_filter ? "true" : "false");
-			} else {
-				SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] profanity_filter() of engine is NULL!!");
-				return STTD_ERROR_OPERATION_FAILED;
-			}
-		}
-	} else {
-		/* Client selection */
-		if (g_cur_engine.profanity_filter != profanity) {
-			if (NULL != g_cur_engine.pefuncs->set_profanity_filter) {
-				if (0 != g_cur_engine.pefuncs->set_profanity_filter((bool)profanity)) {
-					SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Fail to set profanity filter");
-					return STTD_ERROR_OPERATION_FAILED;
-				}
+	/* push only real change */
+	if (*applied == value)
+		return 0;
 
-				g_cur_engine.profanity_filter = (bool)profanity;
-				SLOG(LOG_DEBUG, TAG_STTD, "[Engine Agent] Set profanity filter : %s", g_cur_engine.profanity_filter ? "true" : "false");
-			} else {
-				SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] profanity_filter() of engine is NULL!!");
-				return STTD_ERROR_OPERATION_FAILED;
-			}
-		}
+	if (false == support) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Engine Agent] Engine does not support %s. Skip", name);
+		return 0;
 	}
 
-	if (2 == punctuation) {
-		/* Default selection */
-		if (g_default_punctuation_override != g_cur_engine.punctuation_override) {
-			if (NULL != g_cur_engine.pefuncs->set_punctuation) {
-				if (0 != g_cur_engine.pefuncs->set_punctuation(g_default_punctuation_override)) {
-					SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Fail to set punctuation override");
-					return STTD_ERROR_OPERATION_FAILED;
-				}
-				g_cur_engine.punctuation_override = g_default_punctuation_override;
-				SLOG(LOG_DEBUG, TAG_STTD, "[Engine Agent] Set punctuation override : %s", g_cur_engine.punctuation_override ? "true" : "false");
-			} else {
-				SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] set_punctuation() of engine is NULL!!");
-				return STTD_ERROR_OPERATION_FAILED;
-			}
-		}
-	} else {
-		/* Client selection */
-		if (g_cur_engine.punctuation_override != punctuation) {
-			if (NULL != g_cur_engine.pefuncs->set_punctuation) {
-				if (0 != g_cur_engine.pefuncs->set_punctuation((bool)punctuation)) {
-					SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Fail to set punctuation override");
-					return STTD_ERROR_OPERATION_FAILED;
-				}
+	if (NULL == setter) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Setter of %s is NULL!!", name);
+		return STTD_ERROR_OPERATION_FAILED;
+	}
 
-				g_cur_engine.punctuation_override = (bool)punctuation;
-				SLOG(LOG_DEBUG, TAG_STTD, "[Engine Agent] Set punctuation override : %s", g_cur_engine.punctuation_override ? "true" : "false");
-			} else {
-				SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] set_punctuation() of engine is NULL!!");
-				return STTD_ERROR_OPERATION_FAILED;
-			}
-		}
+	sttd_engine_monitor_begin(STTD_ENGINE_CALL_SET_OPTION);
+	int ret = setter(value);
+	sttd_engine_monitor_end(STTD_ENGINE_CALL_SET_OPTION);
+
+	if (0 != ret) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Fail to set %s", name);
+		return STTD_ERROR_OPERATION_FAILED;
 	}
 
-	if (2 == silence) {
-		/* Default selection */
-		if (g_default_silence_detected != g_cur_engine.silence_detection) {
-			if (NULL != g_cur_engine.pefuncs->set_silence_detection) {
-				if (0 != g_cur_engine.pefuncs->set_silence_detection(g_default_silence_detected)) {
-					SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Fail to set silence detection");
-					return STTD_ERROR_OPERATION_FAILED;
-				}
-				g_cur_engine.silence_detection = g_default_silence_detected;
-				SLOG(LOG_DEBUG, TAG_STTD, "[Engine Agent] Set silence detection : %s", g_cur_engine.silence_detection ? "true" : "false");
-			} else {
-				SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] set_silence() of engine is NULL!!");
-				return STTD_ERROR_OPERATION_FAILED;
-			}
-		}
-	} else {
-		/* Client selection */
-		if (g_cur_engine.silence_detection != silence) {
-			if (NULL != g_cur_engine.pefuncs->set_silence_detection) {
-				if (0 != g_cur_engine.pefuncs->set_silence_detection((bool)silence)) {
-					SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Fail to set silence detection");
-					return STTD_ERROR_OPERATION_FAILED;
-				}
+	*applied = value;
+	(*change_count)++;
 
-				g_cur_engine.silence_detection = (bool)silence;
-				SLOG(LOG_DEBUG, TAG_STTD, "[Engine Agent] Set silence detection : %s", g_cur_engine.silence_detection ? "true" : "false");
-			} else {
-				SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] set_silence() of engine is NULL!!");
-				return STTD_ERROR_OPERATION_FAILED;
-			}
-		}
+	SLOG(LOG_DEBUG, TAG_STTD, "[Engine Agent] Set %s : %s", name, value ? "true" : "false");
+
+	return 0;
+}
+
+int __set_option(int profanity, int punctuation, int silence)
+{
+	bool value;
+
+	g_cur_engine.option_request_count++;
+
+	/* 2 means default selection */
+	value = (2 == profanity) ? g_default_profanity_filter : (bool)profanity;
+	if (0 != __apply_option("profanity filter", g_cur_engine.pefuncs->set_profanity_filter, 
+		g_cur_engine.support_profanity_filter, value, &g_cur_engine.profanity_filter, &g_cur_engine.profanity_change_count)) {
+		return STTD_ERROR_OPERATION_FAILED;
+	}
+
+	value = (2 == punctuation) ? g_default_punctuation_override : (bool)punctuation;
+	if (0 != __apply_option("punctuation override", g_cur_engine.pefuncs->set_punctuation, 
+		g_cur_engine.support_punctuation_override, value, &g_cur_engine.punctuation_override, &g_cur_engine.punctuation_change_count)) {
+		return STTD_ERROR_OPERATION_FAILED;
+	}
+
+	value = (2 == silence) ? g_default_silence_detected : (bool)silence;
+	if (0 != __apply_option("silence detection", g_cur_engine.pefuncs->set_silence_detection, 
+		g_cur_engine.support_silence_detection, value, &g_cur_engine.silence_detection, &g_cur_engine.silence_change_count)) {
+		return STTD_ERROR_OPERATION_FAILED;
 	}
+
+	SLOG(LOG_DEBUG, TAG_STTD, "[Engine Agent] Option change count : request(%d), profanity(%d), punctuation(%d), silence(%d)", 
+		g_cur_engine.option_request_count, g_cur_engine.profanity_change_count, 
+		g_cur_engine.punctuation_change_count, g_cur_engine.silence_change_count);
 	
 	return 0;
 }
 
-int sttd_engine_recognize_start(const char* lang, const char* recognition_type, 
+int sttd_engine_agent_dump_latency()
+{
+	return sttd_engine_monitor_dump(g_cur_engine.engine_uuid);
+}
+
+int sttd_engine_agent_get_option_stats(int* request_count, int* profanity_count, int* punctuation_count, int* silence_count)
+{
+	if (NULL == request_count || NULL == profanity_count || NULL == punctuation_count || NULL == silence_count) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Invalid Parameter"); 
+		return STTD_ERROR_INVALID_PARAMETER;
+	}
+
+	*request_count = g_cur_engine.option_request_count;
+	*profanity_count = g_cur_engine.profanity_change_count;
+	*punctuation_count = g_cur_engine.punctuation_change_count;
+	*silence_count = g_cur_engine.silence_change_count;
+
+	return 0;
+}
+
+bool __is_multi_session()
+{
+	return (1 < g_cur_engine.max_sessions);
+}
+
+sttengine_session_s* __get_session(int uid)
+{
+	GList *iter = NULL;
+	sttengine_session_s* session = NULL;
+
+	pthread_mutex_lock(&g_session_mutex);
+
+	iter = g_list_first(g_session_list);
+	while (NULL != iter) {
+		session = iter->data;
+		if (NULL != session && uid == session->uid) {
+			session->ref++;
+			pthread_mutex_unlock(&g_session_mutex);
+			return session;
+		}
+
+		iter = g_list_next(iter);
+	}
+
+	pthread_mutex_unlock(&g_session_mutex);
+
+	return NULL;
+}
+
+/** Take reference of recording session */
+sttengine_session_s* __get_recording_session()
+{
+	pthread_mutex_lock(&g_session_mutex);
+
+	sttengine_session_s* session = g_recording_session;
+	if (NULL != session)
+		session->ref++;
+
+	pthread_mutex_unlock(&g_session_mutex);
+
+	return session;
+}
+
+void __release_session(sttengine_session_s* session)
+{
+	if (NULL == session)
+		return;
+
+	pthread_mutex_lock(&g_session_mutex);
+
+	session->ref--;
+	bool last = (0 >= session->ref && true == session->removed);
+
+	pthread_mutex_unlock(&g_session_mutex);
+
+	if (true == last)
+		free(session);
+}
+
+/** It should be called with lock. Return true if session can be freed */
+bool __unlink_session(sttengine_session_s* session)
+{
+	if (session == g_recording_session)
+		g_recording_session = NULL;
+
+	if (false == session->removed) {
+		g_session_list = g_list_remove(g_session_list, session);
+		session->removed = true;
+	}
+
+	return (0 >= session->ref);
+}
+
+void __remove_session(sttengine_session_s* session)
+{
+	if (NULL == session)
+		return;
+
+	pthread_mutex_lock(&g_session_mutex);
+	bool last = __unlink_session(session);
+	pthread_mutex_unlock(&g_session_mutex);
+
+	if (true == last)
+		free(session);
+}
+
+void __clear_session()
+{
+	GList *iter = NULL;
+
+	pthread_mutex_lock(&g_session_mutex);
+
+	iter = g_list_first(g_session_list);
+	while (NULL != iter) {
+		sttengine_session_s* session = iter->data;
+		iter = g_list_next(iter);
+
+		if (NULL != session && true == __unlink_session(session))
+			free(session);
+	}
+
+	g_list_free(g_session_list);
+	g_session_list = NULL;
+	g_recording_session = NULL;
+	g_recording_uid = -1;
+
+	pthread_mutex_unlock(&g_session_mutex);
+}
+
+/** Stop feeding audio of recorder to the session of uid */
+void __detach_recording(int uid)
+{
+	pthread_mutex_lock(&g_session_mutex);
+
+	if (uid == g_recording_uid)
+		g_recording_uid = -1;
+
+	if (NULL != g_recording_session && uid == g_recording_session->uid)
+		g_recording_session = NULL;
+
+	pthread_mutex_unlock(&g_session_mutex);
+}
+
+int sttd_engine_agent_get_max_sessions()
+{
+	if (false == g_agent_init || false == g_cur_engine.is_loaded)
+		return 1;
+
+	return g_cur_engine.max_sessions;
+}
+
+int sttd_engine_recognize_start(int uid, const char* lang, const char* recognition_type, 
 				int profanity, int punctuation, int silence, void* user_param)
 {
 	if (false == g_agent_init) {
@@ -987,6 +1321,11 @@ int sttd_engine_recognize_start(const char* lang, const char* recognition_type,
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 
+	if (true == sttd_engine_monitor_is_hung()) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Engine is not responding"); 
+		return STTD_ERROR_OPERATION_FAILED;
+	}
+
 	if (NULL == lang || NULL == recognition_type) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Invalid Parameter"); 
 		return STTD_ERROR_INVALID_PARAMETER;
@@ -1002,6 +1341,17 @@ int sttd_engine_recognize_start(const char* lang, const char* recognition_type,
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 
+	if (true == __is_multi_session()) {
+		pthread_mutex_lock(&g_session_mutex);
+		int count = (int)g_list_length(g_session_list);
+		pthread_mutex_unlock(&g_session_mutex);
+
+		if (g_cur_engine.max_sessions <= count) {
+			SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] No more session : max(%d)", g_cur_engine.max_sessions);
+			return STTD_ERROR_RECORDER_BUSY;
+		}
+	}
+
 	char* temp;
 	if (0 == strncmp(lang, "default", strlen("default"))) {
 		temp = strdup(g_cur_engine.default_lang);
@@ -1009,7 +1359,16 @@ int sttd_engine_recognize_start(const char* lang, const char* recognition_type,
 		temp = strdup(lang);
 	}
 
-	int ret = g_cur_engine.pefuncs->start(temp, recognition_type, user_param);
+	int ret;
+	void* handle = NULL;
+
+	sttd_engine_monitor_begin_session(STTD_ENGINE_CALL_START, uid);
+	if (true == __is_multi_session()) {
+		ret = g_cur_engine.pefuncs->session_start(temp, recognition_type, user_param, &handle);
+	} else {
+		ret = g_cur_engine.pefuncs->start(temp, recognition_type, user_param);
+	}
+	sttd_engine_monitor_end(STTD_ENGINE_CALL_START);
 	free(temp);
 
 	if (0 != ret) {
@@ -1017,6 +1376,31 @@ int sttd_engine_recognize_start(const char* lang, const char* recognition_type,
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 
+	if (true == __is_multi_session()) {
+		sttengine_session_s* session = (sttengine_session_s*)calloc(1, sizeof(sttengine_session_s));
+		if (NULL == session) {
+			SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Memory not enough!!");
+			g_cur_engine.pefuncs->session_cancel(handle);
+			return STTD_ERROR_OUT_OF_MEMORY;
+		}
+
+		session->uid = uid;
+		session->user_data = user_param;
+		session->handle = handle;
+
+		pthread_mutex_lock(&g_session_mutex);
+		g_session_list = g_list_append(g_session_list, session);
+		g_recording_session = session;
+		g_recording_uid = uid;
+		pthread_mutex_unlock(&g_session_mutex);
+
+		SLOG(LOG_DEBUG, TAG_STTD, "[Engine Agent] Start session : uid(%d)", uid);
+	} else {
+		pthread_mutex_lock(&g_session_mutex);
+		g_recording_uid = uid;
+		pthread_mutex_unlock(&g_session_mutex);
+	}
+
 	SLOG(LOG_DEBUG, TAG_STTD, "[Engine Agent SUCCESS] sttd_engine_recognize_start");
 
 	return 0;
@@ -1034,6 +1418,11 @@ int sttd_engine_recognize_audio(const void* data, unsigned int length)
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 
+	if (true == sttd_engine_monitor_is_hung()) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Engine is not responding"); 
+		return STTD_ERROR_OPERATION_FAILED;
+	}
+
 	if (NULL == data) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Invalid Parameter"); 
 		return STTD_ERROR_INVALID_PARAMETER;
@@ -1044,7 +1433,30 @@ int sttd_engine_recognize_audio(const void* data, unsigned int length)
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 
-	int ret = g_cur_engine.pefuncs->set_recording(data, length);
+	int ret;
+
+	if (true == __is_multi_session()) {
+		/* audio of recorder belongs to the recording session. It is called in recorder thread,
+		   so hold the session while feeding audio not to be freed by result or stop */
+		sttengine_session_s* session = __get_recording_session();
+		if (NULL != session) {
+			sttd_engine_monitor_begin_session(STTD_ENGINE_CALL_SET_RECORDING, session->uid);
+			ret = g_cur_engine.pefuncs->session_set_recording(session->handle, data, length);
+			sttd_engine_monitor_end(STTD_ENGINE_CALL_SET_RECORDING);
+
+			__release_session(session);
+		} else {
+			ret = STTD_ERROR_INVALID_STATE;
+		}
+	} else {
+		pthread_mutex_lock(&g_session_mutex);
+		int uid = g_recording_uid;
+		pthread_mutex_unlock(&g_session_mutex);
+
+		sttd_engine_monitor_begin_session(STTD_ENGINE_CALL_SET_RECORDING, uid);
+		ret = g_cur_engine.pefuncs->set_recording(data, length);
+		sttd_engine_monitor_end(STTD_ENGINE_CALL_SET_RECORDING);
+	}
 	if (0 != ret) {
 		SLOG(LOG_WARN, TAG_STTD, "[Engine Agent WARNING] set recording error(%d)", ret); 
 		return ret;
@@ -1053,7 +1465,7 @@ int sttd_engine_recognize_audio(const void* data, unsigned int length)
 	return 0;
 }
 
-int sttd_engine_recognize_stop()
+int sttd_engine_recognize_stop(int uid)
 {
 	if (false == g_agent_init) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Not Initialized"); 
@@ -1065,12 +1477,40 @@ int sttd_engine_recognize_stop()
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 
+	if (true == sttd_engine_monitor_is_hung()) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Engine is not responding"); 
+		return STTD_ERROR_OPERATION_FAILED;
+	}
+
 	if (NULL == g_cur_engine.pefuncs->stop) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] The function of engine is NULL!!");
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 
-	int ret = g_cur_engine.pefuncs->stop();
+	int ret;
+
+	__detach_recording(uid);
+
+	if (true == __is_multi_session()) {
+		sttengine_session_s* session = __get_session(uid);
+		if (NULL == session) {
+			SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] No session : uid(%d)", uid);
+			return STTD_ERROR_INVALID_STATE;
+		}
+
+		sttd_engine_monitor_begin_session(STTD_ENGINE_CALL_STOP, uid);
+		ret = g_cur_engine.pefuncs->session_stop(session->handle);
+		sttd_engine_monitor_end(STTD_ENGINE_CALL_STOP);
+
+		if (0 != ret)
+			__remove_session(session);
+
+		__release_session(session);
+	} else {
+		sttd_engine_monitor_begin_session(STTD_ENGINE_CALL_STOP, uid);
+		ret = g_cur_engine.pefuncs->stop();
+		sttd_engine_monitor_end(STTD_ENGINE_CALL_STOP);
+	}
 	if (0 != ret) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] stop recognition error(%d)", ret); 
 		return STTD_ERROR_OPERATION_FAILED;
@@ -1079,7 +1519,7 @@ int sttd_engine_recognize_stop()
 	return 0;
 }
 
-int sttd_engine_recognize_cancel()
+int sttd_engine_recognize_cancel(int uid)
 {
 	if (false == g_agent_init) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Not Initialized"); 
@@ -1090,13 +1530,40 @@ int sttd_engine_recognize_cancel()
 		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Not loaded engine"); 
 		return STTD_ERROR_OPERATION_FAILED;
 	}
+
+	if (true == sttd_engine_monitor_is_hung()) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Engine is not responding"); 
+		return STTD_ERROR_OPERATION_FAILED;
+	}
 	
 	if (NULL == g_cur_engine.pefuncs->cancel) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] The function of engine is NULL!!");
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 
-	int ret = g_cur_engine.pefuncs->cancel();
+	int ret;
+
+	__detach_recording(uid);
+
+	if (true == __is_multi_session()) {
+		sttengine_session_s* session = __get_session(uid);
+		if (NULL == session) {
+			SLOG(LOG_WARN, TAG_STTD, "[Engine Agent WARNING] No session to cancel : uid(%d)", uid);
+			return 0;
+		}
+
+		sttd_engine_monitor_begin_session(STTD_ENGINE_CALL_CANCEL, uid);
+		ret = g_cur_engine.pefuncs->session_cancel(session->handle);
+		sttd_engine_monitor_end(STTD_ENGINE_CALL_CANCEL);
+
+		/* engine does not give result of canceled session */
+		__remove_session(session);
+		__release_session(session);
+	} else {
+		sttd_engine_monitor_begin_session(STTD_ENGINE_CALL_CANCEL, uid);
+		ret = g_cur_engine.pefuncs->cancel();
+		sttd_engine_monitor_end(STTD_ENGINE_CALL_CANCEL);
+	}
 	if (0 != ret) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] cancel recognition error(%d)", ret); 
 		return STTD_ERROR_OPERATION_FAILED;
@@ -1122,7 +1589,9 @@ int sttd_engine_get_audio_format(sttp_audio_type_e* types, int* rate, int* chann
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 
+	sttd_engine_monitor_begin(STTD_ENGINE_CALL_QUERY);
 	int ret = g_cur_engine.pefuncs->get_audio_format(types, rate, channels);
+	sttd_engine_monitor_end(STTD_ENGINE_CALL_QUERY);
 	if (0 != ret) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] get audio format error(%d)", ret); 
 		return STTD_ERROR_OPERATION_FAILED;
@@ -1170,7 +1639,9 @@ int sttd_engine_supported_langs(GList** lang_list)
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 
+	sttd_engine_monitor_begin(STTD_ENGINE_CALL_QUERY);
 	int ret = g_cur_engine.pefuncs->foreach_langs(__supported_language_cb, (void*)lang_list);
+	sttd_engine_monitor_end(STTD_ENGINE_CALL_QUERY);
 	if (0 != ret) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] get language list error(%d)", ret); 
 		return STTD_ERROR_OPERATION_FAILED;
@@ -1225,7 +1696,9 @@ int sttd_engine_is_partial_result_supported(bool* partial_result)
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 
+	sttd_engine_monitor_begin(STTD_ENGINE_CALL_QUERY);
 	*partial_result = g_cur_engine.pefuncs->support_partial_result();
+	sttd_engine_monitor_end(STTD_ENGINE_CALL_QUERY);
 
 	return 0;
 }
@@ -1313,6 +1786,11 @@ int sttd_engine_setting_set_engine(const char* engine_id)
 		return STTD_ERROR_INVALID_PARAMETER;
 	}
 
+	if (true == sttd_engine_monitor_is_hung()) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Engine is not responding"); 
+		return STTD_ERROR_OPERATION_FAILED;
+	}
+
 	/* compare current engine and new engine. */
 	if (NULL != g_cur_engine.engine_uuid) {
 		if (0 == strncmp(g_cur_engine.engine_uuid, engine_id, strlen(g_cur_engine.engine_uuid))) {
@@ -1430,7 +1908,9 @@ int sttd_engine_setting_get_default_lang(char** language)
 		int ret;
 		GList* lang_list = NULL;
 
+		sttd_engine_monitor_begin(STTD_ENGINE_CALL_QUERY);
 		ret = g_cur_engine.pefuncs->foreach_langs(__supported_language_cb, &lang_list);
+		sttd_engine_monitor_end(STTD_ENGINE_CALL_QUERY);
 
 		if (0 == ret && 0 < g_list_length(lang_list)) {
 			GList *iter = NULL;
@@ -1439,7 +1919,11 @@ int sttd_engine_setting_get_default_lang(char** language)
 			if (NULL != iter) {
 				char* temp_lang = iter->data;
 
-				if (true != g_cur_engine.pefuncs->is_valid_lang(temp_lang)) {
+				sttd_engine_monitor_begin(STTD_ENGINE_CALL_QUERY);
+				bool is_valid = g_cur_engine.pefuncs->is_valid_lang(temp_lang);
+				sttd_engine_monitor_end(STTD_ENGINE_CALL_QUERY);
+
+				if (true != is_valid) {
 					SLOG(LOG_ERROR, TAG_STTD, "[Engine ERROR] Fail voice is NOT valid");
 					return STTD_ERROR_OPERATION_FAILED;
 				}
@@ -1484,7 +1968,12 @@ int sttd_engine_setting_set_default_lang(const char* language)
 	}
 
 	int ret = -1;
-	if(false == g_cur_engine.pefuncs->is_valid_lang(language)) {
+
+	sttd_engine_monitor_begin(STTD_ENGINE_CALL_QUERY);
+	bool is_valid = g_cur_engine.pefuncs->is_valid_lang(language);
+	sttd_engine_monitor_end(STTD_ENGINE_CALL_QUERY);
+
+	if(false == is_valid) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Language is NOT valid !!");
 		return STTD_ERROR_INVALID_LANGUAGE;
 	}
@@ -1541,13 +2030,16 @@ int sttd_engine_setting_set_profanity_filter(bool value)
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 
+	sttd_engine_monitor_begin(STTD_ENGINE_CALL_SET_OPTION);
 	int ret = g_cur_engine.pefuncs->set_profanity_filter(value);
+	sttd_engine_monitor_end(STTD_ENGINE_CALL_SET_OPTION);
 	if (0 != ret) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Fail set profanity filter : result(%d)", ret); 
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 
 	g_default_profanity_filter = value;
+	g_cur_engine.profanity_filter = value;
 
 	ret = sttd_config_set_default_profanity_filter((int)value);
 	if (0 != ret) {
@@ -1596,12 +2088,15 @@ int sttd_engine_setting_set_punctuation_override(bool value)
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 
+	sttd_engine_monitor_begin(STTD_ENGINE_CALL_SET_OPTION);
 	int ret = g_cur_engine.pefuncs->set_punctuation(value);
+	sttd_engine_monitor_end(STTD_ENGINE_CALL_SET_OPTION);
 	if (0 != ret) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Fail set punctuation override : result(%d)", ret); 
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 	g_default_punctuation_override = value;
+	g_cur_engine.punctuation_override = value;
 
 	ret = sttd_config_set_default_punctuation_override((int)value);
 	if (0 != ret) {
@@ -1645,13 +2140,16 @@ int sttd_engine_setting_set_silence_detection(bool value)
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 
+	sttd_engine_monitor_begin(STTD_ENGINE_CALL_SET_OPTION);
 	int ret = g_cur_engine.pefuncs->set_silence_detection(value);
+	sttd_engine_monitor_end(STTD_ENGINE_CALL_SET_OPTION);
 	if (0 != ret) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Fail set silence detection : result(%d)", ret); 
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 	
 	g_default_silence_detected = value;
+	g_cur_engine.silence_detection = value;
 
 	ret = sttd_config_set_default_silence_detection((int)value);
 	if (0 != ret) {
@@ -1704,7 +2202,9 @@ int sttd_engine_setting_get_engine_setting_info(char** engine_id, GList** settin
 	/* get setting info and move setting info to input parameter */
 	int result = 0;
 
+	sttd_engine_monitor_begin(STTD_ENGINE_CALL_QUERY);
 	result = g_cur_engine.pefuncs->foreach_engine_settings(__engine_setting_cb, setting_list);
+	sttd_engine_monitor_end(STTD_ENGINE_CALL_QUERY);
 
 	if (0 == result && 0 < g_list_length(*setting_list)) {
 		*engine_id = strdup(g_cur_engine.engine_uuid);
@@ -1739,7 +2239,9 @@ int sttd_engine_setting_set_engine_setting(const char* key, const char* value)
 	}
 
 	/* get setting info and move setting info to input parameter */
+	sttd_engine_monitor_begin(STTD_ENGINE_CALL_QUERY);
 	int ret = g_cur_engine.pefuncs->set_engine_setting(key, value);
+	sttd_engine_monitor_end(STTD_ENGINE_CALL_QUERY);
 	if (0 != ret) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Engine Agent ERROR] Fail set setting info (%d) ", ret); 
 		return STTD_ERROR_OPERATION_FAILED;
@@ -1765,6 +2267,28 @@ void __result_cb(sttp_result_event_e event, const char* type,
 		return;
 	}
 
+	/* session is finished by result */
+	if (true == __is_multi_session()) {
+		sttengine_session_s* found = NULL;
+		bool last = false;
+
+		pthread_mutex_lock(&g_session_mutex);
+		GList *iter = g_list_first(g_session_list);
+		while (NULL != iter) {
+			sttengine_session_s* session = iter->data;
+			if (NULL != session && user_data == session->user_data) {
+				found = session;
+				last = __unlink_session(session);
+				break;
+			}
+			iter = g_list_next(iter);
+		}
+		pthread_mutex_unlock(&g_session_mutex);
+
+		if (NULL != found && true == last)
+			free(found);
+	}
+
 	return g_result_cb(event, type, data, data_count, msg, user_data);
 }
 
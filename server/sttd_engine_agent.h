@@ -57,6 +57,15 @@ int sttd_engine_agent_load_current_engine();
 /** Unload current engine */
 int sttd_engine_agent_unload_current_engine();
 
+/** Get whether current engine is loaded */
+bool sttd_engine_agent_is_loaded();
+
+/** Get load count and load time(msec) of current engine */
+int sttd_engine_agent_get_load_info(int* load_count, double* last_load_time, double* total_load_time);
+
+/** Release idle caches of current engine */
+int sttd_engine_agent_shrink_memory();
+
 /** test for language list */
 int sttd_print_enginelist();
 
@@ -65,6 +74,15 @@ bool sttd_engine_agent_need_network();
 
 int sttd_engine_get_option_supported(bool* silence, bool* profanity, bool* punctuation);
 
+/** Get count of recognition sessions which current engine can process at the same time */
+int sttd_engine_agent_get_max_sessions();
+
+/** Write latency histograms of engine calls into log and file */
+int sttd_engine_agent_dump_latency();
+
+/** Get how often options are requested and really changed in current engine */
+int sttd_engine_agent_get_option_stats(int* request_count, int* profanity_count, int* punctuation_count, int* silence_count);
+
 /*
 * STT Engine Interfaces for client
 */
@@ -73,16 +91,17 @@ int sttd_engine_supported_langs(GList** lang_list);
 
 int sttd_engine_get_default_lang(char** lang);
 
-int sttd_engine_recognize_start(const char* lang, const char* recognition_type, 
+/** Start recognition. Multi session engine keeps a session per uid */
+int sttd_engine_recognize_start(int uid, const char* lang, const char* recognition_type, 
 				int profanity, int punctuation, int silence, void* user_param);
 
 int sttd_engine_recognize_audio(const void* data, unsigned int length);
 
 int sttd_engine_is_partial_result_supported(bool* partial_result);
 
-int sttd_engine_recognize_stop();
+int sttd_engine_recognize_stop(int uid);
 
-int sttd_engine_recognize_cancel();
+int sttd_engine_recognize_cancel(int uid);
 
 int sttd_engine_get_audio_format(sttp_audio_type_e* types, int* rate, int* channels);
 
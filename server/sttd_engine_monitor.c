@@ -0,0 +1,418 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*  http://www.apache.org/licenses/LICENSE-2.0
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+
+
+#include <pthread.h>
+#include <time.h>
+#include <Ecore.h>
+
+#include "sttd_main.h"
+#include "sttd_engine_monitor.h"
+
+#define MONITOR_FILE_PATH	BASE_DIRECTORY_DOWNLOAD"sttd_engine_latency"
+
+/*
+* Histogram buckets (microseconds)
+* Values under 16 have own bucket and larger values have 8 sub buckets per power of 2,
+* so relative error of bucket is less than 12.5%.
+*/
+#define MONITOR_LINEAR_BUCKET	16
+#define MONITOR_SUB_BITS	3
+#define MONITOR_SUB_BUCKET	(1 << MONITOR_SUB_BITS)
+#define MONITOR_BUCKET_COUNT	(MONITOR_LINEAR_BUCKET + (32 - 4) * MONITOR_SUB_BUCKET)
+
+typedef struct {
+	/* in-flight call */
+	double		start;		/* 0 if not called */
+	bool		overdue;
+	int		deadline;	/* msec, 0 is no deadline */
+	int		uid;		/* session of in-flight call, -1 if none */
+
+	/* statistics */
+	unsigned int	count;
+	unsigned int	overdue_count;
+	double		total;		/* msec */
+	double		max;		/* msec */
+	unsigned int	buckets[MONITOR_BUCKET_COUNT];
+} sttd_call_stat_s;
+
+typedef struct {
+	sttd_engine_call_e	call;
+	int			uid;
+	double			elapsed;
+} sttd_overdue_s;
+
+static const char* g_call_names[STTD_ENGINE_CALL_COUNT] = {
+	"initialize", "deinitialize", "set_option", "start", "set_recording", "stop", "cancel", "query", "shrink_memory"
+};
+
+static sttd_call_stat_s g_calls[STTD_ENGINE_CALL_COUNT];
+
+static sttd_engine_call_overdue_cb g_overdue_cb;
+static sttd_engine_call_overdue_cb g_recovered_cb;
+
+/* number of overdue calls not returned yet, except load calls */
+static int g_hung_count = 0;
+
+/* watchdog */
+static pthread_mutex_t g_monitor_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_watchdog_cond;
+static pthread_t g_watchdog_thread;
+static bool g_watchdog_running = false;
+
+
+double __monitor_get_time_ms()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec * 1000 + (double)ts.tv_nsec / 1000000;
+}
+
+int __monitor_bucket_index(unsigned int usec)
+{
+	if (MONITOR_LINEAR_BUCKET > usec)
+		return (int)usec;
+
+	int exp = 31 - __builtin_clz(usec);
+
+	return MONITOR_LINEAR_BUCKET + (exp - 4) * MONITOR_SUB_BUCKET + ((usec >> (exp - MONITOR_SUB_BITS)) & (MONITOR_SUB_BUCKET - 1));
+}
+
+unsigned int __monitor_bucket_value(int index)
+{
+	if (MONITOR_LINEAR_BUCKET > index)
+		return (unsigned int)index;
+
+	int exp = (index - MONITOR_LINEAR_BUCKET) / MONITOR_SUB_BUCKET + 4;
+	int sub = (index - MONITOR_LINEAR_BUCKET) % MONITOR_SUB_BUCKET;
+
+	return (unsigned int)(MONITOR_SUB_BUCKET + sub) << (exp - MONITOR_SUB_BITS);
+}
+
+/* msec of percentile. It should be called with lock */
+double __monitor_percentile(sttd_call_stat_s* stat, double percent)
+{
+	if (0 == stat->count)
+		return 0;
+
+	unsigned int target = (unsigned int)(stat->count * percent / 100);
+	unsigned int sum = 0;
+	int i;
+
+	if (target >= stat->count)
+		target = stat->count - 1;
+
+	for (i = 0; i < MONITOR_BUCKET_COUNT; i++) {
+		sum += stat->buckets[i];
+		if (sum > target)
+			return (double)__monitor_bucket_value(i) / 1000;
+	}
+
+	return stat->max;
+}
+
+void __monitor_overdue_async(void* data)
+{
+	sttd_overdue_s* overdue = (sttd_overdue_s*)data;
+
+	if (NULL == overdue)
+		return;
+
+	if (NULL != g_overdue_cb)
+		g_overdue_cb(overdue->call, overdue->uid, overdue->elapsed);
+
+	free(overdue);
+}
+
+void __monitor_recovered_async(void* data)
+{
+	sttd_overdue_s* overdue = (sttd_overdue_s*)data;
+
+	if (NULL == overdue)
+		return;
+
+	if (NULL != g_recovered_cb)
+		g_recovered_cb(overdue->call, overdue->uid, overdue->elapsed);
+
+	free(overdue);
+}
+
+bool __monitor_is_load_call(int call)
+{
+	return (STTD_ENGINE_CALL_INITIALIZE == call || STTD_ENGINE_CALL_DEINITIALIZE == call);
+}
+
+/** Report overdue call into main loop. It should be called with lock */
+void __monitor_post(Ecore_Cb func, int call, int uid, double elapsed)
+{
+	sttd_overdue_s* overdue = (sttd_overdue_s*)calloc(1, sizeof(sttd_overdue_s));
+	if (NULL == overdue)
+		return;
+
+	overdue->call = (sttd_engine_call_e)call;
+	overdue->uid = uid;
+	overdue->elapsed = elapsed;
+
+	ecore_main_loop_thread_safe_call_async(func, overdue);
+}
+
+void* __monitor_watchdog_thread(void* data)
+{
+	struct timespec ts;
+	double now;
+	double due;
+	double next;
+	int i;
+
+	pthread_mutex_lock(&g_monitor_mutex);
+
+	while (true == g_watchdog_running) {
+		now = __monitor_get_time_ms();
+		next = 0;
+
+		for (i = 0; i < STTD_ENGINE_CALL_COUNT; i++) {
+			if (0 == g_calls[i].start || true == g_calls[i].overdue || 0 >= g_calls[i].deadline)
+				continue;
+
+			due = g_calls[i].start + g_calls[i].deadline;
+			if (due <= now) {
+				g_calls[i].overdue = true;
+				g_calls[i].overdue_count++;
+
+				SLOG(LOG_ERROR, TAG_STTD, "[Engine Monitor ERROR] Engine call(%s) exceeds deadline(%d ms) : uid(%d)",
+					g_call_names[i], g_calls[i].deadline, g_calls[i].uid);
+
+				/* engine is refused until the call returns. Handler runs when main loop is free */
+				if (false == __monitor_is_load_call(i))
+					g_hung_count++;
+
+				__monitor_post(__monitor_overdue_async, i, g_calls[i].uid, now - g_calls[i].start);
+			} else if (0 == next || due < next) {
+				next = due;
+			}
+		}
+
+		if (0 == next) {
+			pthread_cond_wait(&g_watchdog_cond, &g_monitor_mutex);
+		} else {
+			ts.tv_sec = (time_t)(next / 1000);
+			ts.tv_nsec = (long)((next - (double)ts.tv_sec * 1000) * 1000000);
+			pthread_cond_timedwait(&g_watchdog_cond, &g_monitor_mutex, &ts);
+		}
+	}
+
+	pthread_mutex_unlock(&g_monitor_mutex);
+
+	return NULL;
+}
+
+int sttd_engine_monitor_initialize(int call_deadline, int load_deadline, 
+				   sttd_engine_call_overdue_cb overdue_cb, sttd_engine_call_overdue_cb recovered_cb)
+{
+	if (true == g_watchdog_running) {
+		SLOG(LOG_WARN, TAG_STTD, "[Engine Monitor WARNING] Already initialized");
+		return 0;
+	}
+
+	int i;
+	for (i = 0; i < STTD_ENGINE_CALL_COUNT; i++) {
+		memset(&g_calls[i], 0, sizeof(sttd_call_stat_s));
+		g_calls[i].deadline = call_deadline;
+	}
+	g_calls[STTD_ENGINE_CALL_INITIALIZE].deadline = load_deadline;
+
+	g_overdue_cb = overdue_cb;
+	g_recovered_cb = recovered_cb;
+	g_hung_count = 0;
+
+	if (0 >= call_deadline && 0 >= load_deadline) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Engine Monitor] Watchdog is disabled");
+		return 0;
+	}
+
+	pthread_condattr_t attr;
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(&g_watchdog_cond, &attr);
+	pthread_condattr_destroy(&attr);
+
+	g_watchdog_running = true;
+	if (0 != pthread_create(&g_watchdog_thread, NULL, __monitor_watchdog_thread, NULL)) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Engine Monitor ERROR] Fail to create watchdog thread");
+		g_watchdog_running = false;
+		pthread_cond_destroy(&g_watchdog_cond);
+		return STTD_ERROR_OPERATION_FAILED;
+	}
+
+	SLOG(LOG_DEBUG, TAG_STTD, "[Engine Monitor] Watchdog start : call deadline(%d ms), load deadline(%d ms)",
+		call_deadline, load_deadline);
+
+	return 0;
+}
+
+int sttd_engine_monitor_finalize()
+{
+	if (false == g_watchdog_running)
+		return 0;
+
+	pthread_mutex_lock(&g_monitor_mutex);
+	g_watchdog_running = false;
+	pthread_cond_signal(&g_watchdog_cond);
+	pthread_mutex_unlock(&g_monitor_mutex);
+
+	pthread_join(g_watchdog_thread, NULL);
+	pthread_cond_destroy(&g_watchdog_cond);
+
+	return 0;
+}
+
+int sttd_engine_monitor_reset()
+{
+	int i;
+
+	pthread_mutex_lock(&g_monitor_mutex);
+	for (i = 0; i < STTD_ENGINE_CALL_COUNT; i++) {
+		g_calls[i].count = 0;
+		g_calls[i].overdue_count = 0;
+		g_calls[i].total = 0;
+		g_calls[i].max = 0;
+		memset(g_calls[i].buckets, 0, sizeof(g_calls[i].buckets));
+	}
+	pthread_mutex_unlock(&g_monitor_mutex);
+
+	return 0;
+}
+
+void sttd_engine_monitor_begin(sttd_engine_call_e call)
+{
+	sttd_engine_monitor_begin_session(call, -1);
+}
+
+void sttd_engine_monitor_begin_session(sttd_engine_call_e call, int uid)
+{
+	if (0 > call || STTD_ENGINE_CALL_COUNT <= call)
+		return;
+
+	pthread_mutex_lock(&g_monitor_mutex);
+	g_calls[call].start = __monitor_get_time_ms();
+	g_calls[call].overdue = false;
+	g_calls[call].uid = uid;
+	if (true == g_watchdog_running && 0 < g_calls[call].deadline)
+		pthread_cond_signal(&g_watchdog_cond);
+	pthread_mutex_unlock(&g_monitor_mutex);
+}
+
+void sttd_engine_monitor_end(sttd_engine_call_e call)
+{
+	if (0 > call || STTD_ENGINE_CALL_COUNT <= call)
+		return;
+
+	double now = __monitor_get_time_ms();
+
+	pthread_mutex_lock(&g_monitor_mutex);
+
+	sttd_call_stat_s* stat = &g_calls[call];
+	if (0 == stat->start) {
+		pthread_mutex_unlock(&g_monitor_mutex);
+		return;
+	}
+
+	double elapsed = now - stat->start;
+	bool overdue = stat->overdue;
+	stat->start = 0;
+
+	if (true == overdue) {
+		if (false == __monitor_is_load_call(call) && 0 < g_hung_count)
+			g_hung_count--;
+
+		__monitor_post(__monitor_recovered_async, call, stat->uid, elapsed);
+	}
+
+	double usec = elapsed * 1000;
+	if (0 > usec)
+		usec = 0;
+	if ((double)0xFFFFFFFF < usec)
+		usec = (double)0xFFFFFFFF;
+
+	stat->buckets[__monitor_bucket_index((unsigned int)usec)]++;
+	stat->count++;
+	stat->total += elapsed;
+	if (stat->max < elapsed)
+		stat->max = elapsed;
+
+	pthread_mutex_unlock(&g_monitor_mutex);
+
+	if (true == overdue) {
+		SLOG(LOG_WARN, TAG_STTD, "[Engine Monitor WARNING] Engine call(%s) returned after %.3f ms", g_call_names[call], elapsed);
+	}
+}
+
+bool sttd_engine_monitor_is_hung()
+{
+	pthread_mutex_lock(&g_monitor_mutex);
+	bool hung = (0 < g_hung_count);
+	pthread_mutex_unlock(&g_monitor_mutex);
+
+	return hung;
+}
+
+int sttd_engine_monitor_dump(const char* engine_id)
+{
+	FILE* fp;
+	int i, j;
+
+	fp = fopen(MONITOR_FILE_PATH, "w");
+	if (NULL == fp) {
+		SLOG(LOG_WARN, TAG_STTD, "[Engine Monitor WARNING] Fail to open %s", MONITOR_FILE_PATH);
+	} else {
+		fprintf(fp, "ENGINE %s\n", (NULL != engine_id) ? engine_id : "NONE");
+	}
+
+	SLOG(LOG_DEBUG, TAG_STTD, "----- Engine call latency (ms) : %s", (NULL != engine_id) ? engine_id : "NONE");
+
+	pthread_mutex_lock(&g_monitor_mutex);
+
+	for (i = 0; i < STTD_ENGINE_CALL_COUNT; i++) {
+		sttd_call_stat_s* stat = &g_calls[i];
+		if (0 == stat->count)
+			continue;
+
+		double mean = stat->total / stat->count;
+		double p50 = __monitor_percentile(stat, 50);
+		double p90 = __monitor_percentile(stat, 90);
+		double p99 = __monitor_percentile(stat, 99);
+
+		SLOG(LOG_DEBUG, TAG_STTD, "[%s] count(%u) mean(%.3f) p50(%.3f) p90(%.3f) p99(%.3f) max(%.3f) overdue(%u)",
+			g_call_names[i], stat->count, mean, p50, p90, p99, stat->max, stat->overdue_count);
+
+		if (NULL != fp) {
+			fprintf(fp, "CALL %s %u %.3f %.3f %.3f %.3f %.3f %u\n",
+				g_call_names[i], stat->count, mean, p50, p90, p99, stat->max, stat->overdue_count);
+
+			/* raw buckets : lower bound (usec) and count */
+			for (j = 0; j < MONITOR_BUCKET_COUNT; j++) {
+				if (0 < stat->buckets[j])
+					fprintf(fp, "BUCKET %s %u %u\n", g_call_names[i], __monitor_bucket_value(j), stat->buckets[j]);
+			}
+		}
+	}
+
+	pthread_mutex_unlock(&g_monitor_mutex);
+
+	SLOG(LOG_DEBUG, TAG_STTD, "-----");
+
+	if (NULL != fp)
+		fclose(fp);
+
+	return 0;
+}
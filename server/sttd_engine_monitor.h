@@ -0,0 +1,75 @@
+/*
+* Copyright (c) 2011 Samsung Electronics Co., Ltd All Rights Reserved
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*  http://www.apache.org/licenses/LICENSE-2.0
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+
+
+#ifndef __STTD_ENGINE_MONITOR_H_
+#define __STTD_ENGINE_MONITOR_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+* Constants & Structures
+*/
+
+typedef enum {
+	STTD_ENGINE_CALL_INITIALIZE = 0,	/**< initialize */
+	STTD_ENGINE_CALL_DEINITIALIZE,		/**< deinitialize */
+	STTD_ENGINE_CALL_SET_OPTION,		/**< profanity, punctuation, silence setters */
+	STTD_ENGINE_CALL_START,			/**< start */
+	STTD_ENGINE_CALL_SET_RECORDING,		/**< set_recording */
+	STTD_ENGINE_CALL_STOP,			/**< stop */
+	STTD_ENGINE_CALL_CANCEL,		/**< cancel */
+	STTD_ENGINE_CALL_QUERY,			/**< language, format and engine setting functions */
+	STTD_ENGINE_CALL_SHRINK_MEMORY,		/**< shrink_memory */
+	STTD_ENGINE_CALL_COUNT
+} sttd_engine_call_e;
+
+/** Called in main loop when an engine call exceeds its deadline, and when the overdue call returns */
+typedef void (*sttd_engine_call_overdue_cb)(sttd_engine_call_e call, int uid, double elapsed);
+
+/*
+* Engine Monitor Interfaces
+*/
+
+/** Start watchdog. Deadlines are milliseconds and 0 means no deadline */
+int sttd_engine_monitor_initialize(int call_deadline, int load_deadline, 
+				   sttd_engine_call_overdue_cb overdue_cb, sttd_engine_call_overdue_cb recovered_cb);
+
+int sttd_engine_monitor_finalize();
+
+/** Clear statistics when current engine is changed */
+int sttd_engine_monitor_reset();
+
+/** Mark begin of engine call. It can be called in any thread */
+void sttd_engine_monitor_begin(sttd_engine_call_e call);
+
+/** Mark begin of engine call for session of uid */
+void sttd_engine_monitor_begin_session(sttd_engine_call_e call, int uid);
+
+/** Mark end of engine call and record latency into histogram */
+void sttd_engine_monitor_end(sttd_engine_call_e call);
+
+/** Engine is hung while an overdue call except load is not returned. New engine calls are refused */
+bool sttd_engine_monitor_is_hung();
+
+/** Write latency histograms of engine into log and file */
+int sttd_engine_monitor_dump(const char* engine_id);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* __STTD_ENGINE_MONITOR_H_ */
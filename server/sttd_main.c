@@ -16,25 +16,97 @@
 #include "sttd_server.h"
 #include "sttd_network.h"
 #include "sttd_dbus.h"
+#include "sttd_engine_agent.h"
+#include "sttd_engine_monitor.h"
 
 #include <Ecore.h>
+#include <time.h>
 #include "sttd_server.h"
 
 #define CLIENT_CLEAN_UP_TIME 500
 
+/* milliseconds from start of main */
+static double g_startup_begin = 0;
+static double g_startup_time[STTD_STARTUP_PHASE_COUNT];
+static bool g_startup_reached[STTD_STARTUP_PHASE_COUNT];
+
+static const char* g_startup_phase_name[STTD_STARTUP_PHASE_COUNT] = {
+	"bus name", "config", "recorder", "engine scan", "ready", "first request"
+};
+
+double __sttd_get_time_ms()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1000000.0;
+}
+
+void __sttd_dump_startup_timeline()
+{
+	int i;
+
+	SLOG(LOG_DEBUG, TAG_STTD, "[Main] Startup timeline (ms from process start)"); 
+
+	for (i = 0; i < STTD_STARTUP_PHASE_COUNT; i++) {
+		if (true == g_startup_reached[i])
+			SLOG(LOG_DEBUG, TAG_STTD, "[Main]   %-14s : %8.1f", g_startup_phase_name[i], g_startup_time[i]);
+		else
+			SLOG(LOG_DEBUG, TAG_STTD, "[Main]   %-14s : not reached", g_startup_phase_name[i]);
+	}
+}
+
+void sttd_main_mark_startup(sttd_startup_phase_e phase)
+{
+	if (STTD_STARTUP_PHASE_COUNT <= phase || true == g_startup_reached[phase])
+		return;
+
+	g_startup_time[phase] = __sttd_get_time_ms() - g_startup_begin;
+	g_startup_reached[phase] = true;
+
+	if (STTD_STARTUP_READY == phase) {
+		__sttd_dump_startup_timeline();
+	} else if (STTD_STARTUP_FIRST_REQUEST == phase) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Main] Time to first request : %.1f ms", g_startup_time[phase]); 
+	}
+}
+
+/* SIGUSR1 exports startup timeline, latency histograms of engine calls and dbus method statistics */
+Eina_Bool __sttd_signal_user(void* data, int type, void* event)
+{
+	Ecore_Event_Signal_User* signal = (Ecore_Event_Signal_User*)event;
+
+	if (NULL != signal && 1 == signal->number) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Main] Dump startup timeline, engine latency and dbus method statistics"); 
+		__sttd_dump_startup_timeline();
+		sttd_engine_agent_dump_latency();
+		sttd_dbus_dump_method_stats();
+	}
+
+	return ECORE_CALLBACK_PASS_ON;
+}
+
 int main(int argc, char** argv)
 {
+	g_startup_begin = __sttd_get_time_ms();
+
 	SLOG(LOG_DEBUG, TAG_STTD, "  ");
 	SLOG(LOG_DEBUG, TAG_STTD, "  ");
 	SLOG(LOG_DEBUG, TAG_STTD, "===== STT Daemon Initialize");
 
-	if (0 != sttd_initialize()) {
-		SLOG(LOG_ERROR, TAG_STTD, "[ERROR] Fail to initialize stt-daemon"); 
+	/* Own bus name first, so hello of activated client is answered at once. 
+	   Other requests wait in dbus layer until subsystems are initialized. */
+	if (0 != sttd_dbus_open_connection()) {
+		SLOG(LOG_ERROR, TAG_STTD, "[ERROR] Fail to open connection");
 		return EXIT_FAILURE;
 	}
 
-	if (0 != sttd_dbus_open_connection()) {
-		SLOG(LOG_ERROR, TAG_STTD, "[ERROR] Fail to open connection");
+	sttd_main_mark_startup(STTD_STARTUP_BUS_NAME);
+
+	/* engine scan runs in background and engine is preloaded after it */
+	if (0 != sttd_initialize()) {
+		SLOG(LOG_ERROR, TAG_STTD, "[ERROR] Fail to initialize stt-daemon"); 
+		sttd_dbus_close_connection();
 		return EXIT_FAILURE;
 	}
 
@@ -42,6 +114,8 @@ int main(int argc, char** argv)
 
 	ecore_timer_add(CLIENT_CLEAN_UP_TIME, sttd_cleanup_client, NULL);
 
+	ecore_event_handler_add(ECORE_EVENT_SIGNAL_USER, __sttd_signal_user, NULL);
+
 	printf("stt-daemon start...\n");
 
 	SLOG(LOG_DEBUG, TAG_STTD, "[Main] stt-daemon start..."); 
@@ -52,6 +126,8 @@ int main(int argc, char** argv)
 
 	ecore_main_loop_begin();
 
+	sttd_engine_monitor_finalize();
+
 	ecore_shutdown();
 
 	sttd_dbus_close_connection();
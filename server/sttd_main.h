@@ -61,6 +61,12 @@ typedef enum {
 	STTD_ERROR_NOT_SUPPORTED_FEATURE= -0x0100035	/**< Not supported feature of current engine */
 }stt_error_e;
 
+typedef enum {
+	STTD_RESIDENCY_ON_DEMAND	= 0,	/**< Load engine for first client, unload after grace period */
+	STTD_RESIDENCY_PRELOAD		= 1,	/**< Load engine at daemon start, unload after grace period */
+	STTD_RESIDENCY_PINNED		= 2	/**< Load engine at daemon start, never unload */
+}sttd_residency_e;
+
 typedef struct {
 	char* engine_id;
 	char* engine_name;
@@ -72,6 +78,31 @@ typedef struct {
 	char* value;
 }engine_setting_s;
 
+/* capability of current engine which client caches */
+typedef struct {
+	bool	silence;
+	bool	profanity;
+	bool	punctuation;
+	bool	partial_result;
+	char*	default_lang;
+	GList*	lang_list;
+	bool	valid;		/* false if engine fails to give it. Client drops its cache */
+}sttd_capability_s;
+
+/* phases of daemon startup for timeline report */
+typedef enum {
+	STTD_STARTUP_BUS_NAME = 0,	/**< Bus name is owned and hello is answered */
+	STTD_STARTUP_CONFIG,		/**< Config is loaded */
+	STTD_STARTUP_RECORDER,		/**< Recorder is initialized */
+	STTD_STARTUP_ENGINE_SCAN,	/**< Engine list is scanned and current engine is selected */
+	STTD_STARTUP_READY,		/**< Deferred requests are handled from now on */
+	STTD_STARTUP_FIRST_REQUEST,	/**< First client request except hello is handled */
+	STTD_STARTUP_PHASE_COUNT
+}sttd_startup_phase_e;
+
+/** Record elapsed time of phase from process start. Only first mark of each phase is kept */
+void sttd_main_mark_startup(sttd_startup_phase_e phase);
+
 #ifdef __cplusplus
 }
 #endif
@@ -59,6 +59,9 @@ typedef struct {
 static sttd_recorder_s *g_objRecorer = NULL;
 static bool g_init = false;
 
+/* camcorder is realized ahead of start */
+static bool g_prepared = false;
+
 static char g_temp_file_name[128] = {'\0',};
 
 #ifdef BUF_SAVE_MODE
@@ -542,6 +545,10 @@ int sttd_recorder_set(sttd_recorder_audio_type type, sttd_recorder_channel ch, u
 	if (STTD_RECORDER_STATE_READY != pVr->state) 
 		__vr_mmcam_destroy();
 
+	/* prepared camcorder has old attributes */
+	if (true == g_prepared)
+		sttd_recorder_release_handle();
+
 	/* Set attributes */
 	pVr->audio_type = type;
 	pVr->channel    = ch;
@@ -579,11 +586,16 @@ int sttd_recorder_start()
 #endif	
 
 	/* Check if initialized */
-	ret = __recorder_setup();
-	if (0 != ret) {
-		SLOG(LOG_DEBUG, TAG_STTD, "[Recorder] Fail to call __recorder_setup");
-		return STTD_ERROR_OPERATION_FAILED;
+	if (false == g_prepared) {
+		ret = __recorder_setup();
+		if (0 != ret) {
+			SLOG(LOG_DEBUG, TAG_STTD, "[Recorder] Fail to call __recorder_setup");
+			return STTD_ERROR_OPERATION_FAILED;
+		}
+	} else {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Recorder] Use prepared camcorder");
 	}
+	g_prepared = false;
 
 	/* Start camcorder */
 	ret = __recorder_run();
@@ -598,6 +610,47 @@ int sttd_recorder_start()
 }
 
 
+int sttd_recorder_prepare()
+{
+	sttd_recorder_s *pVr = __recorder_getinstance();
+	if (!pVr) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Recorder] Fail to get instance"); 
+		return -1;
+	}
+
+	if (STTD_RECORDER_STATE_READY != pVr->state) {
+		SLOG(LOG_WARN, TAG_STTD, "[Recorder WARNING] Recorder is in use");
+		return STTD_ERROR_RECORDER_BUSY;
+	}
+
+	if (true == g_prepared)
+		return 0;
+
+	/* camcorder remains when stop or cancel was failed */
+	sttd_recorder_release_handle();
+
+	if (0 != __recorder_setup()) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Recorder ERROR] Fail to prepare camcorder");
+		sttd_recorder_release_handle();
+		return STTD_ERROR_OPERATION_FAILED;
+	}
+
+	g_prepared = true;
+
+	SLOG(LOG_DEBUG, TAG_STTD, "[Recorder] Camcorder is prepared");
+
+	return 0;
+}
+
+int sttd_recorder_unprepare()
+{
+	if (false == g_prepared)
+		return 0;
+
+	return sttd_recorder_release_handle();
+}
+
+
 int sttrecorder_pause()
 {
 	int ret = 0;
@@ -678,6 +731,45 @@ int sttd_recorder_destroy()
 }
 
 
+int sttd_recorder_release_handle()
+{
+	sttd_recorder_s *pVr = __recorder_getinstance();
+	if (!pVr) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Recorder] Fail to get instance"); 
+		return -1;
+	}
+
+	if (STTD_RECORDER_STATE_READY != pVr->state) {
+		SLOG(LOG_WARN, TAG_STTD, "[Recorder WARNING] Recorder is in use");
+		return -1;
+	}
+
+	if (0 == pVr->rec_handle) 
+		return 0;
+
+	/* camcorder remains when stop or cancel was failed */
+	MMCamcorderStateType rec_status = MM_CAMCORDER_STATE_NONE;
+
+	mm_camcorder_get_state(pVr->rec_handle, &rec_status);
+	if (MM_CAMCORDER_STATE_PREPARE == rec_status) {
+		mm_camcorder_stop(pVr->rec_handle);
+		mm_camcorder_get_state(pVr->rec_handle, &rec_status);
+	}
+
+	if (MM_CAMCORDER_STATE_READY == rec_status) {
+		int mmf_ret = mm_camcorder_unrealize(pVr->rec_handle);
+		SLOG(LOG_DEBUG, TAG_STTD, "[Recorder] Call mm_camcorder_unrealize ret=(%X)", mmf_ret);
+	}
+
+	__vr_mmcam_destroy();
+
+	g_prepared = false;
+
+	SLOG(LOG_DEBUG, TAG_STTD, "[Recorder] Release camcorder handle");
+
+	return 0;
+}
+
 int sttd_recorder_state_get(sttd_recorder_state* state)
 {
 	sttd_recorder_s *pVr = __recorder_getinstance();
@@ -44,6 +44,12 @@ int sttd_recorder_set(sttd_recorder_audio_type type, sttd_recorder_channel ch, u
 
 int sttd_recorder_init();
 
+/** Realize camcorder ahead of start. Next start only begins recording */
+int sttd_recorder_prepare();
+
+/** Release camcorder prepared and not started */
+int sttd_recorder_unprepare();
+
 int sttd_recorder_start();
 
 int sttd_recorder_cancel();
@@ -58,6 +64,8 @@ int sttd_recorder_get_volume(float *vol);
 
 int sttd_recorder_destroy();
 
+int sttd_recorder_release_handle();
+
 #ifdef __cplusplus
 }
 #endif
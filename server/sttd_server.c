@@ -17,11 +17,16 @@
 
 #include "sttd_client_data.h"
 #include "sttd_engine_agent.h"
+#include "sttd_engine_monitor.h"
 #include "sttd_config.h"
 #include "sttd_recorder.h"
 #include "sttd_network.h"
 #include "sttd_dbus.h"
 
+#include <malloc.h>
+#include <signal.h>
+#include <stdint.h>
+
 /*
 * STT Server static variable
 */
@@ -29,196 +34,1413 @@ static bool g_is_engine;
 
 static double g_state_check_time = 15.5;
 
+/** engine residency */
+static int g_residency = STTD_RESIDENCY_ON_DEMAND;
+static int g_unload_delay;
+static Ecore_Timer* g_unload_timer = NULL;
+
+/** engine loading in background */
+static bool g_engine_loading = false;
+
+/** idle memory reclamation */
+static int g_reclaim_delay;
+static Ecore_Timer* g_reclaim_timer = NULL;
+
+/** recorder and engine prepared for imminent start */
+#define STTD_PREWARM_DEFAULT_HOLD	3000
+#define STTD_PREWARM_MAX_HOLD		10000
+
+typedef struct {
+	int	uid;
+	char*	lang;
+	char*	type;
+	int	profanity;
+	int	punctuation;
+	int	silence;
+
+	int*		user_data;	/* user data of engine started ahead, NULL if engine is not started */
+	Ecore_Timer*	timer;
+} prewarm_s;
+
+static prewarm_s* g_prewarm = NULL;
+
+/** timer wheel for deadline of queued start requests */
+#define STTD_QUEUE_WHEEL_SIZE	64
+#define STTD_QUEUE_WHEEL_TICK	0.25
+
 /*
-* STT Server Callback Functions											`				  *
+* Idle memory reclamation
 */
 
-Eina_Bool __stop_by_silence(void *data)
+long __get_rss_kb()
 {
-	SLOG(LOG_DEBUG, TAG_STTD, "===== Stop by silence detection");
+	long size = 0;
+	long resident = 0;
 
-	int uid = 0;
+	FILE* fp = fopen("/proc/self/statm", "r");
+	if (NULL == fp)
+		return -1;
 
-	uid = sttd_client_get_current_recording();
+	if (2 != fscanf(fp, "%ld %ld", &size, &resident)) 
+		resident = -1;
 
-	if (uid > 0) {
-		if (0 != sttd_server_stop(uid))
-			return EINA_FALSE;
+	fclose(fp);
 
-		int ret = sttdc_send_set_state(uid, (int)APP_STATE_PROCESSING);
-		if (0 != ret) {
-			SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to send state : result(%d)", ret); 
+	if (0 > resident)
+		return -1;
 
-			/* Remove client */
-			sttd_server_finalize(uid);
-		}	
+	return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+Eina_Bool __reclaim_idle_memory(void *data)
+{
+	g_reclaim_timer = NULL;
+
+	if (0 < sttd_client_get_current_recording() || 0 < sttd_client_get_current_thinking() || true == g_engine_loading 
+		|| NULL != g_prewarm) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Server] Daemon is not idle. Skip memory reclamation"); 
+		return EINA_FALSE;
 	}
 
-	SLOG(LOG_DEBUG, TAG_STTD, "=====");
-	SLOG(LOG_DEBUG, TAG_STTD, "  ");
+	long before = __get_rss_kb();
+
+	/* engine caches */
+	sttd_engine_agent_shrink_memory();
+
+	/* camcorder handle */
+	sttd_recorder_release_handle();
+
+	/* return free heap to system */
+	malloc_trim(0);
+
+	long after = __get_rss_kb();
+
+	SLOG(LOG_DEBUG, TAG_STTD, "[Server] Reclaim idle memory : RSS %ld KB -> %ld KB", before, after); 
 
 	return EINA_FALSE;
 }
 
-int audio_recorder_callback(const void* data, const unsigned int length)
+void __start_idle_reclaim()
 {
-	if (0 != sttd_engine_recognize_audio(data, length)) {
-		int uid = sttd_client_get_current_recording();
+	if (0 >= g_reclaim_delay)
+		return;
 
-		app_state_e state;
-		if (0 != sttd_client_get_state(uid, &state)) {
-			SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] uid is not valid "); 
-			return -1;
+	if (NULL != g_reclaim_timer)
+		ecore_timer_del(g_reclaim_timer);
+
+	g_reclaim_timer = ecore_timer_add((double)g_reclaim_delay, __reclaim_idle_memory, NULL);
+}
+
+void __stop_idle_reclaim()
+{
+	if (NULL != g_reclaim_timer) {
+		ecore_timer_del(g_reclaim_timer);
+		g_reclaim_timer = NULL;
+	}
+}
+
+/*
+* One-shot session
+*/
+
+Eina_Bool __finalize_once_client(void *data)
+{
+	int uid = (int)(intptr_t)data;
+
+	/* client may have left or started again */
+	app_state_e state;
+	if (0 != sttd_client_get_state(uid, &state) || APP_STATE_READY != state || false == sttd_client_is_once(uid))
+		return EINA_FALSE;
+
+	SLOG(LOG_DEBUG, TAG_STTD, "[Server] Session of one-shot client is finished : uid(%d)", uid); 
+
+	sttd_server_finalize(uid);
+
+	return EINA_FALSE;
+}
+
+/** Remove one-shot client after its session returns to ready. It is not removed in engine callback */
+void __finish_once(int uid)
+{
+	if (true == sttd_client_is_once(uid))
+		ecore_timer_add(0, __finalize_once_client, (void*)(intptr_t)uid);
+}
+
+/** one-shot request waiting for engine loading. Its reply is held by dbus */
+typedef struct {
+	int	uid;
+	char*	lang;
+	char*	type;
+	int	profanity;
+	int	punctuation;
+	int	silence;
+} once_request_s;
+
+static GList* g_once_list = NULL;
+
+once_request_s* __find_once_request(int uid)
+{
+	GList *iter = g_list_first(g_once_list);
+	while (NULL != iter) {
+		once_request_s* req = iter->data;
+		if (uid == req->uid)
+			return req;
+		iter = g_list_next(iter);
+	}
+
+	return NULL;
+}
+
+void __free_once_request(once_request_s* req)
+{
+	g_once_list = g_list_remove(g_once_list, req);
+
+	if (NULL != req->lang)	free(req->lang);
+	if (NULL != req->type)	free(req->type);
+	free(req);
+}
+
+int __start_once(int uid, const char* lang, const char* recognition_type, int profanity, int punctuation, int silence, bool silence_supported)
+{
+	/* session is stopped by silence detection or time limit of recorder */
+	if (true == silence_supported)
+		silence = 1;
+
+	sttd_client_set_once(uid, true);
+
+	int ret = sttd_server_start(uid, lang, recognition_type, profanity, punctuation, silence, 0, 0, 0, NULL);
+	if (0 != ret) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to start one-shot : result(%d)", ret); 
+		sttd_server_finalize(uid);
+		return ret;
+	}
+
+	SLOG(LOG_DEBUG, TAG_STTD, "[Server] Start one-shot : uid(%d)", uid); 
+
+	return STTD_ERROR_NONE;
+}
+
+/** Start one-shot requests which have waited for engine and reply their results */
+void __start_once_requests(int result, const sttd_capability_s* capability)
+{
+	while (NULL != g_once_list) {
+		once_request_s* req = g_once_list->data;
+		g_once_list = g_list_remove(g_once_list, req);
+
+		int uid = req->uid;
+		int ret = result;
+
+		if (0 == ret) {
+			sttd_client_set_state(uid, APP_STATE_READY);
+			ret = __start_once(uid, req->lang, req->type, req->profanity, req->punctuation, req->silence, capability->silence);
 		}
 
-		if (APP_STATE_RECORDING != state) {
-			SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Current state is not recording"); 
-			return -1;
+		sttd_dbus_send_held_reply(uid, ret);
+
+		/* client of failed load is not ready */
+		if (0 != result)
+			sttd_server_finalize(uid);
+
+		if (NULL != req->lang)	free(req->lang);
+		if (NULL != req->type)	free(req->type);
+		free(req);
+	}
+}
+
+/* pid of setting clients waiting for engine loading. Their replies are held by dbus */
+static GList* g_setting_wait_list = NULL;
+
+/** Add setting clients which have waited for engine and reply their results */
+void __add_waiting_settings(int result)
+{
+	while (NULL != g_setting_wait_list) {
+		int pid = GPOINTER_TO_INT(g_setting_wait_list->data);
+		g_setting_wait_list = g_list_delete_link(g_setting_wait_list, g_setting_wait_list);
+
+		int ret = result;
+
+		if (0 == ret && 0 != sttd_setting_client_add(pid)) {
+			SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to add setting client"); 
+			ret = STTD_ERROR_OPERATION_FAILED;
 		}
 
-		ecore_timer_add(0, __stop_by_silence, NULL);
+		sttd_dbus_send_held_setting_reply(pid, ret);
+	}
+}
 
-		/*if (0 != sttd_send_stop_recognition_by_daemon(uid)) {
-			SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail "); 
-		} else {
-			SLOG(LOG_DEBUG, TAG_STTD, "[Server SUCCESS] <<<< stop message : uid(%d)", uid); 
-		}*/
-		
-		return -1;
+/*
+* Session admission queue
+*/
+
+int __server_start(int uid, const char* lang, const char* recognition_type, int profanity, int punctuation, int silence);
+
+/** start request waiting for engine */
+typedef struct {
+	int	uid;
+	char*	lang;
+	char*	type;
+	int	profanity;
+	int	punctuation;
+	int	silence;
+
+	int		priority;
+	unsigned int	seq;
+	int		position;
+
+	/* deadline in timer wheel */
+	int	slot;
+	int	rounds;
+} start_request_s;
+
+/* requests sorted by priority and arrival */
+static GList* g_start_queue = NULL;
+static unsigned int g_start_seq = 0;
+
+static GList* g_wheel[STTD_QUEUE_WHEEL_SIZE];
+static int g_wheel_pos = 0;
+static Ecore_Timer* g_wheel_timer = NULL;
+
+static Ecore_Timer* g_admit_timer = NULL;
+
+bool __can_start()
+{
+	if (0 < sttd_client_get_current_recording()) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Server] Current STT Engine is busy because of recording");
+		return false;
 	}
 
-	return 0;
+	/* multi session engine can start recognition while others are thinking */
+	if (sttd_engine_agent_get_max_sessions() <= sttd_client_get_processing_count()) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Server] Current STT Engine is busy because of thinking");
+		return false;
+	}
+
+	return true;
 }
 
-void sttd_server_recognition_result_callback(sttp_result_event_e event, const char* type, 
-					const char** data, int data_count, const char* msg, void *user_data)
+gint __compare_start_request(gconstpointer a, gconstpointer b)
 {
-	SLOG(LOG_DEBUG, TAG_STTD, "===== Recognition Result Callback");
+	const start_request_s* req_a = a;
+	const start_request_s* req_b = b;
 
-	/* check uid */
-	int *uid = (int*)user_data;
+	if (req_a->priority != req_b->priority)
+		return (req_a->priority > req_b->priority) ? -1 : 1;
 
-	SLOG(LOG_DEBUG, TAG_STTD, "[Server] uid (%d), event(%d)", *uid, event); 
+	return (req_a->seq < req_b->seq) ? -1 : 1;
+}
 
-	app_state_e state;
-	if (0 != sttd_client_get_state(*uid, &state)) {
-		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] uid is NOT valid "); 
-		SLOG(LOG_DEBUG, TAG_STTD, "=====");
-		SLOG(LOG_DEBUG, TAG_STTD, "  ");
-		return;
+start_request_s* __find_start_request(int uid)
+{
+	GList *iter = g_list_first(g_start_queue);
+	while (NULL != iter) {
+		start_request_s* req = iter->data;
+		if (uid == req->uid)
+			return req;
+		iter = g_list_next(iter);
 	}
 
-	/* Delete timer for processing time out */
-	Ecore_Timer* timer;
-	sttd_cliet_get_timer(*uid, &timer);
+	return NULL;
+}
 
-	if (NULL != timer)
-		ecore_timer_del(timer);
+void __free_start_request(start_request_s* req)
+{
+	g_start_queue = g_list_remove(g_start_queue, req);
+	g_wheel[req->slot] = g_list_remove(g_wheel[req->slot], req);
 
-	/* send result to client */
-	if (STTP_RESULT_EVENT_SUCCESS == event && 0 < data_count && NULL != data) {
+	if (NULL != req->lang)	free(req->lang);
+	if (NULL != req->type)	free(req->type);
+	free(req);
+}
 
-		if (APP_STATE_PROCESSING == state ) {
-			SLOG(LOG_DEBUG, TAG_STTD, "[Server] the size of result from engine is '%d' %s", data_count); 
+void __notify_queue_position()
+{
+	int position = 1;
+	GList *iter = g_list_first(g_start_queue);
 
-			if (0 != sttdc_send_result(*uid, type, data, data_count, msg)) {
-				SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to send result"); 	
-				int reason = (int)STTD_ERROR_OPERATION_FAILED;
+	while (NULL != iter) {
+		start_request_s* req = iter->data;
 
-				if (0 != sttdc_send_error_signal(*uid, reason, "Fail to send recognition result")) {
-					SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to send error info . Remove client data"); 
-				}
-			}
-		} else {
-			SLOG(LOG_WARN, TAG_STTD, "[Server WARNING] Current state is NOT thinking."); 
+		/* notify clients whose position is changed only */
+		if (position != req->position) {
+			req->position = position;
+			sttdc_send_queue_position(req->uid, position);
 		}
-	} else if (STTP_RESULT_EVENT_NO_RESULT == event || STTP_RESULT_EVENT_ERROR == event) {
 
-		if (APP_STATE_PROCESSING == state ) {
-			if (0 != sttdc_send_result(*uid, type, NULL, 0, msg)) {
-				SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to send result "); 
+		position++;
+		iter = g_list_next(iter);
+	}
+}
 
-				/* send error msg */
-				int reason = (int)STTD_ERROR_INVALID_STATE;	
-				if (0 != sttdc_send_error_signal(*uid, reason, "[ERROR] Fail to send recognition result")) {
-					SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to send error info "); 
-				}
+Eina_Bool __queue_wheel_tick(void *data)
+{
+	g_wheel_pos = (g_wheel_pos + 1) % STTD_QUEUE_WHEEL_SIZE;
+
+	GList *iter = g_list_first(g_wheel[g_wheel_pos]);
+	while (NULL != iter) {
+		start_request_s* req = iter->data;
+		iter = g_list_next(iter);
+
+		if (0 < req->rounds) {
+			req->rounds--;
+			continue;
+		}
+
+		SLOG(LOG_DEBUG, TAG_STTD, "[Server] Wait time of uid(%d) is expired", req->uid); 
+
+		int uid = req->uid;
+		__free_start_request(req);
+
+		if (0 != sttdc_send_error_signal(uid, (int)STTD_ERROR_RECORDER_BUSY, "[ERROR] Wait time for recognition is expired")) {
+			SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to send error info "); 
+		}
+	}
+
+	if (NULL == g_start_queue) {
+		g_wheel_timer = NULL;
+		return EINA_FALSE;
+	}
+
+	__notify_queue_position();
+
+	return EINA_TRUE;
+}
+
+int __enqueue_start_request(int uid, const char* lang, const char* recognition_type, 
+			    int profanity, int punctuation, int silence, int priority, int wait_timeout)
+{
+	start_request_s* req = (start_request_s*)calloc(1, sizeof(start_request_s));
+	if (NULL == req) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to allocate memory"); 
+		return -1;
+	}
+
+	req->uid = uid;
+	req->lang = (NULL != lang) ? strdup(lang) : NULL;
+	req->type = (NULL != recognition_type) ? strdup(recognition_type) : NULL;
+	req->profanity = profanity;
+	req->punctuation = punctuation;
+	req->silence = silence;
+	req->priority = priority;
+	req->seq = g_start_seq++;
+
+	/* round up deadline to wheel tick */
+	int ticks = (int)((wait_timeout / 1000.0 + STTD_QUEUE_WHEEL_TICK - 0.001) / STTD_QUEUE_WHEEL_TICK);
+	if (1 > ticks)
+		ticks = 1;
+
+	req->slot = (g_wheel_pos + ticks) % STTD_QUEUE_WHEEL_SIZE;
+	req->rounds = (ticks - 1) / STTD_QUEUE_WHEEL_SIZE;
+
+	g_start_queue = g_list_insert_sorted(g_start_queue, req, __compare_start_request);
+	g_wheel[req->slot] = g_list_append(g_wheel[req->slot], req);
+
+	if (NULL == g_wheel_timer)
+		g_wheel_timer = ecore_timer_add(STTD_QUEUE_WHEEL_TICK, __queue_wheel_tick, NULL);
+
+	req->position = g_list_index(g_start_queue, req) + 1;
+
+	return req->position;
+}
+
+void __remove_start_request(int uid)
+{
+	start_request_s* req = __find_start_request(uid);
+	if (NULL == req)
+		return;
+
+	SLOG(LOG_DEBUG, TAG_STTD, "[Server] Remove queued request of uid(%d)", uid); 
+
+	__free_start_request(req);
+
+	__notify_queue_position();
+}
+
+Eina_Bool __admit_start_request(void *data)
+{
+	g_admit_timer = NULL;
+
+	while (NULL != g_start_queue && true == __can_start()) {
+		start_request_s* req = g_list_first(g_start_queue)->data;
+
+		int uid = req->uid;
+		int ret = STTD_ERROR_INVALID_PARAMETER;
+
+		app_state_e state;
+		if (0 == sttd_client_get_state(uid, &state) && APP_STATE_READY == state)
+			ret = __server_start(uid, req->lang, req->type, req->profanity, req->punctuation, req->silence);
+
+		__free_start_request(req);
+
+		if (STTD_ERROR_NONE == ret) {
+			SLOG(LOG_DEBUG, TAG_STTD, "[Server] Queued request of uid(%d) is admitted", uid); 
+
+			if (0 != sttdc_send_set_state(uid, (int)APP_STATE_RECORDING, sttd_server_client_reply_callback, NULL)) {
+				SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to send state"); 
+
+				/* Remove client */
+				sttd_server_finalize(uid);
 			}
 		} else {
-			SLOG(LOG_WARN, TAG_STTD, "[Server ERROR] Current state is NOT thinking."); 
+			SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to start queued request : uid(%d), result(%d)", uid, ret); 
+
+			if (0 != sttdc_send_error_signal(uid, ret, "[ERROR] Fail to start recognition")) {
+				SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to send error info "); 
+			}
 		}
-	} else {
-		/* nothing */
 	}
 
-	/* change state of uid */
-	sttd_client_set_state(*uid, APP_STATE_READY);
+	__notify_queue_position();
 
-	if (NULL != user_data)	
-		free(user_data);
+	return EINA_FALSE;
+}
+
+/** Admit queued requests after current callback returns */
+void __schedule_admission()
+{
+	if (NULL == g_start_queue || NULL != g_admit_timer)
+		return;
+
+	g_admit_timer = ecore_timer_add(0, __admit_start_request, NULL);
+}
+
+/*
+* Partial result coalescing
+*/
+
+int __send_partial_result(int uid, partial_result_s* partial)
+{
+	if (NULL == partial->pending)
+		return 0;
+
+	/* length of text which client can keep */
+	int keep = 0;
+	if (NULL != partial->sent) {
+		while ('\0' != partial->sent[keep] && partial->sent[keep] == partial->pending[keep])
+			keep++;
+
+		/* suffix should start at character boundary of UTF-8 */
+		while (0 < keep && 0x80 == (partial->pending[keep] & 0xC0))
+			keep--;
+	}
+
+	if (0 != sttdc_send_partial_result(uid, keep, partial->pending + keep)) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to send partial result"); 	
+	}
+
+	if (NULL != partial->sent)
+		free(partial->sent);
+
+	partial->sent = partial->pending;
+	partial->pending = NULL;
+	partial->sent_time = ecore_time_get();
+
+	return 0;
+}
+
+Eina_Bool __send_partial_result_by_timer(void* data)
+{
+	int uid = (int)(intptr_t)data;
+
+	/* timer is deleted when client is removed */
+	partial_result_s* partial = sttd_client_get_partial_result(uid);
+	if (NULL == partial)
+		return EINA_FALSE;
+
+	partial->timer = NULL;
+
+	__send_partial_result(uid, partial);
+
+	return EINA_FALSE;
+}
+
+void __coalesce_partial_result(int uid, const char* data)
+{
+	partial_result_s* partial = sttd_client_get_partial_result(uid);
+	if (NULL == partial)
+		return;
+
+	/* only latest text is worth sending */
+	if (NULL != partial->pending)
+		free(partial->pending);
+
+	partial->pending = NULL;
+
+	if (NULL != partial->sent && 0 == strcmp(partial->sent, data))
+		return;
+
+	partial->pending = strdup(data);
+
+	/* timer sends the latest one */
+	if (NULL != partial->timer)
+		return;
+
+	int interval = 0;
+	sttd_client_get_partial_interval(uid, &interval);
+
+	double wait = partial->sent_time + (double)interval / 1000.0 - ecore_time_get();
+
+	if (0 >= interval || 0 >= wait) 
+		__send_partial_result(uid, partial);
+	else 
+		partial->timer = ecore_timer_add(wait, __send_partial_result_by_timer, (void*)(intptr_t)uid);
+}
+
+/*
+* STT Server Callback Functions											`				  *
+*/
+
+Eina_Bool __stop_by_silence(void *data)
+{
+	SLOG(LOG_DEBUG, TAG_STTD, "===== Stop by silence detection");
+
+	int uid = 0;
+
+	uid = sttd_client_get_current_recording();
+
+	if (uid > 0) {
+		if (0 != sttd_server_stop(uid))
+			return EINA_FALSE;
+
+		int ret = sttdc_send_set_state(uid, (int)APP_STATE_PROCESSING, sttd_server_client_reply_callback, NULL);
+		if (0 != ret) {
+			SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to send state : result(%d)", ret); 
+
+			/* Remove client */
+			sttd_server_finalize(uid);
+		}	
+	}
+
+	SLOG(LOG_DEBUG, TAG_STTD, "=====");
+	SLOG(LOG_DEBUG, TAG_STTD, "  ");
+
+	return EINA_FALSE;
+}
+
+/** sessions failed while engine is hung. Recorder and engine are canceled when engine returns */
+static GList* g_hung_session_list = NULL;
+
+/** Tell client that its session is failed and make it ready */
+void __fail_overdue_session(int uid)
+{
+	sttd_client_reset_partial_result(uid);
+
+	Ecore_Timer* timer;
+	sttd_cliet_get_timer(uid, &timer);
+	if (NULL != timer) {
+		ecore_timer_del(timer);
+		sttd_cliet_set_timer(uid, NULL);
+	}
+
+	if (0 != sttdc_send_result(uid, STTP_RECOGNITION_TYPE_FREE, NULL, 0, "Engine is not responding.")) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to send result "); 
+
+		int reason = (int)STTD_ERROR_TIMED_OUT;	
+		if (0 != sttdc_send_error_signal(uid, reason, "[ERROR] Engine is not responding")) {
+			SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to send error info "); 
+		}
+	}
+
+	sttd_client_set_state(uid, APP_STATE_READY);
+
+	__finish_once(uid);
+}
+
+void __engine_call_overdue(sttd_engine_call_e call, int uid, double elapsed)
+{
+	SLOG(LOG_DEBUG, TAG_STTD, "===== Engine call overdue");
+	SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Engine call(%d) is not returned for %.1f ms : uid(%d)", call, elapsed, uid); 
+
+	/* hang of load is reported by engine ready */
+	if (STTD_ENGINE_CALL_INITIALIZE == call || STTD_ENGINE_CALL_DEINITIALIZE == call) {
+		SLOG(LOG_DEBUG, TAG_STTD, "=====");
+		SLOG(LOG_DEBUG, TAG_STTD, "  ");
+		return;
+	}
+
+	if (-1 == uid) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Server] No session to cancel"); 
+		SLOG(LOG_DEBUG, TAG_STTD, "=====");
+		SLOG(LOG_DEBUG, TAG_STTD, "  ");
+		return;
+	}
+
+	app_state_e state;
+	if (0 != sttd_client_get_state(uid, &state)) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] uid is NOT valid "); 
+		SLOG(LOG_DEBUG, TAG_STTD, "=====");
+		SLOG(LOG_DEBUG, TAG_STTD, "  ");
+		return;
+	}
+
+	/* session of hung call is already finished */
+	if (APP_STATE_RECORDING != state && APP_STATE_PROCESSING != state) {
+		SLOG(LOG_WARN, TAG_STTD, "[Server WARNING] Session is not in progress : uid(%d), state(%d)", uid, state); 
+		SLOG(LOG_DEBUG, TAG_STTD, "=====");
+		SLOG(LOG_DEBUG, TAG_STTD, "  ");
+		return;
+	}
+
+	if (true == sttd_engine_monitor_is_hung()) {
+		/* recorder thread can be in the hung call, so recorder and engine are left until it returns */
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Engine is hung. Fail session : uid(%d)", uid); 
+		g_hung_session_list = g_list_append(g_hung_session_list, GINT_TO_POINTER(uid));
+		__fail_overdue_session(uid);
+	} else {
+		/* call has returned while main loop waits */
+		if (APP_STATE_RECORDING == state) 
+			sttd_recorder_cancel();
+
+		int ret = sttd_engine_recognize_cancel(uid);
+		if (0 != ret) {
+			SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to cancel : result(%d)", ret); 
+		}
+
+		__fail_overdue_session(uid);
+
+		__schedule_admission();
+
+		__start_idle_reclaim();
+	}
+
+	SLOG(LOG_DEBUG, TAG_STTD, "=====");
+	SLOG(LOG_DEBUG, TAG_STTD, "  ");
+}
+
+void __engine_call_recovered(sttd_engine_call_e call, int uid, double elapsed)
+{
+	SLOG(LOG_DEBUG, TAG_STTD, "===== Engine call recovered");
+	SLOG(LOG_WARN, TAG_STTD, "[Server WARNING] Engine call(%d) returned after %.1f ms : uid(%d)", call, elapsed, uid); 
+
+	/* other call is still hung */
+	if (true == sttd_engine_monitor_is_hung()) {
+		SLOG(LOG_DEBUG, TAG_STTD, "=====");
+		SLOG(LOG_DEBUG, TAG_STTD, "  ");
+		return;
+	}
+
+	/* new session may start between return of call and this handler */
+	bool idle = (-1 == sttd_client_get_current_recording() && -1 == sttd_client_get_current_thinking());
+
+	while (NULL != g_hung_session_list) {
+		int hung_uid = GPOINTER_TO_INT(g_hung_session_list->data);
+		g_hung_session_list = g_list_delete_link(g_hung_session_list, g_hung_session_list);
+
+		if (false == idle)
+			continue;
+
+		sttd_recorder_state recorder_state = STTD_RECORDER_STATE_READY;
+		sttd_recorder_state_get(&recorder_state);
+		if (STTD_RECORDER_STATE_RECORDING == recorder_state)
+			sttd_recorder_cancel();
+
+		if (0 != sttd_engine_recognize_cancel(hung_uid)) {
+			SLOG(LOG_WARN, TAG_STTD, "[Server WARNING] Fail to cancel failed session : uid(%d)", hung_uid); 
+		}
+	}
+
+	__schedule_admission();
+
+	__start_idle_reclaim();
+
+	SLOG(LOG_DEBUG, TAG_STTD, "=====");
+	SLOG(LOG_DEBUG, TAG_STTD, "  ");
+}
+
+int audio_recorder_callback(const void* data, const unsigned int length)
+{
+	if (0 != sttd_engine_recognize_audio(data, length)) {
+		int uid = sttd_client_get_current_recording();
+
+		app_state_e state;
+		if (0 != sttd_client_get_state(uid, &state)) {
+			SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] uid is not valid "); 
+			return -1;
+		}
+
+		if (APP_STATE_RECORDING != state) {
+			SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Current state is not recording"); 
+			return -1;
+		}
+
+		ecore_timer_add(0, __stop_by_silence, NULL);
+
+		/*if (0 != sttd_send_stop_recognition_by_daemon(uid)) {
+			SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail "); 
+		} else {
+			SLOG(LOG_DEBUG, TAG_STTD, "[Server SUCCESS] <<<< stop message : uid(%d)", uid); 
+		}*/
+		
+		return -1;
+	}
+
+	return 0;
+}
+
+void sttd_server_recognition_result_callback(sttp_result_event_e event, const char* type, 
+					const char** data, int data_count, const char* msg, void *user_data)
+{
+	SLOG(LOG_DEBUG, TAG_STTD, "===== Recognition Result Callback");
+
+	/* engine started by prewarm finished before start request. Client is still ready */
+	if (NULL != g_prewarm && NULL != user_data && g_prewarm->user_data == user_data) {
+		SLOG(LOG_WARN, TAG_STTD, "[Server WARNING] Engine started by prewarm is finished : uid(%d), event(%d)", g_prewarm->uid, event); 
+		g_prewarm->user_data = NULL;
+		free(user_data);
+
+		SLOG(LOG_DEBUG, TAG_STTD, "=====");
+		SLOG(LOG_DEBUG, TAG_STTD, "  ");
+		return;
+	}
+
+	/* check uid */
+	int *uid = (int*)user_data;
+
+	SLOG(LOG_DEBUG, TAG_STTD, "[Server] uid (%d), event(%d)", *uid, event); 
+
+	app_state_e state;
+	if (0 != sttd_client_get_state(*uid, &state)) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] uid is NOT valid "); 
+		SLOG(LOG_DEBUG, TAG_STTD, "=====");
+		SLOG(LOG_DEBUG, TAG_STTD, "  ");
+		return;
+	}
+
+	/* Delete timer for processing time out */
+	Ecore_Timer* timer;
+	sttd_cliet_get_timer(*uid, &timer);
+
+	if (NULL != timer)
+		ecore_timer_del(timer);
+
+	/* final result supersedes partial result not sent yet */
+	sttd_client_reset_partial_result(*uid);
+
+	/* send result to client */
+	if (STTP_RESULT_EVENT_SUCCESS == event && 0 < data_count && NULL != data) {
+
+		if (APP_STATE_PROCESSING == state ) {
+			SLOG(LOG_DEBUG, TAG_STTD, "[Server] the size of result from engine is '%d' %s", data_count); 
+
+			if (0 != sttdc_send_result(*uid, type, data, data_count, msg)) {
+				SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to send result"); 	
+				int reason = (int)STTD_ERROR_OPERATION_FAILED;
+
+				if (0 != sttdc_send_error_signal(*uid, reason, "Fail to send recognition result")) {
+					SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to send error info . Remove client data"); 
+				}
+			}
+		} else {
+			SLOG(LOG_WARN, TAG_STTD, "[Server WARNING] Current state is NOT thinking."); 
+		}
+	} else if (STTP_RESULT_EVENT_NO_RESULT == event || STTP_RESULT_EVENT_ERROR == event) {
+
+		if (APP_STATE_PROCESSING == state ) {
+			if (0 != sttdc_send_result(*uid, type, NULL, 0, msg)) {
+				SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to send result "); 
+
+				/* send error msg */
+				int reason = (int)STTD_ERROR_INVALID_STATE;	
+				if (0 != sttdc_send_error_signal(*uid, reason, "[ERROR] Fail to send recognition result")) {
+					SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to send error info "); 
+				}
+			}
+		} else {
+			SLOG(LOG_WARN, TAG_STTD, "[Server ERROR] Current state is NOT thinking."); 
+		}
+	} else {
+		/* nothing */
+	}
+
+	/* change state of uid */
+	sttd_client_set_state(*uid, APP_STATE_READY);
+
+	__finish_once(*uid);
+
+	__schedule_admission();
+
+	__start_idle_reclaim();
+
+	if (NULL != user_data)	
+		free(user_data);
+
+	SLOG(LOG_DEBUG, TAG_STTD, "=====");
+	SLOG(LOG_DEBUG, TAG_STTD, "  ");
+
+	return;
+}
+
+void sttd_server_partial_result_callback(sttp_result_event_e event, const char* data, void *user_data)
+{
+	SLOG(LOG_DEBUG, TAG_STTD, "===== Partial Result Callback");
+
+	/* recording is not started yet */
+	if (NULL != g_prewarm && NULL != user_data && g_prewarm->user_data == user_data) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Server] Ignore partial result of prewarm"); 
+		SLOG(LOG_DEBUG, TAG_STTD, "=====");
+		SLOG(LOG_DEBUG, TAG_STTD, "  ");
+		return;
+	}
+
+	/* check uid */
+	int *uid = (int*)user_data;
+
+	SLOG(LOG_DEBUG, TAG_STTD, "[Server] uid (%d), event(%d)", uid, event); 
+
+	app_state_e state;
+	if (0 != sttd_client_get_state(*uid, &state)) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] uid is NOT valid "); 
+		SLOG(LOG_DEBUG, TAG_STTD, "=====");
+		SLOG(LOG_DEBUG, TAG_STTD, "  ");
+		return;
+	}
+
+	/* send result to client at its cadence */
+	if (STTP_RESULT_EVENT_SUCCESS == event && NULL != data) {
+		__coalesce_partial_result(*uid, data);
+	} 
+
+	SLOG(LOG_DEBUG, TAG_STTD, "=====");
+	SLOG(LOG_DEBUG, TAG_STTD, "  ");
+}
+
+void sttd_server_silence_dectection_callback(void *user_param)
+{
+	SLOG(LOG_DEBUG, TAG_STTD, "===== Silence Detection Callback");
+
+	int uid = sttd_client_get_current_recording();
+
+	app_state_e state;
+	if (0 != sttd_client_get_state(uid, &state)) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] uid is not valid "); 
+		return;
+	}
+
+	if (APP_STATE_RECORDING != state) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Current state is not recording"); 
+		return;
+	}
+
+	ecore_timer_add(0, __stop_by_silence, NULL);
+
+	SLOG(LOG_DEBUG, TAG_STTD, "=====");
+	SLOG(LOG_DEBUG, TAG_STTD, "  ");
+
+	return;
+}
+
+/*
+* Engine residency
+*/
+
+Eina_Bool __unload_engine_by_timer(void *data)
+{
+	g_unload_timer = NULL;
+
+	if (0 != sttd_client_get_ref_count() || true == g_engine_loading) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Server] Engine is in use again. Keep engine loaded"); 
+		return EINA_FALSE;
+	}
+
+	if (0 != sttd_engine_agent_unload_current_engine()) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to unload current engine"); 
+	} else {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Server SUCCESS] unload current engine after idle %d sec", g_unload_delay); 
+	}
+
+	__start_idle_reclaim();
+
+	return EINA_FALSE;
+}
+
+void __cancel_engine_unload()
+{
+	if (NULL != g_unload_timer) {
+		ecore_timer_del(g_unload_timer);
+		g_unload_timer = NULL;
+		SLOG(LOG_DEBUG, TAG_STTD, "[Server] Cancel pending engine unload"); 
+	}
+}
+
+void __release_engine()
+{
+	/* engine load thread will decide after loading */
+	if (true == g_engine_loading)
+		return;
+
+	/* unload engine, if ref count of client is 0 */
+	if (0 != sttd_client_get_ref_count())
+		return;
+
+	if (STTD_RESIDENCY_PINNED == g_residency)
+		return;
+
+	if (0 < g_unload_delay) {
+		if (NULL != g_unload_timer)
+			ecore_timer_del(g_unload_timer);
+
+		g_unload_timer = ecore_timer_add((double)g_unload_delay, __unload_engine_by_timer, NULL);
+		SLOG(LOG_DEBUG, TAG_STTD, "[Server] Engine will be unloaded after %d sec", g_unload_delay); 
+		return;
+	}
+
+	if (0 != sttd_engine_agent_unload_current_engine()) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to unload current engine"); 
+	} else {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Server SUCCESS] unload current engine"); 
+	}
+}
+
+/*
+* Prewarm
+*/
+
+void __drop_prewarm()
+{
+	if (NULL == g_prewarm)
+		return;
+
+	SLOG(LOG_DEBUG, TAG_STTD, "[Server] Drop prewarm : uid(%d)", g_prewarm->uid); 
+
+	if (NULL != g_prewarm->timer)
+		ecore_timer_del(g_prewarm->timer);
+
+	/* result callback is not called after cancel */
+	if (NULL != g_prewarm->user_data) {
+		sttd_engine_recognize_cancel(g_prewarm->uid);
+		free(g_prewarm->user_data);
+	}
+
+	sttd_recorder_unprepare();
+
+	if (NULL != g_prewarm->lang)
+		free(g_prewarm->lang);
+	if (NULL != g_prewarm->type)
+		free(g_prewarm->type);
+
+	free(g_prewarm);
+	g_prewarm = NULL;
+}
+
+Eina_Bool __prewarm_expired(void *data)
+{
+	if (NULL == g_prewarm)
+		return EINA_FALSE;
+
+	g_prewarm->timer = NULL;
+
+	SLOG(LOG_DEBUG, TAG_STTD, "[Server] Prewarm is expired : uid(%d)", g_prewarm->uid); 
+
+	__drop_prewarm();
+
+	__start_idle_reclaim();
+
+	return EINA_FALSE;
+}
+
+/** 
+* Take prewarm for start of uid. Camcorder stays prepared for recorder start.
+* Return user data of engine started ahead with same options, or NULL if engine should be started.
+*/
+int* __take_prewarm(int uid, const char* lang, const char* recognition_type, int profanity, int punctuation, int silence)
+{
+	if (NULL == g_prewarm)
+		return NULL;
+
+	int* user_data = g_prewarm->user_data;
+
+	if (NULL != user_data) {
+		if (uid != g_prewarm->uid || 0 != strcmp(lang, g_prewarm->lang) || 0 != strcmp(recognition_type, g_prewarm->type) 
+			|| profanity != g_prewarm->profanity || punctuation != g_prewarm->punctuation || silence != g_prewarm->silence) {
+			SLOG(LOG_DEBUG, TAG_STTD, "[Server] Start is different from prewarm. Restart engine"); 
+			sttd_engine_recognize_cancel(g_prewarm->uid);
+			free(user_data);
+			user_data = NULL;
+		}
+	}
+
+	if (NULL != g_prewarm->timer)
+		ecore_timer_del(g_prewarm->timer);
+
+	free(g_prewarm->lang);
+	free(g_prewarm->type);
+	free(g_prewarm);
+	g_prewarm = NULL;
+
+	return user_data;
+}
+
+int sttd_server_prewarm(const int uid, const char* lang, const char* recognition_type, 
+			int profanity, int punctuation, int silence, int hold_ms)
+{
+	/* check if uid is valid */
+	app_state_e state;
+	if (0 != sttd_client_get_state(uid, &state)) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] uid is NOT valid "); 
+		return STTD_ERROR_INVALID_PARAMETER;
+	}
+
+	if (NULL == lang || NULL == recognition_type) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Input parameter is NULL"); 
+		return STTD_ERROR_INVALID_PARAMETER;
+	}
+
+	/* check uid state */
+	if (APP_STATE_READY != state || NULL != __find_start_request(uid)) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] sttd_server_prewarm : current state is not ready"); 
+		return STTD_ERROR_INVALID_STATE;
+	}
+
+	if (0 >= hold_ms)
+		hold_ms = STTD_PREWARM_DEFAULT_HOLD;
+	else if (STTD_PREWARM_MAX_HOLD < hold_ms)
+		hold_ms = STTD_PREWARM_MAX_HOLD;
+
+	/* same prewarm is extended */
+	if (NULL != g_prewarm) {
+		if (uid == g_prewarm->uid && 0 == strcmp(lang, g_prewarm->lang) && 0 == strcmp(recognition_type, g_prewarm->type) 
+			&& profanity == g_prewarm->profanity && punctuation == g_prewarm->punctuation && silence == g_prewarm->silence) {
+			if (NULL != g_prewarm->timer)
+				ecore_timer_del(g_prewarm->timer);
+			g_prewarm->timer = ecore_timer_add((double)hold_ms / 1000, __prewarm_expired, NULL);
+
+			SLOG(LOG_DEBUG, TAG_STTD, "[Server] Extend prewarm : uid(%d), hold(%d ms)", uid, hold_ms); 
+			return STTD_ERROR_NONE;
+		}
+
+		__drop_prewarm();
+	}
+
+	/* prewarm is a hint, it does not wait for others */
+	if (NULL != g_start_queue || false == __can_start()) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Server] Skip prewarm. Current STT Engine is busy"); 
+		return STTD_ERROR_RECORDER_BUSY;
+	}
+
+	__stop_idle_reclaim();
+
+	g_prewarm = (prewarm_s*)calloc(1, sizeof(prewarm_s));
+	if (NULL == g_prewarm) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to allocate memory"); 
+		return STTD_ERROR_OUT_OF_MEMORY;
+	}
+
+	g_prewarm->uid = uid;
+	g_prewarm->lang = strdup(lang);
+	g_prewarm->type = strdup(recognition_type);
+	g_prewarm->profanity = profanity;
+	g_prewarm->punctuation = punctuation;
+	g_prewarm->silence = silence;
+
+	if (0 != sttd_recorder_prepare()) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to prepare recorder"); 
+		__drop_prewarm();
+		__start_idle_reclaim();
+		return STTD_ERROR_OPERATION_FAILED;
+	}
+
+	/* engine waits audio until recorder starts. Network engine is started by start */
+	if (false == g_engine_loading && true == sttd_engine_agent_is_loaded() && false == sttd_engine_agent_need_network()) {
+		int* user_data = (int*)malloc(sizeof(int));
+		if (NULL != user_data) {
+			/* owned by prewarm until start takes it. Result callback does not touch client for it */
+			*user_data = uid;
+
+			if (0 != sttd_engine_recognize_start(uid, lang, recognition_type, profanity, punctuation, silence, (void*)user_data)) {
+				SLOG(LOG_WARN, TAG_STTD, "[Server WARNING] Fail to start engine ahead. Only recorder is prepared"); 
+				free(user_data);
+			} else {
+				g_prewarm->user_data = user_data;
+			}
+		}
+	}
+
+	g_prewarm->timer = ecore_timer_add((double)hold_ms / 1000, __prewarm_expired, NULL);
+
+	SLOG(LOG_DEBUG, TAG_STTD, "[Server] Prewarm : uid(%d), lang(%s), type(%s), engine(%s), hold(%d ms)", 
+		uid, lang, recognition_type, (NULL != g_prewarm->user_data) ? "started" : "not started", hold_ms); 
+
+	return STTD_ERROR_NONE;
+}
+
+int __set_recorder_by_engine()
+{
+	/* initialize recorder using audio format from engine */
+	sttp_audio_type_e atype;
+	int rate;
+	int channels;
+
+	if (0 != sttd_engine_get_audio_format(&atype, &rate, &channels)) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to get audio format of engine."); 
+		return STTD_ERROR_OPERATION_FAILED;
+	}
+
+	sttd_recorder_channel	sttchannel;
+	sttd_recorder_audio_type	sttatype;
+
+	switch (atype) {
+	case STTP_AUDIO_TYPE_PCM_S16_LE:	sttatype = STTD_RECORDER_PCM_S16;	break;
+	case STTP_AUDIO_TYPE_PCM_U8:		sttatype = STTD_RECORDER_PCM_U8;	break;
+	case STTP_AUDIO_TYPE_AMR:		sttatype = STTD_RECORDER_AMR;		break;
+	default:	
+		/* engine error */
+		sttd_engine_agent_unload_current_engine();
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Invalid Audio Type"); 
+		return STTD_ERROR_OPERATION_FAILED;
+		break;
+	}
+
+	switch (channels) {
+	case 1:		sttchannel = STTD_RECORDER_CHANNEL_MONO;	break;
+	case 2:		sttchannel = STTD_RECORDER_CHANNEL_STEREO;	break;
+	default:	sttchannel = STTD_RECORDER_CHANNEL_MONO;	break;
+	}
+
+	if (0 != sttd_recorder_set(sttatype, sttchannel, rate, 60, audio_recorder_callback)) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to set recorder"); 
+		return STTD_ERROR_OPERATION_FAILED;
+	}
+	
+	SLOG(LOG_DEBUG, TAG_STTD, "[Server] audio type(%d), channel(%d)", (int)atype, (int)sttchannel); 
+
+	return STTD_ERROR_NONE;
+}
+
+int __get_capability(sttd_capability_s* capability)
+{
+	memset(capability, 0, sizeof(sttd_capability_s));
+
+	if (0 != sttd_engine_get_option_supported(&capability->silence, &capability->profanity, &capability->punctuation)) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to get engine options supported"); 
+		return STTD_ERROR_OPERATION_FAILED;
+	}
+
+	if (0 != sttd_engine_is_partial_result_supported(&capability->partial_result)) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to get partial result supported"); 
+		return STTD_ERROR_OPERATION_FAILED;
+	}
+
+	if (0 != sttd_engine_get_default_lang(&capability->default_lang)) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to get default language"); 
+		return STTD_ERROR_OPERATION_FAILED;
+	}
+
+	if (0 != sttd_engine_supported_langs(&capability->lang_list)) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to get supported languages"); 
+		sttd_server_release_capability(capability);
+		return STTD_ERROR_OPERATION_FAILED;
+	}
+
+	capability->valid = true;
+
+	return STTD_ERROR_NONE;
+}
+
+void sttd_server_release_capability(sttd_capability_s* capability)
+{
+	if (NULL != capability->default_lang) {
+		free(capability->default_lang);
+		capability->default_lang = NULL;
+	}
+
+	GList* iter = g_list_first(capability->lang_list);
+	while (NULL != iter) {
+		if (NULL != iter->data)
+			free(iter->data);
+		iter = g_list_next(iter);
+	}
+
+	g_list_free(capability->lang_list);
+	capability->lang_list = NULL;
+}
+
+void __notify_engine_ready(int result)
+{
+	sttd_capability_s capability;
+	memset(&capability, 0, sizeof(sttd_capability_s));
+
+	if (0 == result) 
+		result = __set_recorder_by_engine();
+
+	/* capability is only cache of client, so engine is ready without it */
+	if (0 == result && 0 != __get_capability(&capability))
+		SLOG(LOG_WARN, TAG_STTD, "[Server WARNING] Engine is ready without capability"); 
+
+	/* notify clients waiting for engine */
+	int* client_list = NULL;
+	int client_count = 0;
+
+	if (0 == sttd_client_get_list(&client_list, &client_count) && NULL != client_list) {
+		int i = 0;
+		app_state_e state;
+
+		for (i = 0;i < client_count;i++) {
+			if (0 != sttd_client_get_state(client_list[i], &state) || APP_STATE_CREATED != state)
+				continue;
+
+			/* one-shot client gets reply of its request instead */
+			if (NULL != __find_once_request(client_list[i]))
+				continue;
+
+			if (0 == result)
+				sttd_client_set_state(client_list[i], APP_STATE_READY);
+
+			if (0 != sttdc_send_engine_ready(client_list[i], result, capability.valid ? &capability : NULL, 
+							 sttd_server_client_reply_callback, NULL)) {
+				SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to send engine ready. uid(%d) should be removed.", client_list[i]); 
+				sttd_server_finalize(client_list[i]);
+			} else if (0 != result) {
+				sttd_client_delete(client_list[i]);
+			}
+		}
+
+		free(client_list);
+	}
+
+	__start_once_requests(result, &capability);
+
+	__add_waiting_settings(result);
+
+	sttd_server_release_capability(&capability);
+
+	/* Preloaded engine stays until the first client leaves */
+	if (0 != result || STTD_RESIDENCY_ON_DEMAND == g_residency)
+		__release_engine();
+
+	__start_idle_reclaim();
+}
+
+void __notify_engine_changed()
+{
+	sttd_capability_s capability;
+	bool valid = (0 == __get_capability(&capability));
+
+	int* client_list = NULL;
+	int client_count = 0;
+
+	if (0 == sttd_client_get_list(&client_list, &client_count) && NULL != client_list) {
+		int i = 0;
+		app_state_e state;
+
+		for (i = 0;i < client_count;i++) {
+			/* client waiting for engine gets capability with engine ready */
+			if (0 != sttd_client_get_state(client_list[i], &state) || APP_STATE_CREATED == state)
+				continue;
+
+			if (0 != sttdc_send_engine_changed(client_list[i], valid ? &capability : NULL)) {
+				SLOG(LOG_WARN, TAG_STTD, "[Server WARNING] Fail to send engine changed : uid(%d)", client_list[i]); 
+			}
+		}
+
+		free(client_list);
+	}
+
+	if (true == valid)
+		sttd_server_release_capability(&capability);
+}
+
+void __engine_load_thread(void *data, Ecore_Thread *thread)
+{
+	int* result = (int*)data;
+
+	*result = sttd_engine_agent_load_current_engine();
+}
+
+void __engine_load_end(void *data, Ecore_Thread *thread)
+{
+	int* result = (int*)data;
+	int ret = *result;
+
+	free(result);
+
+	g_engine_loading = false;
+
+	SLOG(LOG_DEBUG, TAG_STTD, "[Server] Engine loading is finished : result(%d)", ret); 
+
+	__notify_engine_ready(ret);
+}
+
+void __engine_load_cancel(void *data, Ecore_Thread *thread)
+{
+	SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Engine loading is cancelled"); 
 
-	SLOG(LOG_DEBUG, TAG_STTD, "=====");
-	SLOG(LOG_DEBUG, TAG_STTD, "  ");
+	*(int*)data = STTD_ERROR_OPERATION_FAILED;
 
-	return;
+	__engine_load_end(data, thread);
 }
 
-void sttd_server_partial_result_callback(sttp_result_event_e event, const char* data, void *user_data)
+int __load_engine_async()
 {
-	SLOG(LOG_DEBUG, TAG_STTD, "===== Partial Result Callback");
+	/* de-duplicate loading request */
+	if (true == g_engine_loading) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Server] Engine is already loading"); 
+		return STTD_ERROR_NONE;
+	}
 
-	/* check uid */
-	int *uid = (int*)user_data;
+	int* result = (int*)malloc(sizeof(int));
+	if (NULL == result) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to allocate memory"); 
+		return STTD_ERROR_OUT_OF_MEMORY;
+	}
 
-	SLOG(LOG_DEBUG, TAG_STTD, "[Server] uid (%d), event(%d)", uid, event); 
+	/* free on end callback */
+	*result = STTD_ERROR_OPERATION_FAILED;
 
-	app_state_e state;
-	if (0 != sttd_client_get_state(*uid, &state)) {
-		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] uid is NOT valid "); 
-		SLOG(LOG_DEBUG, TAG_STTD, "=====");
-		SLOG(LOG_DEBUG, TAG_STTD, "  ");
-		return;
-	}
+	g_engine_loading = true;
 
-	/* send result to client */
-	if (STTP_RESULT_EVENT_SUCCESS == event && NULL != data) {
-		if (0 != sttdc_send_partial_result(*uid, data)) {
-			SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to send partial result"); 	
-		}
-	} 
+	SLOG(LOG_DEBUG, TAG_STTD, "[Server] Start to load engine in background"); 
 
-	SLOG(LOG_DEBUG, TAG_STTD, "=====");
-	SLOG(LOG_DEBUG, TAG_STTD, "  ");
+	if (NULL == ecore_thread_run(__engine_load_thread, __engine_load_end, __engine_load_cancel, result)) {
+		/* ecore calls cancel callback when thread is not created */
+		SLOG(LOG_WARN, TAG_STTD, "[Server WARNING] Fail to run engine load thread"); 
+	}
+
+	return STTD_ERROR_NONE;
 }
 
-void sttd_server_silence_dectection_callback(void *user_param)
+/*
+* Daemon function
+*/
+
+void __engine_scan_thread(void *data, Ecore_Thread *thread)
 {
-	SLOG(LOG_DEBUG, TAG_STTD, "===== Silence Detection Callback");
+	int* result = (int*)data;
 
-	int uid = sttd_client_get_current_recording();
+	/* dlopen of every engine is the most expensive part of startup */
+	*result = sttd_engine_agent_initialize_current_engine();
+}
 
-	app_state_e state;
-	if (0 != sttd_client_get_state(uid, &state)) {
-		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] uid is not valid "); 
-		return;
-	}
+void __engine_scan_end(void *data, Ecore_Thread *thread)
+{
+	int* result = (int*)data;
+	int ret = *result;
 
-	if (APP_STATE_RECORDING != state) {
-		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Current state is not recording"); 
-		return;
+	free(result);
+
+	if (0 != ret) {
+		SLOG(LOG_WARN, TAG_STTD, "[Server WARNING] There is No STT-Engine !!!!!"); 
+		g_is_engine = false;
+	} else {
+		g_is_engine = true;
 	}
 
-	ecore_timer_add(0, __stop_by_silence, NULL);
+	sttd_main_mark_startup(STTD_STARTUP_ENGINE_SCAN);
 
-	SLOG(LOG_DEBUG, TAG_STTD, "=====");
-	SLOG(LOG_DEBUG, TAG_STTD, "  ");
+	/* handle requests which have waited for startup */
+	sttd_main_mark_startup(STTD_STARTUP_READY);
+	sttd_dbus_set_ready();
 
-	return;
+	/* load engine in background by residency policy */
+	sttd_preload_engine();
 }
 
-/*
-* Daemon function
-*/
+void __engine_scan_cancel(void *data, Ecore_Thread *thread)
+{
+	SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Engine scan is cancelled"); 
+
+	*(int*)data = STTD_ERROR_OPERATION_FAILED;
+
+	__engine_scan_end(data, thread);
+}
 
 int sttd_initialize()
 {
@@ -228,6 +1450,8 @@ int sttd_initialize()
 		SLOG(LOG_ERROR, TAG_STTD, "[Server WARNING] Fail to initialize config.");
 	}
 
+	sttd_main_mark_startup(STTD_STARTUP_CONFIG);
+
 	/* recoder init */
 	ret = sttd_recorder_init();
 	if (0 != ret) {
@@ -235,6 +1459,18 @@ int sttd_initialize()
 		return ret;
 	}
 
+	sttd_main_mark_startup(STTD_STARTUP_RECORDER);
+
+	/* engine call watchdog */
+	int call_deadline = 0;
+	int load_deadline = 0;
+	sttd_config_get_engine_call_deadline(&call_deadline);
+	sttd_config_get_engine_load_deadline(&load_deadline);
+
+	if (0 != sttd_engine_monitor_initialize(call_deadline, load_deadline, __engine_call_overdue, __engine_call_recovered)) {
+		SLOG(LOG_WARN, TAG_STTD, "[Server WARNING] Fail to start engine watchdog"); 
+	}
+
 	/* Engine Agent initialize */
 	ret = sttd_engine_agent_init(sttd_server_recognition_result_callback, sttd_server_partial_result_callback, 
 				sttd_server_silence_dectection_callback);
@@ -242,12 +1478,34 @@ int sttd_initialize()
 		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to engine agent initialize : result(%d)", ret);
 		return ret;
 	}
-	
-	if (0 != sttd_engine_agent_initialize_current_engine()) {
-		SLOG(LOG_WARN, TAG_STTD, "[Server WARNING] There is No STT-Engine !!!!!"); 
-		g_is_engine = false;
-	} else {
-		g_is_engine = true;
+
+	/* engine residency */
+	if (0 != sttd_config_get_engine_residency(&g_residency))
+		g_residency = STTD_RESIDENCY_ON_DEMAND;
+
+	if (0 != sttd_config_get_engine_unload_delay(&g_unload_delay))
+		g_unload_delay = 0;
+
+	if (0 != sttd_config_get_idle_reclaim_delay(&g_reclaim_delay))
+		g_reclaim_delay = 0;
+
+	SLOG(LOG_DEBUG, TAG_STTD, "[Server] Engine residency(%d), unload delay(%d sec), idle reclaim(%d sec)", 
+		g_residency, g_unload_delay, g_reclaim_delay); 
+
+	/* Engine scan runs while main loop answers hello. 
+	   Engine agent is not touched in main loop until dbus layer is ready. */
+	int* result = (int*)malloc(sizeof(int));
+	if (NULL == result) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to allocate memory"); 
+		return STTD_ERROR_OUT_OF_MEMORY;
+	}
+
+	/* free on end callback */
+	*result = STTD_ERROR_OPERATION_FAILED;
+
+	if (NULL == ecore_thread_run(__engine_scan_thread, __engine_scan_end, __engine_scan_cancel, result)) {
+		/* ecore calls cancel callback when thread is not created */
+		SLOG(LOG_WARN, TAG_STTD, "[Server WARNING] Fail to run engine scan thread"); 
 	}
 
 	SLOG(LOG_DEBUG, TAG_STTD, "[Server SUCCESS] initialize"); 
@@ -255,8 +1513,23 @@ int sttd_initialize()
 	return 0;
 }
 
+int sttd_preload_engine()
+{
+	if (false == g_is_engine || STTD_RESIDENCY_ON_DEMAND == g_residency)
+		return 0;
+
+	if (0 != __load_engine_async()) {
+		SLOG(LOG_WARN, TAG_STTD, "[Server WARNING] Fail to preload current engine"); 
+		return -1;
+	}
+
+	return 0;
+}
+
 Eina_Bool sttd_cleanup_client(void *data)
 {
+	/* Normally, client is removed by NameOwnerChanged of bus. 
+	   This is safety net for client which is gone before its name is watched. */
 	int* client_list = NULL;
 	int client_count = 0;
 
@@ -266,19 +1539,19 @@ Eina_Bool sttd_cleanup_client(void *data)
 	if (NULL == client_list)
 		return EINA_TRUE;
 
-	int result;
 	int i = 0;
 
 	SLOG(LOG_DEBUG, TAG_STTD, "===== Clean up client ");
 
 	for (i = 0;i < client_count;i++) {
-		result = sttdc_send_hello(client_list[i]);
+		int pid = sttd_client_get_pid(client_list[i]);
+		if (0 >= pid)
+			continue;
 
-		if (0 == result) {
+		/* no round trip to client */
+		if (0 != kill(pid, 0) && ESRCH == errno) {
 			SLOG(LOG_DEBUG, TAG_STTD, "[Server] uid(%d) should be removed.", client_list[i]); 
 			sttd_server_finalize(client_list[i]);
-		} else if (-1 == result) {
-			SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Hello result has error"); 
 		}
 	}
 
@@ -290,11 +1563,41 @@ Eina_Bool sttd_cleanup_client(void *data)
 	return EINA_TRUE;
 }
 
+void sttd_server_client_reply_callback(int uid, int result, void* user_data)
+{
+	if (0 != result) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] uid(%d) does not reply : result(%d). Remove client", uid, result); 
+		sttd_server_finalize(uid);
+	}
+}
+
+int sttd_server_disconnect_client(int pid)
+{
+	int uid = sttd_client_get_uid_by_pid(pid);
+
+	if (-1 == uid) {
+		/* client has already finalized */
+		sttd_dbus_unwatch_client(pid);
+		return STTD_ERROR_NONE;
+	}
+
+	while (-1 != uid) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Server] uid(%d) of pid(%d) should be removed.", uid, pid); 
+
+		if (0 != sttd_server_finalize(uid)) 
+			break;
+
+		uid = sttd_client_get_uid_by_pid(pid);
+	}
+
+	return STTD_ERROR_NONE;
+}
+
 /*
 * STT Server Functions for Client
 */
 
-int sttd_server_initialize(int pid, int uid, bool* silence, bool* profanity, bool* punctuation)
+int sttd_server_initialize(int pid, int uid, sttd_capability_s* capability, bool* loading)
 {
 	if (false == g_is_engine) {
 		if (0 != sttd_engine_agent_initialize_current_engine()) {
@@ -313,51 +1616,43 @@ int sttd_server_initialize(int pid, int uid, bool* silence, bool* profanity, boo
 		return STTD_ERROR_INVALID_PARAMETER;
 	}
 	
-	/* load if engine is unloaded */
-	if (0 == sttd_client_get_ref_count()) {
-		if (0 != sttd_engine_agent_load_current_engine()) {
-			SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to load current engine"); 
+	/* cancel pending unload */
+	__cancel_engine_unload();
+
+	/* load engine in background, if engine is unloaded */
+	if (true == g_engine_loading || false == sttd_engine_agent_is_loaded()) {
+		if (0 != sttd_client_add(pid, uid)) {
+			SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to add client info"); 
 			return STTD_ERROR_OPERATION_FAILED;
 		}
-	}
 
-	/* initialize recorder using audio format from engine */
-	sttp_audio_type_e atype;
-	int rate;
-	int channels;
+		if (0 != sttd_dbus_watch_client(pid)) {
+			sttd_client_delete(uid);
+			return STTD_ERROR_OPERATION_FAILED;
+		}
 
-	if (0 != sttd_engine_get_audio_format(&atype, &rate, &channels)) {
-		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to get audio format of engine."); 
-		return STTD_ERROR_OPERATION_FAILED;
-	}
+		/* client is NOT ready until engine is loaded */
+		sttd_client_set_state(uid, APP_STATE_CREATED);
 
-	sttd_recorder_channel	sttchannel;
-	sttd_recorder_audio_type	sttatype;
+		if (0 != __load_engine_async()) {
+			sttd_client_delete(uid);
+			if (-1 == sttd_client_get_uid_by_pid(pid))
+				sttd_dbus_unwatch_client(pid);
+			return STTD_ERROR_OPERATION_FAILED;
+		}
 
-	switch (atype) {
-	case STTP_AUDIO_TYPE_PCM_S16_LE:	sttatype = STTD_RECORDER_PCM_S16;	break;
-	case STTP_AUDIO_TYPE_PCM_U8:		sttatype = STTD_RECORDER_PCM_U8;	break;
-	case STTP_AUDIO_TYPE_AMR:		sttatype = STTD_RECORDER_AMR;		break;
-	default:	
-		/* engine error */
-		sttd_engine_agent_unload_current_engine();
-		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Invalid Audio Type"); 
-		return STTD_ERROR_OPERATION_FAILED;
-		break;
-	}
+		*loading = true;
 
-	switch (sttchannel) {
-	case 1:		sttchannel = STTD_RECORDER_CHANNEL_MONO;	break;
-	case 2:		sttchannel = STTD_RECORDER_CHANNEL_STEREO;	break;
-	default:	sttchannel = STTD_RECORDER_CHANNEL_MONO;	break;
+		SLOG(LOG_DEBUG, TAG_STTD, "[Server] Engine is loading. uid(%d) will be notified", uid); 
+
+		return STTD_ERROR_NONE;
 	}
 
-	if (0 != sttd_recorder_set(sttatype, sttchannel, rate, 60, audio_recorder_callback)) {
-		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to set recorder"); 
+	*loading = false;
+
+	if (0 != __set_recorder_by_engine()) {
 		return STTD_ERROR_OPERATION_FAILED;
 	}
-	
-	SLOG(LOG_DEBUG, TAG_STTD, "[Server] audio type(%d), channel(%d)", (int)atype, (int)sttchannel); 
 
 	/* Add client information to client manager */
 	if (0 != sttd_client_add(pid, uid)) {
@@ -365,11 +1660,18 @@ int sttd_server_initialize(int pid, int uid, bool* silence, bool* profanity, boo
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 
-	if (0 != sttd_engine_get_option_supported(silence, profanity, punctuation)) {
-		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to get engine options supported"); 
+	/* client is removed as soon as it leaves bus */
+	if (0 != sttd_dbus_watch_client(pid)) {
+		sttd_client_delete(uid);
+		__release_engine();
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 
+	/* client without capability asks it again */
+	if (0 != __get_capability(capability)) {
+		SLOG(LOG_WARN, TAG_STTD, "[Server WARNING] Fail to get capability. Reply without it"); 
+	}
+
 	SLOG(LOG_DEBUG, TAG_STTD, "[Server Success] Initialize"); 
 
 	return STTD_ERROR_NONE;
@@ -384,28 +1686,46 @@ int sttd_server_finalize(const int uid)
 		return STTD_ERROR_INVALID_PARAMETER;
 	}
 
+	/* drop queued request */
+	__remove_start_request(uid);
+
+	/* one-shot request waiting for engine */
+	once_request_s* once = __find_once_request(uid);
+	if (NULL != once) {
+		__free_once_request(once);
+		sttd_dbus_send_held_reply(uid, STTD_ERROR_OPERATION_FAILED);
+	}
+
+	if (NULL != g_prewarm && uid == g_prewarm->uid)
+		__drop_prewarm();
+
 	/* release recorder */
 	app_state_e appstate;
 	sttd_client_get_state(uid, &appstate);
 
 	if (APP_STATE_RECORDING == appstate || APP_STATE_PROCESSING == appstate) {
-		sttd_recorder_cancel();
-		sttd_engine_recognize_cancel();
+		/* recorder belongs to recording client only */
+		if (APP_STATE_RECORDING == appstate)
+			sttd_recorder_cancel();
+		sttd_engine_recognize_cancel(uid);
 	}
-	
+
 	/* Remove client information */
+	int pid = sttd_client_get_pid(uid);
+
 	if (0 != sttd_client_delete(uid)) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to delete client"); 
 	}
 
+	if (-1 == sttd_client_get_uid_by_pid(pid))
+		sttd_dbus_unwatch_client(pid);
+
 	/* unload engine, if ref count of client is 0 */
-	if (0 == sttd_client_get_ref_count()) {
-		if (0 != sttd_engine_agent_unload_current_engine()) {
-			SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to unload current engine"); 
-		} else {
-			SLOG(LOG_DEBUG, TAG_STTD, "[Server SUCCESS] unload current engine"); 
-		}
-	}
+	__release_engine();
+
+	__schedule_admission();
+
+	__start_idle_reclaim();
 	
 	return STTD_ERROR_NONE;
 }
@@ -478,6 +1798,8 @@ int sttd_server_is_partial_result_supported(int uid, int* partial_result)
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 
+	*partial_result = (int)temp;
+
 	SLOG(LOG_DEBUG, TAG_STTD, "[Server SUCCESS] Partial result supporting is %s", temp ? "true" : "false"); 
 
 	return STTD_ERROR_NONE;
@@ -513,21 +1835,22 @@ int sttd_server_get_audio_volume( const int uid, float* current_volume)
 	return STTD_ERROR_NONE;
 }
 
-Eina_Bool __check_recording_state(void *data)
-{	
-	/* current uid */
-	int uid = sttd_client_get_current_recording();
-	if (-1 == uid)
-		return EINA_FALSE;
-
-	app_state_e state;
-	if (0 != sttdc_send_get_state(uid, (int*)&state)) {
+void __recording_state_checked(int uid, int result, void* user_data)
+{
+	if (-1 == result) {
 		/* client is removed */
 		SLOG(LOG_DEBUG, TAG_STTD, "[Server] uid(%d) should be removed.", uid); 
 		sttd_server_finalize(uid);
-		return EINA_FALSE;
+		return;
 	}
 
+	/* recording can be finished while waiting reply */
+	app_state_e daemon_state;
+	if (0 != sttd_client_get_state(uid, &daemon_state) || APP_STATE_RECORDING != daemon_state) 
+		return;
+
+	app_state_e state = (app_state_e)result;
+
 	if (APP_STATE_READY == state) {
 		/* Cancel stt */
 		SLOG(LOG_DEBUG, TAG_STTD, "[Server] The state of uid(%d) is 'Ready'. The daemon should cancel recording", uid); 
@@ -536,19 +1859,37 @@ Eina_Bool __check_recording_state(void *data)
 		/* Cancel stt and send change state */
 		SLOG(LOG_DEBUG, TAG_STTD, "[Server] The state of uid(%d) is 'Processing'. The daemon should cancel recording", uid); 
 		sttd_server_cancel(uid);
-		sttdc_send_set_state(uid, (int)APP_STATE_READY);
+		sttdc_send_set_state(uid, (int)APP_STATE_READY, NULL, NULL);
 	} else {
 		/* Normal state */
 		SLOG(LOG_DEBUG, TAG_STTD, "[Server] The states of daemon and client are identical"); 
-		return EINA_TRUE;
 	}
+}
 
-	return EINA_FALSE;
+Eina_Bool __check_recording_state(void *data)
+{	
+	/* current uid */
+	int uid = sttd_client_get_current_recording();
+	if (-1 == uid)
+		return EINA_FALSE;
+
+	/* state of client is compared when it replies */
+	if (0 != sttdc_send_get_state(uid, __recording_state_checked, NULL)) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Server] uid(%d) should be removed.", uid); 
+		sttd_server_finalize(uid);
+		return EINA_FALSE;
+	}
+
+	return EINA_TRUE;
 }
 
 int sttd_server_start(const int uid, const char* lang, const char* recognition_type, 
-		      int profanity, int punctuation, int silence)
+		      int profanity, int punctuation, int silence, int priority, int wait_timeout, 
+		      int partial_interval, int* queue_position)
 {
+	if (NULL != queue_position)
+		*queue_position = 0;
+
 	/* check if uid is valid */
 	app_state_e state;
 	if (0 != sttd_client_get_state(uid, &state)) {
@@ -557,21 +1898,87 @@ int sttd_server_start(const int uid, const char* lang, const char* recognition_t
 	}
 
 	/* check uid state */
-	if (APP_STATE_READY != state) {
+	if (APP_STATE_READY != state || NULL != __find_start_request(uid)) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] sttd_server_start : current state is not ready"); 
 		return STTD_ERROR_INVALID_STATE;
 	}
 
-	if (0 < sttd_client_get_current_recording()) {
-		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Current STT Engine is busy because of recording");
+	sttd_client_set_partial_interval(uid, (0 < partial_interval) ? partial_interval : 0);
+
+	/* queued requests go first */
+	if (NULL == g_start_queue && true == __can_start()) 
+		return __server_start(uid, lang, recognition_type, profanity, punctuation, silence);
+
+	if (0 >= wait_timeout) {
+		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Current STT Engine is busy");
 		return STTD_ERROR_RECORDER_BUSY;
 	}
 
-	if (0 < sttd_client_get_current_thinking()) {
-		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Current STT Engine is busy because of thinking");
-		return STTD_ERROR_RECORDER_BUSY;
+	int position = __enqueue_start_request(uid, lang, recognition_type, profanity, punctuation, silence, priority, wait_timeout);
+	if (0 > position) 
+		return STTD_ERROR_OUT_OF_MEMORY;
+
+	SLOG(LOG_DEBUG, TAG_STTD, "[Server] Queue start request : uid(%d), priority(%d), wait(%d), position(%d)", 
+		uid, priority, wait_timeout, position); 
+
+	if (NULL != queue_position)
+		*queue_position = position;
+
+	/* positions of lower priority requests are changed */
+	__notify_queue_position();
+
+	return STTD_ERROR_NONE;
+}
+
+int sttd_server_recognize_once(int pid, int uid, const char* lang, const char* recognition_type, 
+			       int profanity, int punctuation, int silence, bool* deferred)
+{
+	*deferred = false;
+
+	sttd_capability_s capability;
+	memset(&capability, 0, sizeof(sttd_capability_s));
+	bool loading = false;
+
+	int ret = sttd_server_initialize(pid, uid, &capability, &loading);
+	if (0 != ret) 
+		return ret;
+
+	/* main loop does not wait for engine. One-shot starts when engine is ready */
+	if (true == loading) {
+		once_request_s* req = (once_request_s*)calloc(1, sizeof(once_request_s));
+		if (NULL == req) {
+			SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to allocate memory"); 
+			sttd_server_finalize(uid);
+			return STTD_ERROR_OUT_OF_MEMORY;
+		}
+
+		req->uid = uid;
+		req->lang = strdup(lang);
+		req->type = strdup(recognition_type);
+		req->profanity = profanity;
+		req->punctuation = punctuation;
+		req->silence = silence;
+
+		g_once_list = g_list_append(g_once_list, req);
+
+		sttd_client_set_once(uid, true);
+
+		*deferred = true;
+
+		SLOG(LOG_DEBUG, TAG_STTD, "[Server] One-shot waits for engine : uid(%d)", uid); 
+
+		return STTD_ERROR_NONE;
 	}
 
+	ret = __start_once(uid, lang, recognition_type, profanity, punctuation, silence, capability.silence);
+
+	sttd_server_release_capability(&capability);
+
+	return ret;
+}
+
+int __server_start(int uid, const char* lang, const char* recognition_type, int profanity, int punctuation, int silence)
+{
 	/* check if engine use network */
 	if (true == sttd_engine_agent_need_network()) {
 		if (false == sttd_network_is_connected()) {
@@ -580,31 +1987,47 @@ int sttd_server_start(const int uid, const char* lang, const char* recognition_t
 		}
 	}
 
-	/* engine start recognition */
-	int* user_data;
-	user_data = (int*)malloc( sizeof(int) * 1);
-	
-	/* free on result callback */
-	*user_data = uid;
+	__stop_idle_reclaim();
 
-	SLOG(LOG_DEBUG, TAG_STTD, "[Server] start : uid(%d), lang(%s), recog_type(%s)", *user_data, lang, recognition_type ); 
+	int ret;
 
-	int ret = sttd_engine_recognize_start((char*)lang, recognition_type, profanity, punctuation, silence, (void*)user_data);
-	if (0 != ret) {
-		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to start recognition : result(%d)", ret); 
-		return STTD_ERROR_OPERATION_FAILED;
+	/* engine started by prewarm */
+	int* user_data = __take_prewarm(uid, lang, recognition_type, profanity, punctuation, silence);
+	if (NULL != user_data) {
+		SLOG(LOG_DEBUG, TAG_STTD, "[Server] start : uid(%d), lang(%s), recog_type(%s), engine is started by prewarm", uid, lang, recognition_type); 
+	} else {
+		/* engine start recognition */
+		user_data = (int*)malloc( sizeof(int) * 1);
+		
+		/* free on result callback */
+		*user_data = uid;
+
+		SLOG(LOG_DEBUG, TAG_STTD, "[Server] start : uid(%d), lang(%s), recog_type(%s)", *user_data, lang, recognition_type ); 
+
+		ret = sttd_engine_recognize_start(uid, (char*)lang, recognition_type, profanity, punctuation, silence, (void*)user_data);
+		if (0 != ret) {
+			SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to start recognition : result(%d)", ret); 
+			free(user_data);
+			sttd_recorder_unprepare();
+			if (STTD_ERROR_RECORDER_BUSY == ret)
+				return STTD_ERROR_RECORDER_BUSY;
+			return STTD_ERROR_OPERATION_FAILED;
+		}
 	}
 
 	/* recorder start */
 	ret = sttd_recorder_start();
 	if (0 != ret) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to start recorder : result(%d)", ret); 
-		sttd_engine_recognize_cancel();
+		sttd_engine_recognize_cancel(uid);
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 
 	SLOG(LOG_DEBUG, TAG_STTD, "[Server] start recording"); 
 
+	/* first partial result of session is sent as full text */
+	sttd_client_reset_partial_result(uid);
+
 	/* change uid state */
 	sttd_client_set_state(uid, APP_STATE_RECORDING);
 
@@ -616,13 +2039,17 @@ int sttd_server_start(const int uid, const char* lang, const char* recognition_t
 
 Eina_Bool __time_out_for_processing(void *data)
 {	
-	/* current uid */
-	int uid = sttd_client_get_current_thinking();
-	if (-1 == uid)
+	/* uid of timer : other clients can be thinking with multi session engine */
+	int uid = (int)(intptr_t)data;
+
+	app_state_e state;
+	if (0 != sttd_client_get_state(uid, &state) || APP_STATE_PROCESSING != state)
 		return EINA_FALSE;
 
+	sttd_cliet_set_timer(uid, NULL);
+
 	/* Cancel engine */
-	int ret = sttd_engine_recognize_cancel();
+	int ret = sttd_engine_recognize_cancel(uid);
 	if (0 != ret) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to cancel : result(%d)", ret); 
 	}
@@ -640,6 +2067,12 @@ Eina_Bool __time_out_for_processing(void *data)
 	/* Change uid state */
 	sttd_client_set_state(uid, APP_STATE_READY);
 
+	__finish_once(uid);
+
+	__schedule_admission();
+
+	__start_idle_reclaim();
+
 	return EINA_FALSE;
 }
 
@@ -663,10 +2096,12 @@ int sttd_server_stop(const int uid)
 	sttd_recorder_stop();
 
 	/* stop engine recognition */
-	int ret = sttd_engine_recognize_stop();
+	int ret = sttd_engine_recognize_stop(uid);
 	if (0 != ret) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to stop : result(%d)", ret); 
 		sttd_client_set_state(uid, APP_STATE_READY);		
+		__finish_once(uid);
+		__schedule_admission();
 	
 		return STTD_ERROR_OPERATION_FAILED;
 	}
@@ -680,9 +2115,12 @@ int sttd_server_stop(const int uid)
 	/* change uid state */
 	sttd_client_set_state(uid, APP_STATE_PROCESSING);
 
-	timer = ecore_timer_add(g_state_check_time, __time_out_for_processing, NULL);
+	timer = ecore_timer_add(g_state_check_time, __time_out_for_processing, (void*)(intptr_t)uid);
 	sttd_cliet_set_timer(uid, timer);
 
+	/* recorder is free for next session */
+	__schedule_admission();
+
 	return STTD_ERROR_NONE;
 }
 
@@ -695,6 +2133,12 @@ int sttd_server_cancel(const int uid)
 		return STTD_ERROR_INVALID_PARAMETER;
 	}
 
+	/* cancel request waiting in queue */
+	if (NULL != __find_start_request(uid)) {
+		__remove_start_request(uid);
+		return STTD_ERROR_NONE;
+	}
+
 	/* check uid state */ 
 	if (APP_STATE_READY == state) {
 		SLOG(LOG_WARN, TAG_STTD, "[Server WARNING] Current state is ready"); 
@@ -706,12 +2150,14 @@ int sttd_server_cancel(const int uid)
 		sttd_recorder_cancel();
 
 	/* cancel engine recognition */
-	int ret = sttd_engine_recognize_cancel();
+	int ret = sttd_engine_recognize_cancel(uid);
 	if (0 != ret) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to cancel : result(%d)", ret); 
 		return STTD_ERROR_OPERATION_FAILED;
 	}
 
+	sttd_client_reset_partial_result(uid);
+
 	Ecore_Timer* timer;
 	sttd_cliet_get_timer(uid, &timer);
 	ecore_timer_del(timer);
@@ -719,6 +2165,12 @@ int sttd_server_cancel(const int uid)
 	/* change uid state */
 	sttd_client_set_state(uid, APP_STATE_READY);
 
+	__finish_once(uid);
+
+	__schedule_admission();
+
+	__start_idle_reclaim();
+
 	return STTD_ERROR_NONE;
 }
 
@@ -727,8 +2179,10 @@ int sttd_server_cancel(const int uid)
 * STT Server Functions for setting
 *******************************************************************************************/
 
-int sttd_server_setting_initialize(int pid)
+int sttd_server_setting_initialize(int pid, bool* deferred)
 {
+	*deferred = false;
+
 	if (false == g_is_engine) {
 		if (0 != sttd_engine_agent_initialize_current_engine()) {
 			SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] No Engine"); 
@@ -745,12 +2199,23 @@ int sttd_server_setting_initialize(int pid)
 		return STTD_ERROR_INVALID_PARAMETER;
 	}
 
-	/* load if engine is unloaded */
-	if (0 == sttd_client_get_ref_count()) {
-		if (0 != sttd_engine_agent_load_current_engine()) {
-			SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to load current engine"); 
+	/* cancel pending unload */
+	__cancel_engine_unload();
+
+	/* setting client needs loaded engine. It is added when engine is ready */
+	if (true == g_engine_loading || false == sttd_engine_agent_is_loaded()) {
+		if (0 != __load_engine_async()) {
 			return STTD_ERROR_OPERATION_FAILED;
 		}
+
+		if (NULL == g_list_find(g_setting_wait_list, GINT_TO_POINTER(pid)))
+			g_setting_wait_list = g_list_append(g_setting_wait_list, GINT_TO_POINTER(pid));
+
+		*deferred = true;
+
+		SLOG(LOG_DEBUG, TAG_STTD, "[Server] Engine is loading. Setting pid(%d) waits for it", pid); 
+
+		return STTD_ERROR_NONE;
 	}
 
 	/* Add setting client information to client manager (For internal use) */
@@ -764,19 +2229,20 @@ int sttd_server_setting_initialize(int pid)
 
 int sttd_server_setting_finalize(int pid)
 {
+	/* setting client waiting for engine */
+	if (NULL != g_list_find(g_setting_wait_list, GINT_TO_POINTER(pid))) {
+		g_setting_wait_list = g_list_remove(g_setting_wait_list, GINT_TO_POINTER(pid));
+		sttd_dbus_send_held_setting_reply(pid, STTD_ERROR_OPERATION_FAILED);
+		return STTD_ERROR_NONE;
+	}
+
 	/* Remove client information */
 	if (0 != sttd_setting_client_delete(pid)) {
 		SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to delete setting client"); 
 	}
 
 	/* unload engine, if ref count of client is 0 */
-	if (0 == sttd_client_get_ref_count()) {
-		if (0 != sttd_engine_agent_unload_current_engine()) {
-			SLOG(LOG_ERROR, TAG_STTD, "[Server ERROR] Fail to unload current engine"); 
-		} else {
-			SLOG(LOG_DEBUG, TAG_STTD, "[Server SUCCESS] unload current engine"); 
-		}
-	}
+	__release_engine();
 
 	return STTD_ERROR_NONE;
 }
@@ -839,6 +2305,9 @@ int sttd_server_setting_set_engine(int pid, const char* engine_id)
 		return STTD_ERROR_INVALID_PARAMETER;
 	}
 
+	/* engine started ahead belongs to current engine */
+	__drop_prewarm();
+
 	/* set engine */
 	int ret = sttd_engine_setting_set_engine(engine_id); 
 	if (0 != ret) {
@@ -846,6 +2315,8 @@ int sttd_server_setting_set_engine(int pid, const char* engine_id)
 		return ret;
 	}
 
+	__notify_engine_changed();
+
 	return STTD_ERROR_NONE;
 }
 
@@ -912,6 +2383,8 @@ int sttd_server_setting_set_default_language(int pid, const char* language)
 		return ret;
 	}	
 
+	__notify_engine_changed();
+
 	return STTD_ERROR_NONE;
 }
 
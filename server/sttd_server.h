@@ -26,15 +26,27 @@ extern "C" {
 /*
 * Daemon functions
 */
+/** Engine scan runs in background. Daemon gets ready and preloads engine when it is finished */
 int sttd_initialize();
 
 Eina_Bool sttd_cleanup_client(void *data);
 
+/** Remove all handles of client process which left bus */
+int sttd_server_disconnect_client(int pid);
+
+/** Reply callback of daemon-to-client call. Client is removed if it does not reply */
+void sttd_server_client_reply_callback(int uid, int result, void* user_data);
+
+int sttd_preload_engine();
+
 /*
 * API for client
 */
 
-int sttd_server_initialize(int pid, int uid, bool* silence, bool* profanity, bool* punctuation);
+/** capability is filled only if engine is loaded already. Release it with sttd_server_release_capability() */
+int sttd_server_initialize(int pid, int uid, sttd_capability_s* capability, bool* loading);
+
+void sttd_server_release_capability(sttd_capability_s* capability);
 
 int sttd_server_finalize(const int uid);
 
@@ -48,8 +60,22 @@ int sttd_server_is_partial_result_supported(int uid, int* partial_result);
 
 int sttd_server_get_audio_volume(const int uid, float* current_volume);
 
+/** If engine is busy and wait_timeout(msec) is positive, request is queued and queue_position is set.
+    Partial results are sent at most once per partial_interval(msec) */
 int sttd_server_start(const int uid, const char* lang, const char* recognition_type, 
-			int profanity, int punctuation, int silence);
+			int profanity, int punctuation, int silence, int priority, int wait_timeout, 
+			int partial_interval, int* queue_position);
+
+/** Prepare recorder and start engine ahead of start of uid. They are held for hold_ms(msec) */
+int sttd_server_prewarm(const int uid, const char* lang, const char* recognition_type, 
+			int profanity, int punctuation, int silence, int hold_ms);
+
+/** 
+* Register uid and start recognition. uid is removed when the session ends.
+* If engine is loading, deferred is set and start is done when engine is ready.
+*/
+int sttd_server_recognize_once(int pid, int uid, const char* lang, const char* recognition_type, 
+			       int profanity, int punctuation, int silence, bool* deferred);
 
 int sttd_server_stop(const int uid);
 
@@ -59,7 +85,8 @@ int sttd_server_cancel(const int uid);
 * API for setting
 */
 
-int sttd_server_setting_initialize(int pid);
+/** Reply is deferred while engine is loading. Setting client is added when engine is ready */
+int sttd_server_setting_initialize(int pid, bool* deferred);
 
 int sttd_server_setting_finalize(int pid);
 
@@ -525,6 +525,110 @@ typedef int (* sttpe_foreach_engine_settings)(sttpe_engine_setting_cb callback,
 */
 typedef int (* sttpe_set_engine_setting)(const char* key, const char* value);
 
+/**
+* @brief Releases caches of the engine while the engine is idle.
+*
+* @remark This function is optional. The daemon calls it after idle period without recognition 
+*	and the engine should be able to start recognition again without reloading.
+*
+* @return 0 on success, otherwise a negative error value
+* @retval #STTP_ERROR_NONE Successful
+* @retval #STTP_ERROR_INVALID_STATE Not initialized or in recognition processing
+*
+* @see sttpe_start()
+*/
+typedef int (* sttpe_shrink_memory)(void);
+
+/**
+* @brief Gets the number of recognition sessions which the engine can process at the same time.
+*
+* @remark This function is optional. If the engine returns more than 1, it should support 
+*	session functions and the daemon can start new recognition while others are processing.
+*
+* @param[out] count The number of sessions
+*
+* @return 0 on success, otherwise a negative error value
+* @retval #STTP_ERROR_NONE Successful
+* @retval #STTP_ERROR_INVALID_PARAMETER Invalid parameter
+* @retval #STTP_ERROR_INVALID_STATE Not initialized
+*
+* @see sttpe_session_start()
+*/
+typedef int (* sttpe_get_max_sessions)(int* count);
+
+/**
+* @brief Starts recognition in new session.
+*
+* @remark This function is optional. The result of session is given by sttpe_result_cb() with @a user_data 
+*	and the session is released after the result callback or cancel.
+*
+* @param[in] language A language. 
+* @param[in] type A recognition type. (e.g. #STTP_RECOGNITION_TYPE_FREE, #STTP_RECOGNITION_TYPE_WEB_SEARCH)
+* @param[in] user_data The user data to be passed to the callback functions of this session. 
+* @param[out] session The session handle
+*
+* @return 0 on success, otherwise a negative error value
+* @retval #STTP_ERROR_NONE Successful
+* @retval #STTP_ERROR_INVALID_PARAMETER Invalid parameter
+* @retval #STTP_ERROR_INVALID_STATE Invalid state or no more session
+* @retval #STTP_ERROR_INVALID_LANGUAGE Invalid language
+* @retval #STTP_ERROR_OPERATION_FAILED Operation failed
+* @retval #STTP_ERROR_OUT_OF_NETWORK Out of network
+*
+* @see sttpe_get_max_sessions()
+* @see sttpe_session_set_recording()
+* @see sttpe_session_stop()
+* @see sttpe_session_cancel()
+*/
+typedef int (* sttpe_session_start)(const char* language, const char* type, void* user_data, void** session);
+
+/**
+* @brief Sets recording data of the session.
+*
+* @remark This function should be returned immediately after recording data copy. 
+* 
+* @param[in] session The session handle
+* @param[in] data A recording data
+* @param[in] length A length of recording data
+*
+* @return 0 on success, otherwise a negative error value
+* @retval #STTP_ERROR_NONE Successful
+* @retval #STTP_ERROR_INVALID_PARAMETER Invalid parameter
+* @retval #STTP_ERROR_INVALID_STATE Invalid state
+*
+* @see sttpe_session_start()
+*/
+typedef int (* sttpe_session_set_recording)(void* session, const void* data, unsigned int length);
+
+/**
+* @brief Stops to set recording data of the session.
+*
+* @param[in] session The session handle
+*
+* @return 0 on success, otherwise a negative error value
+* @retval #STTP_ERROR_NONE Successful
+* @retval #STTP_ERROR_INVALID_STATE Invalid state
+* @retval #STTP_ERROR_OPERATION_FAILED Operation failed
+*
+* @post After processing of the session, sttpe_result_cb() is called.
+*
+* @see sttpe_session_start()
+*/
+typedef int (* sttpe_session_stop)(void* session);
+
+/**
+* @brief Cancels recognition of the session.
+*
+* @param[in] session The session handle
+*
+* @return 0 on success, otherwise a negative error value
+* @retval #STTP_ERROR_NONE Successful
+* @retval #STTP_ERROR_INVALID_STATE Invalid state
+*
+* @see sttpe_session_start()
+*/
+typedef int (* sttpe_session_cancel)(void* session);
+
 
 /**
 * @brief A structure of the engine functions.
@@ -557,6 +661,16 @@ typedef struct {
 	/* Engine setting */
 	sttpe_foreach_engine_settings	foreach_engine_settings;/**< Foreach engine specific info */
 	sttpe_set_engine_setting	set_engine_setting;	/**< Set engine specific info */
+
+	/* Optional functions : NOT included in size of old engines */
+	sttpe_shrink_memory		shrink_memory;		/**< Release idle caches (optional) */
+
+	/* Optional functions : concurrent recognition sessions */
+	sttpe_get_max_sessions		get_max_sessions;	/**< Get count of concurrent sessions (optional) */
+	sttpe_session_start		session_start;		/**< Start recognition of session (optional) */
+	sttpe_session_set_recording	session_set_recording;	/**< Set recording data of session (optional) */
+	sttpe_session_stop		session_stop;		/**< Stop recording of session (optional) */
+	sttpe_session_cancel		session_cancel;		/**< Cancel session (optional) */
 } sttpe_funcs_s;
 
 /**